@@ -48,7 +48,7 @@
 
 #include "Adi.hpp"
 
-#include <QGraphicsSvgItem>
+#include "SvgItem.hpp"
 
 #include <cmath>
 
@@ -56,101 +56,171 @@ namespace qfi {
 
 Adi::Adi(QWidget* parent) : QGraphicsView (parent)
 {
-    m_scene = new QGraphicsScene( this );
-    setScene( m_scene );
-    m_scene->clear();
-    init();
+    m_renderer = new Renderer();
+    setScene( m_renderer->scene() );
+    Profile::apply( this, m_renderer->profile() );
+    m_renderer->resize( width(), height() );
+    centerOn( width() / 2.0f , height() / 2.0f );
 }
 
 Adi::~Adi()
 {
-    if (m_scene) {
-        m_scene->clear();
-        delete m_scene;
-        m_scene = nullptr;
+    if ( m_renderer ) {
+        delete m_renderer;
+        m_renderer = nullptr;
     }
-
-    reset();
 }
 
 void Adi::reinit()
 {
-    if (m_scene) {
-        m_scene->clear();
-        init();
-    }
+    m_renderer->reinit();
+    centerOn( width() / 2.0f , height() / 2.0f );
 }
 
 void Adi::update()
 {
-    updateView();
+    m_renderer->update();
+}
+
+void Adi::setRasterCache(const bool rasterCache)
+{
+    m_renderer->setRasterCache( rasterCache );
+}
+
+void Adi::setProfile(const Profile::Type profile)
+{
+    m_renderer->setProfile( profile );
+    Profile::apply( this, profile );
+}
+
+void Adi::resizeEvent(QResizeEvent* event)
+{
+    QGraphicsView::resizeEvent( event );
+    m_renderer->resize( width(), height() );
+    centerOn( width() / 2.0f , height() / 2.0f );
+}
+
+void Adi::paintEvent(QPaintEvent* event)
+{
+    Timings::Scope scope( &m_renderer->timings(), Timings::Paint );
+    QGraphicsView::paintEvent( event );
+}
+
+Adi::Renderer::Renderer()
+{
+    m_width  = m_originalWidth;
+    m_height = m_originalHeight;
+
+    reinit();
+}
+
+Adi::Renderer::~Renderer()
+{
+    if ( m_scene ) m_scene->clear();
 
-    m_faceDeltaX_old  = m_faceDeltaX_new;
-    m_faceDeltaY_old  = m_faceDeltaY_new;
+    reset();
 }
 
-void Adi::setRoll(const float roll)
+void Adi::Renderer::setRoll(const float roll)
 {
+    Timings::Scope scope( &m_timings, Timings::Update );
+
+    const float roll_prev = m_roll;
+
     m_roll = roll;
 
     if ( m_roll < -180.0f ) m_roll = -180.0f;
     if ( m_roll >  180.0f ) m_roll =  180.0f;
+
+    if ( m_roll != roll_prev ) m_dirty |= DirtyRoll;
 }
 
-void Adi::setPitch(const float pitch)
+void Adi::Renderer::setPitch(const float pitch)
 {
+    Timings::Scope scope( &m_timings, Timings::Update );
+
+    const float pitch_prev = m_pitch;
+
     m_pitch = pitch;
 
     if ( m_pitch < -25.0f ) m_pitch = -25.0f;
     if ( m_pitch >  25.0f ) m_pitch =  25.0f;
+
+    if ( m_pitch != pitch_prev ) m_dirty |= DirtyPitch;
 }
 
-void Adi::resizeEvent(QResizeEvent* event)
+void Adi::Renderer::setState(const AdiState& state)
 {
-    QGraphicsView::resizeEvent( event );
-    reinit();
+    Timings::Scope scope( &m_timings, Timings::Update );
+
+    setRoll( state.roll );
+    setPitch( state.pitch );
+}
+
+void Adi::Renderer::publish(const AdiState& state)
+{
+    m_published.publish( state );
 }
 
-void Adi::init()
+void Adi::Renderer::init()
 {
-    m_scaleX = static_cast<float>(width())  / static_cast<float>(m_originalWidth);
-    m_scaleY = static_cast<float>(height()) / static_cast<float>(m_originalHeight);
+    m_scaleX = static_cast<float>(m_width)  / static_cast<float>(m_originalWidth);
+    m_scaleY = static_cast<float>(m_height) / static_cast<float>(m_originalHeight);
 
     reset();
 
-    m_itemBack = new QGraphicsSvgItem( ":/qfi/images/adi/adi_back.svg" );
+    m_itemBack = new SvgItem( ":/qfi/images/adi/adi_back.svg" );
     m_itemBack->setCacheMode( QGraphicsItem::NoCache );
     m_itemBack->setZValue( m_backZ );
     m_itemBack->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
     m_itemBack->setTransformOriginPoint( m_originalAdiCtr );
     m_scene->addItem( m_itemBack );
 
-    m_itemFace = new QGraphicsSvgItem( ":/qfi/images/adi/adi_face.svg" );
+    m_itemFace = new SvgItem( ":/qfi/images/adi/adi_face.svg" );
     m_itemFace->setCacheMode( QGraphicsItem::NoCache );
     m_itemFace->setZValue( m_faceZ );
     m_itemFace->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
     m_itemFace->setTransformOriginPoint( m_originalAdiCtr );
     m_scene->addItem( m_itemFace );
 
-    m_itemRing = new QGraphicsSvgItem( ":/qfi/images/adi/adi_ring.svg" );
+    m_itemRing = new SvgItem( ":/qfi/images/adi/adi_ring.svg" );
     m_itemRing->setCacheMode( QGraphicsItem::NoCache );
     m_itemRing->setZValue( m_ringZ );
     m_itemRing->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
     m_itemRing->setTransformOriginPoint( m_originalAdiCtr );
     m_scene->addItem( m_itemRing );
 
-    m_itemCase = new QGraphicsSvgItem( ":/qfi/images/adi/adi_case.svg" );
+    m_itemCase = new SvgItem( ":/qfi/images/adi/adi_case.svg" );
     m_itemCase->setCacheMode( QGraphicsItem::NoCache );
     m_itemCase->setZValue( m_caseZ );
     m_itemCase->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
     m_scene->addItem( m_itemCase );
 
-    centerOn( width() / 2.0f , height() / 2.0f );
+    m_compositor.setPolicy( m_itemCase, Compositor::Static );
+
+    SvgItem::setRasterCache( m_scene, m_rasterCache );
+
+    invalidate();
+    refresh();
+}
+
+void Adi::Renderer::rescale()
+{
+    m_scaleX = static_cast<float>(m_width)  / static_cast<float>(m_originalWidth);
+    m_scaleY = static_cast<float>(m_height) / static_cast<float>(m_originalHeight);
+
+    const QTransform scale = QTransform::fromScale( m_scaleX, m_scaleY );
 
-    updateView();
+    m_itemBack->setTransform( scale );
+    m_itemFace->setTransform( scale );
+    m_itemRing->setTransform( scale );
+    m_itemCase->setTransform( scale );
+
+    invalidate();
+    refresh();
 }
 
-void Adi::reset()
+void Adi::Renderer::reset()
 {
     m_itemBack = nullptr;
     m_itemFace = nullptr;
@@ -159,31 +229,31 @@ void Adi::reset()
 
     m_roll  = 0.0f;
     m_pitch = 0.0f;
+}
+
+void Adi::Renderer::fetchPublished()
+{
+    AdiState state;
 
-    m_faceDeltaX_new = 0.0f;
-    m_faceDeltaX_old = 0.0f;
-    m_faceDeltaY_new = 0.0f;
-    m_faceDeltaY_old = 0.0f;
+    if ( m_published.fetch( &state ) ) setState( state );
 }
 
-void Adi::updateView()
+void Adi::Renderer::updateView()
 {
-    m_scaleX = static_cast<float>(width())  / static_cast<float>(m_originalWidth);
-    m_scaleY = static_cast<float>(height()) / static_cast<float>(m_originalHeight);
+    m_scaleX = static_cast<float>(m_width)  / static_cast<float>(m_originalWidth);
+    m_scaleY = static_cast<float>(m_height) / static_cast<float>(m_originalHeight);
 
-    m_itemBack->setRotation(-m_roll);
-    m_itemFace->setRotation(-m_roll);
-    m_itemRing->setRotation(-m_roll);
+    if ( m_dirty & DirtyRoll ) {
+        m_itemBack->setRotation(-m_roll);
+        m_itemFace->setRotation(-m_roll);
+        m_itemRing->setRotation(-m_roll);
+    }
 
     const float roll_rad{static_cast<float>(M_PI * m_roll / 180.0)};
     const float delta{static_cast<float>(m_originalPixPerDeg * m_pitch)};
 
-    m_faceDeltaX_new = m_scaleX * delta * std::sin( roll_rad );
-    m_faceDeltaY_new = m_scaleY * delta * std::cos( roll_rad );
-
-    m_itemFace->moveBy( m_faceDeltaX_new - m_faceDeltaX_old, m_faceDeltaY_new - m_faceDeltaY_old );
-
-    m_scene->update();
+    m_itemFace->setPos( m_scaleX * delta * std::sin( roll_rad ),
+                        m_scaleY * delta * std::cos( roll_rad ) );
 }
 
 }
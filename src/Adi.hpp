@@ -50,6 +50,9 @@
 
 #include <QGraphicsView>
 
+#include "Instrument.hpp"
+#include "TripleBuffer.hpp"
+
 class QWidget;
 class QResizeEvent;
 class QGraphicsScene;
@@ -57,6 +60,16 @@ class QGraphicsSvgItem;
 
 namespace qfi {
 
+//---------------------------------------------------
+// Struct: AdiState
+// Description: Attitude Director Indicator state snapshot
+//---------------------------------------------------
+struct AdiState
+{
+    float roll{};                       ///< [deg]
+    float pitch{};                      ///< [deg]
+};
+
 //---------------------------------------------------
 // Class: Adi
 // Description: Attitude Director Indicator
@@ -66,6 +79,70 @@ class Adi : public QGraphicsView
     Q_OBJECT
 
 public:
+
+    //---------------------------------------------------
+    // Class: Adi::Renderer
+    // Description: Attitude Director Indicator headless renderer
+    //---------------------------------------------------
+    class Renderer : public Instrument
+    {
+    public:
+        Renderer();
+        virtual ~Renderer();
+
+        void setRoll(const float);
+        void setPitch(const float);
+
+        // sets all the values at once
+        void setState(const AdiState& state);
+
+        //
+        // publishes state to be applied by the next update(), can be called
+        // from any single producer thread, never blocks nor allocates
+        //
+        void publish(const AdiState& state);
+
+    protected:
+        void init();
+        void rescale();
+        void updateView();
+        void fetchPublished();
+
+    private:
+        enum
+        {
+            DirtyRoll  = 0x0001,
+            DirtyPitch = 0x0002
+        };
+
+        void reset();
+
+        QGraphicsSvgItem* m_itemBack{};
+        QGraphicsSvgItem* m_itemFace{};
+        QGraphicsSvgItem* m_itemRing{};
+        QGraphicsSvgItem* m_itemCase{};
+
+        float m_roll{};
+        float m_pitch{};
+
+        TripleBuffer<AdiState> m_published;
+
+        float m_scaleX{1.0f};
+        float m_scaleY{1.0f};
+
+        const int m_originalHeight{240};
+        const int m_originalWidth{240};
+
+        const float m_originalPixPerDeg{1.7f};
+
+        QPointF m_originalAdiCtr{120.0f, 120.0f};
+
+        const int m_backZ{-30};
+        const int m_faceZ{-20};
+        const int m_ringZ{-10};
+        const int m_caseZ{10};
+    };
+
     Adi(QWidget* parent = nullptr);
     virtual ~Adi();
 
@@ -75,46 +152,46 @@ public:
     // refreshes (redraws) widget
     void update();
 
-    void setRoll(const float);
-    void setPitch(const float);
+    // enables/disables cached raster mode of the SVG layers
+    void setRasterCache(const bool);
 
-protected:
-    void resizeEvent(QResizeEvent*);
+    // sets performance profile of the widget and its renderer
+    void setProfile(const Profile::Type profile);
 
-private:
-    void init();
-    void reset();
-    void updateView();
-
-    QGraphicsScene* m_scene{};
-
-    QGraphicsSvgItem* m_itemBack{};
-    QGraphicsSvgItem* m_itemFace{};
-    QGraphicsSvgItem* m_itemRing{};
-    QGraphicsSvgItem* m_itemCase{};
-
-    float m_roll{};
-    float m_pitch{};
+    // headless renderer of the widget, e.g. to be registered in RenderScheduler
+    inline Renderer* renderer() const { return m_renderer; }
 
-    float m_faceDeltaX_new{};
-    float m_faceDeltaX_old{};
-    float m_faceDeltaY_new{};
-    float m_faceDeltaY_old{};
+    // sets all the values at once
+    inline void setState(const AdiState& state)
+    {
+        m_renderer->setState( state );
+    }
 
-    float m_scaleX{1.0f};
-    float m_scaleY{1.0f};
+    //
+    // publishes state to be applied by the next update(), can be called
+    // from any single producer thread, never blocks nor allocates
+    //
+    inline void publish(const AdiState& state)
+    {
+        m_renderer->publish( state );
+    }
 
-    const int m_originalHeight{240};
-    const int m_originalWidth{240};
+    inline void setRoll(const float roll)
+    {
+        m_renderer->setRoll( roll );
+    }
 
-    const float m_originalPixPerDeg{1.7f};
+    inline void setPitch(const float pitch)
+    {
+        m_renderer->setPitch( pitch );
+    }
 
-    QPointF m_originalAdiCtr{120.0f, 120.0f};
+protected:
+    void paintEvent(QPaintEvent*);
+    void resizeEvent(QResizeEvent*);
 
-    const int m_backZ{-30};
-    const int m_faceZ{-20};
-    const int m_ringZ{-10};
-    const int m_caseZ{10};
+private:
+    Renderer* m_renderer{};
 };
 
 }
@@ -48,7 +48,7 @@
 
 #include "Alt.hpp"
 
-#include <QGraphicsSvgItem>
+#include "SvgItem.hpp"
 
 #include <cmath>
 
@@ -56,109 +56,185 @@ namespace qfi {
 
 Alt::Alt(QWidget* parent) : QGraphicsView(parent)
 {
-    m_scene = new QGraphicsScene( this );
-    setScene( m_scene );
-    m_scene->clear();
-    init();
+    m_renderer = new Renderer();
+    setScene( m_renderer->scene() );
+    Profile::apply( this, m_renderer->profile() );
+    m_renderer->resize( width(), height() );
+    centerOn( width() / 2.0f , height() / 2.0f );
 }
 
 Alt::~Alt()
 {
-    if (m_scene) {
-        m_scene->clear();
-        delete m_scene;
-        m_scene = nullptr;
+    if ( m_renderer ) {
+        delete m_renderer;
+        m_renderer = nullptr;
     }
-
-    reset();
 }
 
 void Alt::reinit()
 {
-    if (m_scene) {
-        m_scene->clear();
-
-        init();
-    }
+    m_renderer->reinit();
+    centerOn( width() / 2.0f , height() / 2.0f );
 }
 
 void Alt::update()
 {
-    updateView();
+    m_renderer->update();
+}
+
+void Alt::setRasterCache(const bool rasterCache)
+{
+    m_renderer->setRasterCache( rasterCache );
+}
+
+void Alt::setProfile(const Profile::Type profile)
+{
+    m_renderer->setProfile( profile );
+    Profile::apply( this, profile );
+}
+
+void Alt::resizeEvent(QResizeEvent* event)
+{
+    QGraphicsView::resizeEvent( event );
+    m_renderer->resize( width(), height() );
+    centerOn( width() / 2.0f , height() / 2.0f );
+}
+
+void Alt::paintEvent(QPaintEvent* event)
+{
+    Timings::Scope scope( &m_renderer->timings(), Timings::Paint );
+    QGraphicsView::paintEvent( event );
+}
+
+Alt::Renderer::Renderer()
+{
+    m_width  = m_originalWidth;
+    m_height = m_originalHeight;
+
+    reinit();
+}
+
+Alt::Renderer::~Renderer()
+{
+    if ( m_scene ) m_scene->clear();
+
+    reset();
 }
 
-void Alt::setAltitude(const float altitude)
+void Alt::Renderer::setAltitude(const float altitude)
 {
-    m_altitude = altitude;
+    Timings::Scope scope( &m_timings, Timings::Update );
+
+    if ( altitude != m_altitude ) {
+        m_altitude = altitude;
+        m_dirty |= DirtyAltitude;
+    }
 }
 
-void Alt::setPressure(const float pressure)
+void Alt::Renderer::setPressure(const float pressure)
 {
+    Timings::Scope scope( &m_timings, Timings::Update );
+
+    const float pressure_prev = m_pressure;
+
     m_pressure = pressure;
 
     if ( m_pressure < 28.0f ) m_pressure = 28.0f;
     if ( m_pressure > 31.5f ) m_pressure = 31.5f;
+
+    if ( m_pressure != pressure_prev ) m_dirty |= DirtyPressure;
 }
 
-void Alt::resizeEvent( QResizeEvent *event )
+void Alt::Renderer::setState(const AltState& state)
 {
-    QGraphicsView::resizeEvent( event );
-    reinit();
+    Timings::Scope scope( &m_timings, Timings::Update );
+
+    setAltitude( state.altitude );
+    setPressure( state.pressure );
 }
 
-void Alt::init()
+void Alt::Renderer::publish(const AltState& state)
 {
-    m_scaleX = static_cast<float>(width())  / static_cast<float>(m_originalWidth);
-    m_scaleY = static_cast<float>(height()) / static_cast<float>(m_originalHeight);
+    m_published.publish( state );
+}
+
+void Alt::Renderer::init()
+{
+    m_scaleX = static_cast<float>(m_width)  / static_cast<float>(m_originalWidth);
+    m_scaleY = static_cast<float>(m_height) / static_cast<float>(m_originalHeight);
 
     reset();
 
-    m_itemFace_1 = new QGraphicsSvgItem( ":/qfi/images/alt/alt_face_1.svg" );
+    m_itemFace_1 = new SvgItem( ":/qfi/images/alt/alt_face_1.svg" );
     m_itemFace_1->setCacheMode( QGraphicsItem::NoCache );
     m_itemFace_1->setZValue( m_face1Z );
     m_itemFace_1->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
     m_itemFace_1->setTransformOriginPoint( m_originalAltCtr );
     m_scene->addItem( m_itemFace_1 );
 
-    m_itemFace_2 = new QGraphicsSvgItem( ":/qfi/images/alt/alt_face_2.svg" );
+    m_itemFace_2 = new SvgItem( ":/qfi/images/alt/alt_face_2.svg" );
     m_itemFace_2->setCacheMode( QGraphicsItem::NoCache );
     m_itemFace_2->setZValue( m_face2Z );
     m_itemFace_2->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
     m_scene->addItem( m_itemFace_2 );
 
-    m_itemFace_3 = new QGraphicsSvgItem( ":/qfi/images/alt/alt_face_3.svg" );
+    m_itemFace_3 = new SvgItem( ":/qfi/images/alt/alt_face_3.svg" );
     m_itemFace_3->setCacheMode( QGraphicsItem::NoCache );
     m_itemFace_3->setZValue( m_face3Z );
     m_itemFace_3->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
     m_itemFace_3->setTransformOriginPoint( m_originalAltCtr );
     m_scene->addItem( m_itemFace_3 );
 
-    m_itemHand_1 = new QGraphicsSvgItem( ":/qfi/images/alt/alt_hand_1.svg" );
+    m_itemHand_1 = new SvgItem( ":/qfi/images/alt/alt_hand_1.svg" );
     m_itemHand_1->setCacheMode( QGraphicsItem::NoCache );
     m_itemHand_1->setZValue( m_hand1Z );
     m_itemHand_1->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
     m_itemHand_1->setTransformOriginPoint( m_originalAltCtr );
     m_scene->addItem( m_itemHand_1 );
 
-    m_itemHand_2 = new QGraphicsSvgItem( ":/qfi/images/alt/alt_hand_2.svg" );
+    m_itemHand_2 = new SvgItem( ":/qfi/images/alt/alt_hand_2.svg" );
     m_itemHand_2->setCacheMode( QGraphicsItem::NoCache );
     m_itemHand_2->setZValue( m_hand2Z );
     m_itemHand_2->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
     m_itemHand_2->setTransformOriginPoint( m_originalAltCtr );
     m_scene->addItem( m_itemHand_2 );
 
-    m_itemCase = new QGraphicsSvgItem( ":/qfi/images/alt/alt_case.svg" );
+    m_itemCase = new SvgItem( ":/qfi/images/alt/alt_case.svg" );
     m_itemCase->setCacheMode( QGraphicsItem::NoCache );
     m_itemCase->setZValue( m_caseZ );
     m_itemCase->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
     m_scene->addItem( m_itemCase );
 
-    centerOn( width() / 2.0f , height() / 2.0f );
+    // pressure face is rotated only when the pressure is set
+    m_compositor.setPolicy( m_itemFace_1, Compositor::Rarely );
+    m_compositor.setPolicy( m_itemFace_2, Compositor::Static );
+    m_compositor.setPolicy( m_itemCase,   Compositor::Static );
 
-    updateView();
+    SvgItem::setRasterCache( m_scene, m_rasterCache );
+
+    invalidate();
+    refresh();
+}
+
+void Alt::Renderer::rescale()
+{
+    m_scaleX = static_cast<float>(m_width)  / static_cast<float>(m_originalWidth);
+    m_scaleY = static_cast<float>(m_height) / static_cast<float>(m_originalHeight);
+
+    const QTransform scale = QTransform::fromScale( m_scaleX, m_scaleY );
+
+    m_itemFace_1->setTransform( scale );
+    m_itemFace_2->setTransform( scale );
+    m_itemFace_3->setTransform( scale );
+    m_itemHand_1->setTransform( scale );
+    m_itemHand_2->setTransform( scale );
+    m_itemCase->setTransform( scale );
+
+    invalidate();
+    refresh();
 }
 
-void Alt::reset()
+void Alt::Renderer::reset()
 {
     m_itemFace_1 = nullptr;
     m_itemFace_2 = nullptr;
@@ -171,21 +247,32 @@ void Alt::reset()
     m_pressure = 28.0f;
 }
 
-void Alt::updateView()
+void Alt::Renderer::fetchPublished()
 {
-    int altitude = std::ceil( m_altitude + 0.5 );
+    AltState state;
 
-    float angleH1 = m_altitude * 0.036f;
-    float angleH2 = ( altitude % 1000 ) * 0.36f;
-    float angleF1 = ( m_pressure - 28.0f ) * 100.0f;
-    float angleF3 = m_altitude * 0.0036f;
+    if ( m_published.fetch( &state ) ) setState( state );
+}
+
+void Alt::Renderer::updateView()
+{
+    if ( m_dirty & DirtyAltitude ) {
+        int altitude = std::ceil( m_altitude + 0.5 );
 
-    m_itemHand_1->setRotation(   angleH1 );
-    m_itemHand_2->setRotation(   angleH2 );
-    m_itemFace_1->setRotation( - angleF1 );
-    m_itemFace_3->setRotation(   angleF3 );
+        float angleH1 = m_altitude * 0.036f;
+        float angleH2 = ( altitude % 1000 ) * 0.36f;
+        float angleF3 = m_altitude * 0.0036f;
 
-    m_scene->update();
+        m_itemHand_1->setRotation(   angleH1 );
+        m_itemHand_2->setRotation(   angleH2 );
+        m_itemFace_3->setRotation(   angleF3 );
+    }
+
+    if ( m_dirty & DirtyPressure ) {
+        float angleF1 = ( m_pressure - 28.0f ) * 100.0f;
+
+        m_itemFace_1->setRotation( - angleF1 );
+    }
 }
 
 }
@@ -50,6 +50,9 @@
 
 #include <QGraphicsView>
 
+#include "Instrument.hpp"
+#include "TripleBuffer.hpp"
+
 class QWidget;
 class QResizeEvent;
 class QGraphicsScene;
@@ -57,6 +60,16 @@ class QGraphicsSvgItem;
 
 namespace qfi {
 
+//---------------------------------------------------
+// Struct: AltState
+// Description: Barometric Altimeter state snapshot
+//---------------------------------------------------
+struct AltState
+{
+    float altitude{};                   ///< [ft]
+    float pressure{28.0f};              ///< [inHg]
+};
+
 //---------------------------------------------------
 // Class: Alt
 // Description: Barometric Altimeter
@@ -66,6 +79,72 @@ class Alt : public QGraphicsView
     Q_OBJECT
 
 public:
+
+    //---------------------------------------------------
+    // Class: Alt::Renderer
+    // Description: Barometric Altimeter headless renderer
+    //---------------------------------------------------
+    class Renderer : public Instrument
+    {
+    public:
+        Renderer();
+        virtual ~Renderer();
+
+        void setAltitude(const float);
+        void setPressure(const float);
+
+        // sets all the values at once
+        void setState(const AltState& state);
+
+        //
+        // publishes state to be applied by the next update(), can be called
+        // from any single producer thread, never blocks nor allocates
+        //
+        void publish(const AltState& state);
+
+    protected:
+        void init();
+        void rescale();
+        void updateView();
+        void fetchPublished();
+
+    private:
+        enum
+        {
+            DirtyAltitude = 0x0001,
+            DirtyPressure = 0x0002
+        };
+
+        void reset();
+
+        QGraphicsSvgItem* m_itemFace_1{};
+        QGraphicsSvgItem* m_itemFace_2{};
+        QGraphicsSvgItem* m_itemFace_3{};
+        QGraphicsSvgItem* m_itemHand_1{};
+        QGraphicsSvgItem* m_itemHand_2{};
+        QGraphicsSvgItem* m_itemCase{};
+
+        float m_altitude{};
+        float m_pressure{28.0f};
+
+        TripleBuffer<AltState> m_published;
+
+        float m_scaleX{1.0f};
+        float m_scaleY{1.0f};
+
+        const int m_originalHeight{240};
+        const int m_originalWidth{240};
+
+        QPointF m_originalAltCtr{120.0f, 120.0f};
+
+        const int m_face1Z{-50};
+        const int m_face2Z{-40};
+        const int m_face3Z{-30};
+        const int m_hand1Z{-20};
+        const int m_hand2Z{-10};
+        const int m_caseZ{10};
+    };
+
     Alt(QWidget* parent = nullptr);
     virtual ~Alt();
 
@@ -75,43 +154,46 @@ public:
     // refreshes (redraws) widget
     void update();
 
-    void setAltitude(const float);
-    void setPressure(const float);
+    // enables/disables cached raster mode of the SVG layers
+    void setRasterCache(const bool);
 
-protected:
-    void resizeEvent(QResizeEvent*);
-
-private:
-    void init();
-    void reset();
-    void updateView();
+    // sets performance profile of the widget and its renderer
+    void setProfile(const Profile::Type profile);
 
-    QGraphicsScene* m_scene{};
+    // headless renderer of the widget, e.g. to be registered in RenderScheduler
+    inline Renderer* renderer() const { return m_renderer; }
 
-    QGraphicsSvgItem* m_itemFace_1{};
-    QGraphicsSvgItem* m_itemFace_2{};
-    QGraphicsSvgItem* m_itemFace_3{};
-    QGraphicsSvgItem* m_itemHand_1{};
-    QGraphicsSvgItem* m_itemHand_2{};
-    QGraphicsSvgItem* m_itemCase{};
+    // sets all the values at once
+    inline void setState(const AltState& state)
+    {
+        m_renderer->setState( state );
+    }
 
-    float m_altitude{};
-    float m_pressure{28.0f};
+    //
+    // publishes state to be applied by the next update(), can be called
+    // from any single producer thread, never blocks nor allocates
+    //
+    inline void publish(const AltState& state)
+    {
+        m_renderer->publish( state );
+    }
 
-    float m_scaleX{1.0f};
-    float m_scaleY{1.0f};
+    inline void setAltitude(const float altitude)
+    {
+        m_renderer->setAltitude( altitude );
+    }
 
-    const int m_originalHeight{240};
-    const int m_originalWidth{240};
+    inline void setPressure(const float pressure)
+    {
+        m_renderer->setPressure( pressure );
+    }
 
-    QPointF m_originalAltCtr{120.0f, 120.0f};
+protected:
+    void paintEvent(QPaintEvent*);
+    void resizeEvent(QResizeEvent*);
 
-    const int m_face1Z{-50};
-    const int m_face2Z{-40};
-    const int m_face3Z{-30};
-    const int m_hand1Z{-20};
-    const int m_hand2Z{-10};
-    const int m_caseZ{10};
+private:
+    Renderer* m_renderer{};
 };
 
 }
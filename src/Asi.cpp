@@ -48,87 +48,154 @@
 
 #include "Asi.hpp"
 
-#include <QGraphicsSvgItem>
+#include "SvgItem.hpp"
 
 namespace qfi {
 
 Asi::Asi(QWidget* parent) : QGraphicsView(parent)
 {
-    m_scene = new QGraphicsScene( this );
-    setScene( m_scene );
-    m_scene->clear();
-    init();
+    m_renderer = new Renderer();
+    setScene( m_renderer->scene() );
+    Profile::apply( this, m_renderer->profile() );
+    m_renderer->resize( width(), height() );
+    centerOn( width() / 2.0f , height() / 2.0f );
 }
 
 Asi::~Asi()
 {
-    if (m_scene) {
-        m_scene->clear();
-        delete m_scene;
-        m_scene = nullptr;
+    if ( m_renderer ) {
+        delete m_renderer;
+        m_renderer = nullptr;
     }
-    reset();
 }
 
 void Asi::reinit()
 {
-    if (m_scene) {
-        m_scene->clear();
-        init();
-    }
+    m_renderer->reinit();
+    centerOn( width() / 2.0f , height() / 2.0f );
 }
 
 void Asi::update()
 {
-    updateView();
+    m_renderer->update();
 }
 
-void Asi::setAirspeed(const float airspeed)
+void Asi::setRasterCache(const bool rasterCache)
 {
-    m_airspeed = airspeed;
+    m_renderer->setRasterCache( rasterCache );
+}
 
-    if ( m_airspeed <   0.0f ) m_airspeed =   0.0f;
-    if ( m_airspeed > 235.0f ) m_airspeed = 235.0f;
+void Asi::setProfile(const Profile::Type profile)
+{
+    m_renderer->setProfile( profile );
+    Profile::apply( this, profile );
 }
 
 void Asi::resizeEvent(QResizeEvent* event)
 {
     QGraphicsView::resizeEvent( event );
+    m_renderer->resize( width(), height() );
+    centerOn( width() / 2.0f , height() / 2.0f );
+}
+
+void Asi::paintEvent(QPaintEvent* event)
+{
+    Timings::Scope scope( &m_renderer->timings(), Timings::Paint );
+    QGraphicsView::paintEvent( event );
+}
+
+Asi::Renderer::Renderer()
+{
+    m_width  = m_originalWidth;
+    m_height = m_originalHeight;
+
     reinit();
 }
 
-void Asi::init()
+Asi::Renderer::~Renderer()
+{
+    if ( m_scene ) m_scene->clear();
+
+    reset();
+}
+
+void Asi::Renderer::setAirspeed(const float airspeed)
+{
+    Timings::Scope scope( &m_timings, Timings::Update );
+
+    const float airspeed_prev = m_airspeed;
+
+    m_airspeed = airspeed;
+
+    if ( m_airspeed <   0.0f ) m_airspeed =   0.0f;
+    if ( m_airspeed > 235.0f ) m_airspeed = 235.0f;
+
+    if ( m_airspeed != airspeed_prev ) invalidate();
+}
+
+void Asi::Renderer::setState(const AsiState& state)
+{
+    Timings::Scope scope( &m_timings, Timings::Update );
+
+    setAirspeed( state.airspeed );
+}
+
+void Asi::Renderer::publish(const AsiState& state)
+{
+    m_published.publish( state );
+}
+
+void Asi::Renderer::init()
 {
-    m_scaleX = static_cast<float>(width())  / static_cast<float>(m_originalWidth);
-    m_scaleY = static_cast<float>(height()) / static_cast<float>(m_originalHeight);
+    m_scaleX = static_cast<float>(m_width)  / static_cast<float>(m_originalWidth);
+    m_scaleY = static_cast<float>(m_height) / static_cast<float>(m_originalHeight);
 
     reset();
 
-    m_itemFace = new QGraphicsSvgItem( ":/qfi/images/asi/asi_face.svg" );
+    m_itemFace = new SvgItem( ":/qfi/images/asi/asi_face.svg" );
     m_itemFace->setCacheMode( QGraphicsItem::NoCache );
     m_itemFace->setZValue( m_faceZ );
     m_itemFace->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
     m_scene->addItem( m_itemFace );
 
-    m_itemHand = new QGraphicsSvgItem( ":/qfi/images/asi/asi_hand.svg" );
+    m_itemHand = new SvgItem( ":/qfi/images/asi/asi_hand.svg" );
     m_itemHand->setCacheMode( QGraphicsItem::NoCache );
     m_itemHand->setZValue( m_handZ );
     m_itemHand->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
     m_itemHand->setTransformOriginPoint( m_originalAsiCtr );
     m_scene->addItem( m_itemHand );
 
-    m_itemCase = new QGraphicsSvgItem( ":/qfi/images/asi/asi_case.svg" );
+    m_itemCase = new SvgItem( ":/qfi/images/asi/asi_case.svg" );
     m_itemCase->setCacheMode( QGraphicsItem::NoCache );
     m_itemCase->setZValue( m_caseZ );
     m_itemCase->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
     m_scene->addItem( m_itemCase );
 
-    centerOn( width() / 2.0f , height() / 2.0f );
+    m_compositor.setPolicy( m_itemFace, Compositor::Static );
+    m_compositor.setPolicy( m_itemCase, Compositor::Static );
+
+    SvgItem::setRasterCache( m_scene, m_rasterCache );
 
-    updateView();
+    invalidate();
+    refresh();
 }
 
-void Asi::reset()
+void Asi::Renderer::rescale()
+{
+    m_scaleX = static_cast<float>(m_width)  / static_cast<float>(m_originalWidth);
+    m_scaleY = static_cast<float>(m_height) / static_cast<float>(m_originalHeight);
+
+    const QTransform scale = QTransform::fromScale( m_scaleX, m_scaleY );
+
+    m_itemFace->setTransform( scale );
+    m_itemHand->setTransform( scale );
+    m_itemCase->setTransform( scale );
+
+    invalidate();
+    refresh();
+}
+
+void Asi::Renderer::reset()
 {
     m_itemFace = nullptr;
     m_itemHand = nullptr;
@@ -137,7 +204,14 @@ void Asi::reset()
     m_airspeed = 0.0f;
 }
 
-void Asi::updateView()
+void Asi::Renderer::fetchPublished()
+{
+    AsiState state;
+
+    if ( m_published.fetch( &state ) ) setState( state );
+}
+
+void Asi::Renderer::updateView()
 {
     float angle{};
 
@@ -154,8 +228,6 @@ void Asi::updateView()
     }
 
     m_itemHand->setRotation(angle);
-
-    m_scene->update();
 }
 
 }
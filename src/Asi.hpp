@@ -50,6 +50,9 @@
 
 #include <QGraphicsView>
 
+#include "Instrument.hpp"
+#include "TripleBuffer.hpp"
+
 class QWidget;
 class QResizeEvent;
 class QGraphicsScene;
@@ -57,6 +60,15 @@ class QGraphicsSvgItem;
 
 namespace qfi {
 
+//---------------------------------------------------
+// Struct: AsiState
+// Description: Airspeed Indicator state snapshot
+//---------------------------------------------------
+struct AsiState
+{
+    float airspeed{};                   ///< [kts]
+};
+
 //---------------------------------------------------
 // Class: Asi
 // Description: Airspeed Indicator
@@ -66,6 +78,58 @@ class Asi : public QGraphicsView
     Q_OBJECT
 
 public:
+
+    //---------------------------------------------------
+    // Class: Asi::Renderer
+    // Description: Airspeed Indicator headless renderer
+    //---------------------------------------------------
+    class Renderer : public Instrument
+    {
+    public:
+        Renderer();
+        virtual ~Renderer();
+
+        void setAirspeed(const float);
+
+        // sets all the values at once
+        void setState(const AsiState& state);
+
+        //
+        // publishes state to be applied by the next update(), can be called
+        // from any single producer thread, never blocks nor allocates
+        //
+        void publish(const AsiState& state);
+
+    protected:
+        void init();
+        void rescale();
+        void updateView();
+        void fetchPublished();
+
+    private:
+        void reset();
+
+        QGraphicsSvgItem* m_itemFace{};
+        QGraphicsSvgItem* m_itemHand{};
+        QGraphicsSvgItem* m_itemCase{};
+
+        float m_airspeed{};
+
+        TripleBuffer<AsiState> m_published;
+
+        float m_scaleX{1.0f};
+        float m_scaleY{1.0f};
+
+        const int m_originalHeight{240};
+        const int m_originalWidth{240};
+
+        QPointF m_originalAsiCtr{120.0f, 120.0f};
+
+        const int m_faceZ{-20};
+        const int m_handZ{-10};
+        const int m_caseZ{10};
+    };
+
     Asi(QWidget* parent = nullptr);
     virtual ~Asi();
 
@@ -75,35 +139,41 @@ public:
     // refreshes (redraws) widget
     void update();
 
-    void setAirspeed(const float);
-
-protected:
-    void resizeEvent(QResizeEvent*);
-
-private:
-    void init();
-    void reset();
-    void updateView();
+    // enables/disables cached raster mode of the SVG layers
+    void setRasterCache(const bool);
 
-    QGraphicsScene* m_scene{};
+    // sets performance profile of the widget and its renderer
+    void setProfile(const Profile::Type profile);
 
-    QGraphicsSvgItem* m_itemFace{};
-    QGraphicsSvgItem* m_itemHand{};
-    QGraphicsSvgItem* m_itemCase{};
+    // headless renderer of the widget, e.g. to be registered in RenderScheduler
+    inline Renderer* renderer() const { return m_renderer; }
 
-    float m_airspeed{};
+    // sets all the values at once
+    inline void setState(const AsiState& state)
+    {
+        m_renderer->setState( state );
+    }
 
-    float m_scaleX{1.0f};
-    float m_scaleY{1.0f};
+    //
+    // publishes state to be applied by the next update(), can be called
+    // from any single producer thread, never blocks nor allocates
+    //
+    inline void publish(const AsiState& state)
+    {
+        m_renderer->publish( state );
+    }
 
-    const int m_originalHeight{240};
-    const int m_originalWidth{240};
+    inline void setAirspeed(const float airspeed)
+    {
+        m_renderer->setAirspeed( airspeed );
+    }
 
-    QPointF m_originalAsiCtr{120.0f, 120.0f};
+protected:
+    void paintEvent(QPaintEvent*);
+    void resizeEvent(QResizeEvent*);
 
-    const int m_faceZ{-20};
-    const int m_handZ{-10};
-    const int m_caseZ{10};
+private:
+    Renderer* m_renderer{};
 };
 
 }
@@ -0,0 +1,348 @@
+/***************************************************************************//**
+ * @file Compositor.cpp
+ * @author  Marek M. Cel <marekcel@marekcel.pl>
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * This file is part of QFlightInstruments. You can redistribute and modify it
+ * under the terms of GNU General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.
+ * 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ *
+ * Further information about the GNU General Public License can also be found
+ * on the world wide web at http://www.gnu.org.
+ *
+ * ---
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include "Compositor.hpp"
+
+#include <QGraphicsItem>
+#include <QGraphicsScene>
+#include <QImage>
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
+
+#include "SvgItem.hpp"
+
+namespace qfi {
+
+//---------------------------------------------------
+// Class: Compositor::Composite
+// Description: Scene item drawing a group of cached layers from a raster
+// rendered at the device scale
+//---------------------------------------------------
+class Compositor::Composite : public QGraphicsItem
+{
+public:
+
+    enum { Type = UserType + 5 };
+
+    explicit Composite(int* renders) :
+        m_renders(renders)
+    {}
+
+    inline void addLayer(QGraphicsItem* layer)
+    {
+        m_layers.push_back( layer );
+    }
+
+    inline const QVector<QGraphicsItem*>& layers() const { return m_layers; }
+
+    void invalidate()
+    {
+        QRectF bounds;
+
+        for ( QGraphicsItem* layer : m_layers ) bounds = bounds.united( layer->sceneBoundingRect() );
+
+        // whole scene units, so that the raster is aligned to the pixels
+        bounds = QRectF( bounds.toAlignedRect() );
+
+        if ( bounds != m_bounds ) {
+            prepareGeometryChange();
+            m_bounds = bounds;
+        }
+
+        m_valid = false;
+        update();
+    }
+
+    QRectF boundingRect() const
+    {
+        return m_bounds;
+    }
+
+    int type() const
+    {
+        return Type;
+    }
+
+    void paint(QPainter* painter, const QStyleOptionGraphicsItem*, QWidget*)
+    {
+        // composite is rendered at the device scale
+        const QSizeF scale = SvgItem::deviceScale( painter );
+        const qreal sx = scale.width();
+        const qreal sy = scale.height();
+
+        if ( !m_valid || sx != m_scaleX || sy != m_scaleY ) render( sx, sy );
+
+        if ( m_raster.isNull() ) return;
+
+        const bool smooth = painter->testRenderHint( QPainter::SmoothPixmapTransform );
+
+        painter->setRenderHint( QPainter::SmoothPixmapTransform, true );
+        painter->drawImage( m_bounds, m_raster );
+        painter->setRenderHint( QPainter::SmoothPixmapTransform, smooth );
+    }
+
+private:
+
+    void render(const qreal sx, const qreal sy)
+    {
+        m_scaleX = sx;
+        m_scaleY = sy;
+        m_valid  = true;
+
+        const QSize size( qRound( m_bounds.width() * sx ), qRound( m_bounds.height() * sy ) );
+
+        if ( size.isEmpty() ) {
+            m_raster = QImage();
+            return;
+        }
+
+        if ( m_raster.size() != size ) m_raster = QImage( size, QImage::Format_ARGB32_Premultiplied );
+
+        m_raster.fill( Qt::transparent );
+
+        QPainter painter( &m_raster );
+        painter.setRenderHints( QPainter::Antialiasing | QPainter::TextAntialiasing
+                              | QPainter::SmoothPixmapTransform );
+
+        const QTransform base = QTransform::fromTranslate( -m_bounds.left(), -m_bounds.top() )
+                              * QTransform::fromScale( sx, sy );
+
+        QStyleOptionGraphicsItem option;
+
+        for ( QGraphicsItem* layer : m_layers ) {
+            if ( !layer->isVisible() ) continue;
+
+            option.exposedRect = layer->boundingRect();
+
+            painter.setWorldTransform( layer->sceneTransform() * base );
+            painter.setOpacity( layer->opacity() );
+            layer->paint( &painter, &option, nullptr );
+        }
+
+        ( *m_renders )++;
+    }
+
+    QVector<QGraphicsItem*> m_layers;   ///< layers in Z order
+
+    QImage m_raster;                    ///< premultiplied composite
+
+    QRectF m_bounds;                    ///< [scene units]
+
+    qreal m_scaleX{};
+    qreal m_scaleY{};
+
+    int* m_renders{};
+
+    bool m_valid{};
+};
+
+void Compositor::setPolicy(QGraphicsItem* layer, const Policy policy)
+{
+    if ( !layer ) return;
+
+    bool found = false;
+
+    for ( Layer& l : m_layers ) {
+        if ( l.item == layer ) {
+            if ( l.policy == policy ) return;
+
+            l.policy = policy;
+            found = true;
+        }
+    }
+
+    if ( !found ) {
+        Layer l;
+        l.item   = layer;
+        l.policy = policy;
+
+        m_layers.push_back( l );
+    }
+
+    if ( m_scene ) build( m_scene );
+}
+
+Compositor::Policy Compositor::policy(QGraphicsItem* layer) const
+{
+    for ( const Layer& l : m_layers ) {
+        if ( l.item == layer ) return l.policy;
+    }
+
+    return PerFrame;
+}
+
+void Compositor::build(QGraphicsScene* scene)
+{
+    release();
+
+    m_scene = scene;
+
+    if ( !m_scene ) return;
+
+    Composite* composite = nullptr;
+
+    // per-frame layers following the composites (nullptr for the topmost one)
+    QVector<QGraphicsItem*> above;
+
+    for ( QGraphicsItem* item : m_scene->items( Qt::AscendingOrder ) ) {
+        if ( item->parentItem() ) continue;
+
+        Layer* layer = nullptr;
+
+        for ( Layer& l : m_layers ) {
+            if ( l.item == item && l.policy != PerFrame ) layer = &l;
+        }
+
+        // per-frame layer ends the group below it
+        if ( !layer ) {
+            if ( composite ) above.last() = item;
+            composite = nullptr;
+            continue;
+        }
+
+        if ( !composite ) {
+            composite = new Composite( &m_renders );
+            composite->setZValue( item->zValue() );
+            m_composites.push_back( composite );
+            above.push_back( nullptr );
+        }
+
+        layer->composite   = composite;
+        layer->transform   = item->sceneTransform();
+        layer->opacity     = item->opacity();
+        layer->visible     = item->isVisible();
+        layer->hasContents = !( item->flags() & QGraphicsItem::ItemHasNoContents );
+
+        composite->addLayer( item );
+
+        // scene skips painting the layer, the instrument may still show or hide it
+        item->setFlag( QGraphicsItem::ItemHasNoContents, true );
+    }
+
+    for ( int i = 0; i < m_composites.size(); ++i ) {
+        m_scene->addItem( m_composites[ i ] );
+
+        //
+        // composite added last would be drawn above the items of its Z value
+        // inserted after its first layer, it is stacked back below the layer
+        // which followed the group (stackBefore() only affects equal Z values)
+        //
+        if ( above[ i ] && above[ i ]->zValue() == m_composites[ i ]->zValue() ) {
+            m_composites[ i ]->stackBefore( above[ i ] );
+        }
+
+        m_composites[ i ]->invalidate();
+    }
+}
+
+void Compositor::sync()
+{
+    for ( Layer& layer : m_layers ) {
+        if ( !layer.composite ) continue;
+
+        bool changed = false;
+
+        if ( layer.item->isVisible() != layer.visible || layer.item->opacity() != layer.opacity ) {
+            layer.visible = layer.item->isVisible();
+            layer.opacity = layer.item->opacity();
+            changed = true;
+        }
+
+        if ( layer.policy == Rarely ) {
+            const QTransform transform = layer.item->sceneTransform();
+
+            if ( transform != layer.transform ) {
+                layer.transform = transform;
+                changed = true;
+            }
+        }
+
+        if ( changed ) layer.composite->invalidate();
+    }
+}
+
+void Compositor::invalidate()
+{
+    for ( Layer& layer : m_layers ) {
+        if ( layer.composite ) {
+            layer.transform = layer.item->sceneTransform();
+            layer.opacity   = layer.item->opacity();
+            layer.visible   = layer.item->isVisible();
+        }
+    }
+
+    for ( Composite* composite : m_composites ) composite->invalidate();
+}
+
+void Compositor::clear()
+{
+    m_scene = nullptr;
+
+    m_layers.clear();
+    m_composites.clear();
+}
+
+void Compositor::release()
+{
+    // layers are handed back to the scene
+    for ( Layer& layer : m_layers ) {
+        if ( layer.composite ) {
+            layer.item->setFlag( QGraphicsItem::ItemHasNoContents, !layer.hasContents );
+            layer.composite = nullptr;
+        }
+    }
+
+    for ( Composite* composite : m_composites ) {
+        if ( m_scene ) m_scene->removeItem( composite );
+        delete composite;
+    }
+
+    m_composites.clear();
+}
+
+}
@@ -0,0 +1,144 @@
+/***************************************************************************//**
+ * @file Compositor.h
+ * @author  Marek M. Cel <marekcel@marekcel.pl>
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * This file is part of QFlightInstruments. You can redistribute and modify it
+ * under the terms of GNU General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.
+ * 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ *
+ * Further information about the GNU General Public License can also be found
+ * on the world wide web at http://www.gnu.org.
+ *
+ * ---
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef __qfi_Compositor_H__
+#define __qfi_Compositor_H__
+
+#include <QTransform>
+#include <QVector>
+
+class QGraphicsItem;
+class QGraphicsScene;
+
+namespace qfi {
+
+//---------------------------------------------------
+// Class: Compositor
+// Description: Groups consecutive (in Z order) cached layers of a scene
+// into composite surfaces, each composite is rendered once and blitted
+// until one of its layers changes or the scene is resized
+//---------------------------------------------------
+class Compositor
+{
+public:
+
+    // layer cache policy
+    enum Policy
+    {
+        PerFrame = 0,                   ///< layer is drawn by the scene every time (default)
+        Rarely,                         ///< layer is cached, its composite is re-rendered when the layer transform, visibility or opacity changes
+        Static                          ///< layer is cached, its composite is re-rendered when the layer visibility or opacity changes, on resize or invalidate()
+    };
+
+    Compositor() = default;
+
+    //
+    // sets cache policy of the scene layer (top level item), layers of
+    // the built composites are regrouped
+    //
+    void setPolicy(QGraphicsItem* layer, const Policy policy);
+
+    Policy policy(QGraphicsItem* layer) const;
+
+    //
+    // groups cached layers of the scene into composites, per-frame layers
+    // split the groups, cached layers are drawn by the composites in their
+    // stacking order instead of the scene (ItemHasNoContents flag), their
+    // visibility stays with the instrument
+    //
+    void build(QGraphicsScene* scene);
+
+    //
+    // checks visibility and opacity of the cached layers and transforms of
+    // the rarely changing ones and invalidates composites of the changed
+    // ones, to be called after updating items
+    //
+    void sync();
+
+    // invalidates all the composites, e.g. after resizing layers
+    void invalidate();
+
+    //
+    // forgets layers and composites, to be called before the scene items
+    // are deleted (composites are deleted with the scene items)
+    //
+    void clear();
+
+    // number of composites
+    inline int composites() const { return m_composites.size(); }
+
+    // number of composites renderings
+    inline int renders() const { return m_renders; }
+
+private:
+
+    class Composite;
+
+    struct Layer
+    {
+        QGraphicsItem* item{};
+        Policy policy{PerFrame};
+        QTransform transform;           ///< scene transform at the last sync
+        qreal opacity{};                ///< opacity at the last sync
+        Composite* composite{};
+        bool visible{};                 ///< visibility at the last sync
+        bool hasContents{};             ///< ItemHasNoContents flag was clear before the layer was composited
+    };
+
+    void release();
+
+    QGraphicsScene* m_scene{};
+
+    QVector<Layer> m_layers;
+    QVector<Composite*> m_composites;
+
+    int m_renders{};
+};
+
+}
+
+#endif
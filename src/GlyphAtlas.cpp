@@ -0,0 +1,149 @@
+/***************************************************************************//**
+ * @file GlyphAtlas.cpp
+ * @author  Marek M. Cel <marekcel@marekcel.pl>
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * This file is part of QFlightInstruments. You can redistribute and modify it
+ * under the terms of GNU General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.
+ * 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ *
+ * Further information about the GNU General Public License can also be found
+ * on the world wide web at http://www.gnu.org.
+ *
+ * ---
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include "GlyphAtlas.hpp"
+
+#include <QFontMetricsF>
+#include <QPainter>
+
+#include <cmath>
+#include <cstring>
+
+namespace qfi {
+
+GlyphAtlas::GlyphAtlas()
+{
+    std::memset( m_index, -1, sizeof(m_index) );
+}
+
+void GlyphAtlas::setFont(const QFont& font, const QColor& color, const char* letters)
+{
+    m_font  = font;
+    m_color = color;
+
+    std::memset( m_index, -1, sizeof(m_index) );
+    m_glyphsCount = 0;
+
+    const char* digits = " +-.0123456789";
+
+    for ( const char* charset : { digits, letters } ) {
+        for ( const char* c = charset; *c; ++c ) {
+            if ( *c < 32 || *c > 126 || m_index[ static_cast<int>( *c ) ] >= 0 ) continue;
+            if ( m_glyphsCount == m_maxGlyphs ) break;
+
+            m_index[ static_cast<int>( *c ) ] = static_cast<qint8>( m_glyphsCount );
+            m_glyphs[ m_glyphsCount++ ] = *c;
+        }
+    }
+
+    const QFontMetricsF metrics( m_font );
+
+    for ( int i = 0; i < m_glyphsCount; ++i ) {
+#       if QT_VERSION >= QT_VERSION_CHECK(5, 11, 0)
+        m_advances[ i ] = metrics.horizontalAdvance( QChar( m_glyphs[ i ] ) );
+#       else
+        m_advances[ i ] = metrics.width( QChar( m_glyphs[ i ] ) );
+#       endif
+    }
+
+    m_ascent = metrics.ascent();
+    m_height = metrics.height();
+
+    // rendered by the next prepare()
+    m_image  = QImage();
+    m_scaleX = 0.0;
+    m_scaleY = 0.0;
+}
+
+void GlyphAtlas::prepare(const qreal scaleX, const qreal scaleY)
+{
+    if ( !m_image.isNull() && scaleX == m_scaleX && scaleY == m_scaleY ) return;
+
+    m_scaleX = scaleX;
+    m_scaleY = scaleY;
+
+    render();
+}
+
+void GlyphAtlas::render()
+{
+    qreal maxAdvance = 0.0;
+
+    for ( int i = 0; i < m_glyphsCount; ++i ) maxAdvance = qMax( maxAdvance, m_advances[ i ] );
+
+    m_cellWidth = static_cast<int>( std::ceil( maxAdvance * m_scaleX ) ) + 2 * m_padding;
+
+    const int width  = m_glyphsCount * m_cellWidth;
+    const int height = static_cast<int>( std::ceil( m_height * m_scaleY ) ) + 2 * m_padding;
+
+    if ( width <= 0 || height <= 0 ) {
+        m_image = QImage();
+        return;
+    }
+
+    m_image = QImage( width, height, QImage::Format_ARGB32_Premultiplied );
+    m_image.fill( Qt::transparent );
+
+    QPainter painter( &m_image );
+    painter.setRenderHint( QPainter::TextAntialiasing, true );
+    painter.setFont( m_font );
+    painter.setPen( m_color );
+
+    // glyphs are drawn in the font units, so that they match text items
+    // laid out with the same font
+    painter.scale( m_scaleX, m_scaleY );
+
+    for ( int i = 0; i < m_glyphsCount; ++i ) {
+        const qreal x = ( i * m_cellWidth + m_padding ) / m_scaleX;
+        const qreal y = m_padding / m_scaleY + m_ascent;
+
+        painter.drawText( QPointF( x, y ), QString( QChar( m_glyphs[ i ] ) ) );
+    }
+}
+
+}
@@ -0,0 +1,134 @@
+/***************************************************************************//**
+ * @file GlyphAtlas.h
+ * @author  Marek M. Cel <marekcel@marekcel.pl>
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * This file is part of QFlightInstruments. You can redistribute and modify it
+ * under the terms of GNU General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.
+ * 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ *
+ * Further information about the GNU General Public License can also be found
+ * on the world wide web at http://www.gnu.org.
+ *
+ * ---
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef __qfi_GlyphAtlas_H__
+#define __qfi_GlyphAtlas_H__
+
+#include <QColor>
+#include <QFont>
+#include <QImage>
+#include <QRectF>
+
+namespace qfi {
+
+//---------------------------------------------------
+// Class: GlyphAtlas
+// Description: Pre-rendered glyphs of the digits, space, sign, point
+// and the given letters in one font and color, glyphs are rendered
+// once per device scale and then only blitted by the readouts
+//---------------------------------------------------
+class GlyphAtlas
+{
+public:
+
+    GlyphAtlas();
+
+    //
+    // sets font, color and letters (besides digits, space, sign and point)
+    // of the glyphs, only printable ASCII characters are supported
+    //
+    void setFont(const QFont& font, const QColor& color, const char* letters = "");
+
+    // re-renders glyphs if the device scale has changed
+    void prepare(const qreal scaleX, const qreal scaleY);
+
+    // returns glyph index of the character or -1 if there is no such glyph
+    inline int index(const char c) const
+    {
+        const int i = static_cast<unsigned char>( c );
+        return i < 128 ? m_index[ i ] : -1;
+    }
+
+    // returns glyph advance in the font units, unknown characters advance as space
+    inline qreal advance(const char c) const
+    {
+        const int i = index( c ) < 0 ? index( ' ' ) : index( c );
+        return i < 0 ? 0.0 : m_advances[ i ];
+    }
+
+    // returns rectangle of the glyph in the atlas image
+    inline QRectF source(const int index) const
+    {
+        return QRectF( index * m_cellWidth + m_padding, m_padding,
+                       m_advances[ index ] * m_scaleX, m_height * m_scaleY );
+    }
+
+    inline const QImage& image() const { return m_image; }
+
+    inline qreal height() const { return m_height; }
+
+private:
+
+    void render();
+
+    static const int m_maxGlyphs{64};
+
+    QFont  m_font;
+    QColor m_color;
+
+    QImage m_image;                     ///< premultiplied glyphs, one row of cells
+
+    char m_glyphs[m_maxGlyphs];         ///< characters of the glyphs
+    int m_glyphsCount{};
+
+    qint8 m_index[128];                 ///< glyph index of each ASCII character
+
+    qreal m_advances[m_maxGlyphs];
+    qreal m_ascent{};
+    qreal m_height{};
+
+    qreal m_scaleX{};
+    qreal m_scaleY{};
+
+    int m_cellWidth{};                  ///< [px]
+
+    const int m_padding{1};             ///< [px]
+};
+
+}
+
+#endif
@@ -0,0 +1,160 @@
+/***************************************************************************//**
+ * @file Gorilla.cpp
+ * @author  Marek M. Cel <marekcel@marekcel.pl>
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * This file is part of QFlightInstruments. You can redistribute and modify it
+ * under the terms of GNU General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.
+ * 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ *
+ * Further information about the GNU General Public License can also be found
+ * on the world wide web at http://www.gnu.org.
+ *
+ * ---
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include "Gorilla.hpp"
+
+#include <cstring>
+#include <limits>
+
+namespace qfi {
+
+void Gorilla::BitWriter::reset()
+{
+    m_data->clear();
+
+    m_acc  = 0;
+    m_bits = 0;
+}
+
+void Gorilla::BitWriter::finish()
+{
+    if ( m_bits > 0 ) {
+        m_data->push_back( static_cast<uchar>( m_acc << ( 8 - m_bits ) ) );
+
+        m_acc  = 0;
+        m_bits = 0;
+    }
+
+    // streams are kept 8 byte aligned
+    m_data->resize( ( m_data->size() + 7 ) / 8 * 8 + Padding, 0 );
+}
+
+void Gorilla::TimeEncoder::reset()
+{
+    m_first = true;
+}
+
+void Gorilla::TimeEncoder::encode(const qint64 time, BitWriter* writer)
+{
+    if ( m_first ) {
+        m_first = false;
+        m_delta = 0;
+        writer->write64( static_cast<quint64>( time ) );
+    } else {
+        const qint64 delta = time - m_time;
+        const qint64 dod   = delta - m_delta;
+
+        // prefixes 0, 10, 110, 1110 and 1111, the ranges suit nanoseconds
+        // timestamps of frame or timer paced sampling
+        if ( dod == 0 ) {
+            writer->write( 0x0, 1 );
+        } else if ( dod >= -( 1 << 11 ) && dod < ( 1 << 11 ) ) {
+            writer->write( 0x2, 2 );
+            writer->write( static_cast<quint32>( dod ), 12 );
+        } else if ( dod >= -( 1 << 19 ) && dod < ( 1 << 19 ) ) {
+            writer->write( 0x6, 3 );
+            writer->write( static_cast<quint32>( dod ), 20 );
+        } else if ( dod >= std::numeric_limits<qint32>::min() && dod <= std::numeric_limits<qint32>::max() ) {
+            writer->write( 0xe, 4 );
+            writer->write( static_cast<quint32>( dod ), 32 );
+        } else {
+            writer->write( 0xf, 4 );
+            writer->write64( static_cast<quint64>( dod ) );
+        }
+
+        m_delta = delta;
+    }
+
+    m_time = time;
+}
+
+void Gorilla::ValueEncoder::reset()
+{
+    m_first   = true;
+    m_leading = -1;
+}
+
+void Gorilla::ValueEncoder::encode(const float value, BitWriter* writer)
+{
+    quint32 bits;
+    std::memcpy( &bits, &value, sizeof(bits) );
+
+    if ( m_first ) {
+        m_first = false;
+        writer->write( bits, 32 );
+    } else {
+        const quint32 xor_ = bits ^ m_value;
+
+        if ( xor_ == 0 ) {
+            writer->write( 0x0, 1 );
+        } else {
+            const int leading  = static_cast<int>( qCountLeadingZeroBits( xor_ ) );
+            const int trailing = static_cast<int>( qCountTrailingZeroBits( xor_ ) );
+
+            if ( m_leading >= 0 && leading >= m_leading && trailing >= m_trailing ) {
+                // meaningful bits fit into the previous window
+                writer->write( 0x2, 2 );
+                writer->write( xor_ >> m_trailing, 32 - m_leading - m_trailing );
+            } else {
+                const int meaningful = 32 - leading - trailing;
+
+                writer->write( 0x3, 2 );
+                writer->write( static_cast<quint32>( leading ), 5 );
+                writer->write( static_cast<quint32>( meaningful - 1 ), 5 );
+                writer->write( xor_ >> trailing, meaningful );
+
+                m_leading  = leading;
+                m_trailing = trailing;
+            }
+        }
+    }
+
+    m_value = bits;
+}
+
+}
@@ -0,0 +1,316 @@
+/***************************************************************************//**
+ * @file Gorilla.h
+ * @author  Marek M. Cel <marekcel@marekcel.pl>
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * This file is part of QFlightInstruments. You can redistribute and modify it
+ * under the terms of GNU General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.
+ * 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ *
+ * Further information about the GNU General Public License can also be found
+ * on the world wide web at http://www.gnu.org.
+ *
+ * ---
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef __qfi_Gorilla_H__
+#define __qfi_Gorilla_H__
+
+#include <QtAlgorithms>
+#include <QtEndian>
+#include <QtGlobal>
+
+#include <cstring>
+#include <vector>
+
+namespace qfi {
+
+//---------------------------------------------------
+// Class: Gorilla
+// Description: Time series compression of the Gorilla database (Pelkonen
+// et al., 2015), timestamps are stored as the delta of their deltas and
+// values as XOR with the previous value, so regular timestamps and
+// slowly changing values take a bit or a few bits per sample
+//---------------------------------------------------
+class Gorilla
+{
+public:
+
+    //---------------------------------------------------
+    // Class: Gorilla::BitWriter
+    // Description: Appends bits to the byte buffer, most significant first
+    //---------------------------------------------------
+    class BitWriter
+    {
+    public:
+
+        BitWriter() = default;
+
+        explicit BitWriter(std::vector<uchar>* data) :
+            m_data(data)
+        {}
+
+        // clears the buffer, its capacity is kept
+        void reset();
+
+        // writes the given number (0 to 32) of the least significant bits
+        inline void write(const quint32 value, const int count)
+        {
+            const quint64 mask = ( Q_UINT64_C(1) << count ) - 1;
+
+            m_acc   = ( m_acc << count ) | ( value & mask );
+            m_bits += count;
+
+            while ( m_bits >= 8 ) {
+                m_bits -= 8;
+                m_data->push_back( static_cast<uchar>( m_acc >> m_bits ) );
+            }
+        }
+
+        inline void write64(const quint64 value)
+        {
+            write( static_cast<quint32>( value >> 32 ), 32 );
+            write( static_cast<quint32>( value ), 32 );
+        }
+
+        //
+        // pads the stream to whole words and appends padding bytes, so that
+        // BitReader can load whole words at any bit of the stream
+        //
+        void finish();
+
+        enum { Padding = 8 };
+
+    private:
+
+        std::vector<uchar>* m_data{};
+
+        quint64 m_acc{};
+        int m_bits{};
+    };
+
+    //---------------------------------------------------
+    // Class: Gorilla::BitReader
+    // Description: Reads bits of the buffer written by BitWriter in place
+    //---------------------------------------------------
+    class BitReader
+    {
+    public:
+
+        inline void reset(const uchar* data)
+        {
+            m_data = data;
+            m_pos  = 0;
+        }
+
+        // reads the given number (1 to 32) of bits
+        inline quint32 read(const int count)
+        {
+            const quint64 word = qFromBigEndian<quint64>( m_data + ( m_pos >> 3 ) );
+            const quint32 value = static_cast<quint32>( ( word << ( m_pos & 7 ) ) >> ( 64 - count ) );
+
+            m_pos += count;
+
+            return value;
+        }
+
+        inline quint64 read64()
+        {
+            const quint64 high = read( 32 );
+            return ( high << 32 ) | read( 32 );
+        }
+
+        // number of the leading 1 bits, up to the given maximum, the terminating 0 is consumed
+        inline int readOnes(const int max)
+        {
+            int ones = 0;
+            while ( ones < max && read( 1 ) ) ones++;
+            return ones;
+        }
+
+    private:
+
+        const uchar* m_data{};
+
+        quint64 m_pos{};                ///< [bit]
+    };
+
+    //---------------------------------------------------
+    // Class: Gorilla::TimeEncoder
+    // Description: Delta-of-delta timestamps encoder
+    //---------------------------------------------------
+    class TimeEncoder
+    {
+    public:
+
+        // starts new stream, its first timestamp is stored as is
+        void reset();
+
+        void encode(const qint64 time, BitWriter* writer);
+
+    private:
+
+        qint64 m_time{};
+        qint64 m_delta{};
+
+        bool m_first{true};
+    };
+
+    //---------------------------------------------------
+    // Class: Gorilla::TimeDecoder
+    // Description: Delta-of-delta timestamps decoder
+    //---------------------------------------------------
+    class TimeDecoder
+    {
+    public:
+
+        inline void reset()
+        {
+            m_first = true;
+        }
+
+        inline qint64 decode(BitReader* reader)
+        {
+            if ( m_first ) {
+                m_first = false;
+                m_delta = 0;
+                m_time  = static_cast<qint64>( reader->read64() );
+                return m_time;
+            }
+
+            qint64 dod = 0;
+
+            switch ( reader->readOnes( 4 ) )
+            {
+            case 0:  dod = 0;                                         break;
+            case 1:  dod = signExtend( reader->read( 12 ), 12 );      break;
+            case 2:  dod = signExtend( reader->read( 20 ), 20 );      break;
+            case 3:  dod = signExtend( reader->read( 32 ), 32 );      break;
+            default: dod = static_cast<qint64>( reader->read64() );   break;
+            }
+
+            m_delta += dod;
+            m_time  += m_delta;
+
+            return m_time;
+        }
+
+    private:
+
+        static inline qint64 signExtend(const quint32 value, const int bits)
+        {
+            return static_cast<qint32>( value << ( 32 - bits ) ) >> ( 32 - bits );
+        }
+
+        qint64 m_time{};
+        qint64 m_delta{};
+
+        bool m_first{true};
+    };
+
+    //---------------------------------------------------
+    // Class: Gorilla::ValueEncoder
+    // Description: XOR floating point values encoder
+    //---------------------------------------------------
+    class ValueEncoder
+    {
+    public:
+
+        // starts new stream, its first value is stored as is
+        void reset();
+
+        void encode(const float value, BitWriter* writer);
+
+    private:
+
+        quint32 m_value{};
+
+        int m_leading{-1};              ///< leading zeros of the current window, -1 if none
+        int m_trailing{};
+
+        bool m_first{true};
+    };
+
+    //---------------------------------------------------
+    // Class: Gorilla::ValueDecoder
+    // Description: XOR floating point values decoder
+    //---------------------------------------------------
+    class ValueDecoder
+    {
+    public:
+
+        inline void reset()
+        {
+            m_first = true;
+        }
+
+        inline float decode(BitReader* reader)
+        {
+            if ( m_first ) {
+                m_first = false;
+                m_value = reader->read( 32 );
+            } else if ( reader->read( 1 ) ) {
+                if ( reader->read( 1 ) ) {
+                    // new window
+                    m_leading = static_cast<int>( reader->read( 5 ) );
+                    const int meaningful = static_cast<int>( reader->read( 5 ) ) + 1;
+                    m_trailing = 32 - m_leading - meaningful;
+                }
+
+                const int meaningful = 32 - m_leading - m_trailing;
+
+                m_value ^= reader->read( meaningful ) << m_trailing;
+            }
+
+            float value;
+            std::memcpy( &value, &m_value, sizeof(value) );
+
+            return value;
+        }
+
+    private:
+
+        quint32 m_value{};
+
+        int m_leading{};
+        int m_trailing{};
+
+        bool m_first{true};
+    };
+};
+
+}
+
+#endif
@@ -48,77 +48,142 @@
 
 #include "Hsi.hpp"
 
-#include <QGraphicsSvgItem>
+#include "SvgItem.hpp"
 
 namespace qfi {
 
 Hsi::Hsi(QWidget* parent) : QGraphicsView(parent)
 {
-    m_scene = new QGraphicsScene( this );
-    setScene( m_scene );
-    m_scene->clear();
-    init();
+    m_renderer = new Renderer();
+    setScene( m_renderer->scene() );
+    Profile::apply( this, m_renderer->profile() );
+    m_renderer->resize( width(), height() );
+    centerOn( width() / 2.0f , height() / 2.0f );
 }
 
 Hsi::~Hsi()
 {
-    if (m_scene) {
-        m_scene->clear();
-        delete m_scene;
-        m_scene = nullptr;
+    if ( m_renderer ) {
+        delete m_renderer;
+        m_renderer = nullptr;
     }
 }
 
 void Hsi::reinit()
 {
-    if (m_scene) {
-        m_scene->clear();
-        init();
-    }
+    m_renderer->reinit();
+    centerOn( width() / 2.0f , height() / 2.0f );
 }
 
 void Hsi::update()
 {
-    updateView();
+    m_renderer->update();
 }
 
-void Hsi::setHeading(const float heading)
+void Hsi::setRasterCache(const bool rasterCache)
 {
-    m_heading = heading;
+    m_renderer->setRasterCache( rasterCache );
 }
 
-void Hsi::resizeEvent( QResizeEvent *event )
+void Hsi::setProfile(const Profile::Type profile)
+{
+    m_renderer->setProfile( profile );
+    Profile::apply( this, profile );
+}
+
+void Hsi::resizeEvent(QResizeEvent* event)
 {
     QGraphicsView::resizeEvent( event );
+    m_renderer->resize( width(), height() );
+    centerOn( width() / 2.0f , height() / 2.0f );
+}
+
+void Hsi::paintEvent(QPaintEvent* event)
+{
+    Timings::Scope scope( &m_renderer->timings(), Timings::Paint );
+    QGraphicsView::paintEvent( event );
+}
+
+Hsi::Renderer::Renderer()
+{
+    m_width  = m_originalWidth;
+    m_height = m_originalHeight;
+
     reinit();
 }
 
-void Hsi::init()
+Hsi::Renderer::~Renderer()
 {
-    m_scaleX = static_cast<float>(width())  / static_cast<float>(m_originalWidth);
-    m_scaleY = static_cast<float>(height()) / static_cast<float>(m_originalHeight);
+    if ( m_scene ) m_scene->clear();
 
     reset();
+}
+
+void Hsi::Renderer::setHeading(const float heading)
+{
+    Timings::Scope scope( &m_timings, Timings::Update );
+
+    if ( heading != m_heading ) {
+        m_heading = heading;
+        invalidate();
+    }
+}
 
-    m_itemFace = new QGraphicsSvgItem( ":/qfi/images/hsi/hsi_face.svg" );
+void Hsi::Renderer::setState(const HsiState& state)
+{
+    Timings::Scope scope( &m_timings, Timings::Update );
+
+    setHeading( state.heading );
+}
+
+void Hsi::Renderer::publish(const HsiState& state)
+{
+    m_published.publish( state );
+}
+
+void Hsi::Renderer::init()
+{
+    m_scaleX = static_cast<float>(m_width)  / static_cast<float>(m_originalWidth);
+    m_scaleY = static_cast<float>(m_height) / static_cast<float>(m_originalHeight);
+
+    reset();
+
+    m_itemFace = new SvgItem( ":/qfi/images/hsi/hsi_face.svg" );
     m_itemFace->setCacheMode( QGraphicsItem::NoCache );
     m_itemFace->setZValue( m_faceZ );
     m_itemFace->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
     m_itemFace->setTransformOriginPoint( m_originalHsiCtr );
     m_scene->addItem( m_itemFace );
 
-    m_itemCase = new QGraphicsSvgItem( ":/qfi/images/hsi/hsi_case.svg" );
+    m_itemCase = new SvgItem( ":/qfi/images/hsi/hsi_case.svg" );
     m_itemCase->setCacheMode( QGraphicsItem::NoCache );
     m_itemCase->setZValue( m_caseZ );
     m_itemCase->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
     m_scene->addItem( m_itemCase );
 
-    centerOn(width() / 2.0f , height() / 2.0f);
+    m_compositor.setPolicy( m_itemCase, Compositor::Static );
 
-    updateView();
+    SvgItem::setRasterCache( m_scene, m_rasterCache );
+
+    invalidate();
+    refresh();
 }
 
-void Hsi::reset()
+void Hsi::Renderer::rescale()
+{
+    m_scaleX = static_cast<float>(m_width)  / static_cast<float>(m_originalWidth);
+    m_scaleY = static_cast<float>(m_height) / static_cast<float>(m_originalHeight);
+
+    const QTransform scale = QTransform::fromScale( m_scaleX, m_scaleY );
+
+    m_itemFace->setTransform( scale );
+    m_itemCase->setTransform( scale );
+
+    invalidate();
+    refresh();
+}
+
+void Hsi::Renderer::reset()
 {
     m_itemFace = nullptr;
     m_itemCase = nullptr;
@@ -126,10 +191,16 @@ void Hsi::reset()
     m_heading = 0.0f;
 }
 
-void Hsi::updateView()
+void Hsi::Renderer::fetchPublished()
+{
+    HsiState state;
+
+    if ( m_published.fetch( &state ) ) setState( state );
+}
+
+void Hsi::Renderer::updateView()
 {
     m_itemFace->setRotation(-m_heading);
-    m_scene->update();
 }
 
 }
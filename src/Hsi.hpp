@@ -50,6 +50,9 @@
 
 #include <QGraphicsView>
 
+#include "Instrument.hpp"
+#include "TripleBuffer.hpp"
+
 class QWidget;
 class QResizeEvent;
 class QGraphicsScene;
@@ -57,6 +60,15 @@ class QGraphicsSvgItem;
 
 namespace qfi {
 
+//---------------------------------------------------
+// Struct: HsiState
+// Description: Horizontal Situation Indicator state snapshot
+//---------------------------------------------------
+struct HsiState
+{
+    float heading{};                    ///< [deg]
+};
+
 //---------------------------------------------------
 // Class: Hsi
 // Description: Horizontal Situation Indicator widget
@@ -66,6 +78,56 @@ class Hsi : public QGraphicsView
     Q_OBJECT
 
 public:
+
+    //---------------------------------------------------
+    // Class: Hsi::Renderer
+    // Description: Horizontal Situation Indicator headless renderer
+    //---------------------------------------------------
+    class Renderer : public Instrument
+    {
+    public:
+        Renderer();
+        virtual ~Renderer();
+
+        void setHeading(const float);
+
+        // sets all the values at once
+        void setState(const HsiState& state);
+
+        //
+        // publishes state to be applied by the next update(), can be called
+        // from any single producer thread, never blocks nor allocates
+        //
+        void publish(const HsiState& state);
+
+    protected:
+        void init();
+        void rescale();
+        void updateView();
+        void fetchPublished();
+
+    private:
+        void reset();
+
+        QGraphicsSvgItem* m_itemFace{};
+        QGraphicsSvgItem* m_itemCase{};
+
+        float m_heading{};
+
+        TripleBuffer<HsiState> m_published;
+
+        float m_scaleX{1.0f};
+        float m_scaleY{1.0f};
+
+        const int m_originalHeight{240};
+        const int m_originalWidth{240};
+
+        QPointF m_originalHsiCtr{120.0f, 120.0f};
+
+        const int m_faceZ{-20};
+        const int m_caseZ{10};
+    };
+
     Hsi(QWidget* parent = nullptr);
     virtual ~Hsi();
 
@@ -75,33 +137,41 @@ public:
     // refreshes (redraws) widget
     void update();
 
-    void setHeading(const float);
-
-protected:
-    void resizeEvent(QResizeEvent*);
-
-private:
-    void init();
-    void reset();
-    void updateView();
+    // enables/disables cached raster mode of the SVG layers
+    void setRasterCache(const bool);
 
-    QGraphicsScene* m_scene{};
+    // sets performance profile of the widget and its renderer
+    void setProfile(const Profile::Type profile);
 
-    QGraphicsSvgItem* m_itemFace{};
-    QGraphicsSvgItem* m_itemCase{};
+    // headless renderer of the widget, e.g. to be registered in RenderScheduler
+    inline Renderer* renderer() const { return m_renderer; }
 
-    float m_heading{};
+    // sets all the values at once
+    inline void setState(const HsiState& state)
+    {
+        m_renderer->setState( state );
+    }
 
-    float m_scaleX{1.0f};
-    float m_scaleY{1.0f};
+    //
+    // publishes state to be applied by the next update(), can be called
+    // from any single producer thread, never blocks nor allocates
+    //
+    inline void publish(const HsiState& state)
+    {
+        m_renderer->publish( state );
+    }
 
-    const int m_originalHeight{240};
-    const int m_originalWidth{240};
+    inline void setHeading(const float heading)
+    {
+        m_renderer->setHeading( heading );
+    }
 
-    QPointF m_originalHsiCtr{120.0f, 120.0f};
+protected:
+    void paintEvent(QPaintEvent*);
+    void resizeEvent(QResizeEvent*);
 
-    const int m_faceZ{-20};
-    const int m_caseZ{10};
+private:
+    Renderer* m_renderer{};
 };
 
 }
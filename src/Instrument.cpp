@@ -0,0 +1,172 @@
+/***************************************************************************//**
+ * @file Instrument.cpp
+ * @author  Marek M. Cel <marekcel@marekcel.pl>
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * This file is part of QFlightInstruments. You can redistribute and modify it
+ * under the terms of GNU General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.
+ * 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ *
+ * Further information about the GNU General Public License can also be found
+ * on the world wide web at http://www.gnu.org.
+ *
+ * ---
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include "Instrument.hpp"
+
+#include <QGraphicsScene>
+#include <QImage>
+#include <QPainter>
+
+#include "SvgItem.hpp"
+
+namespace qfi {
+
+Instrument::Instrument()
+{
+    m_scene = new QGraphicsScene();
+    m_scene->setItemIndexMethod( Profile::itemIndexMethod( m_profile ) );
+}
+
+Instrument::~Instrument()
+{
+    if ( m_scene ) {
+        m_scene->clear();
+        delete m_scene;
+        m_scene = nullptr;
+    }
+}
+
+void Instrument::reinit()
+{
+    if ( m_scene ) {
+        Timings::Scope scope( &m_timings, Timings::Init );
+
+        m_compositor.clear();
+        m_scene->clear();
+        init();
+        m_compositor.build( m_scene );
+    }
+}
+
+bool Instrument::update()
+{
+    {
+        Timings::Scope scope( &m_timings, Timings::Update );
+        fetchPublished();
+    }
+
+    const bool refreshed = m_dirty != DirtyNone;
+
+    if ( refreshed ) {
+        Timings::Scope scope( &m_timings, Timings::Transform );
+
+        updateView();
+        m_compositor.sync();
+        m_dirty = DirtyNone;
+    }
+
+    m_timings.countFrame( refreshed );
+
+    return refreshed;
+}
+
+void Instrument::refresh()
+{
+    fetchPublished();
+
+    if ( m_dirty != DirtyNone ) {
+        updateView();
+        m_compositor.sync();
+        m_dirty = DirtyNone;
+    }
+}
+
+void Instrument::resize(const int width, const int height)
+{
+    if ( width != m_width || height != m_height ) {
+        m_width  = width;
+        m_height = height;
+
+        Timings::Scope scope( &m_timings, Timings::Init );
+        rescale();
+        m_compositor.invalidate();
+    }
+}
+
+void Instrument::setRasterCache(const bool rasterCache)
+{
+    m_rasterCache = rasterCache;
+    SvgItem::setRasterCache( m_scene, m_rasterCache );
+}
+
+void Instrument::setProfile(const Profile::Type profile)
+{
+    m_profile = profile;
+
+    m_scene->setItemIndexMethod( Profile::itemIndexMethod( m_profile ) );
+
+    setRasterCache( Profile::rasterCache( m_profile ) );
+}
+
+void Instrument::render(QImage* image)
+{
+    resize( image->width(), image->height() );
+    update();
+
+    image->fill( Qt::transparent );
+
+    // same render hints as the widgets of the profile use so that
+    // the output matches them
+    QPainter painter( image );
+    painter.setRenderHints( Profile::renderHints( m_profile ) );
+
+    const QRectF rect( 0.0, 0.0, m_width, m_height );
+
+    Timings::Scope scope( &m_timings, Timings::Paint );
+    m_scene->render( &painter, rect, rect );
+}
+
+void Instrument::render(uchar* data, const int width, const int height,
+                        const int bytesPerLine, const bool premultiplied)
+{
+    QImage image( data, width, height, bytesPerLine,
+                  premultiplied ? QImage::Format_ARGB32_Premultiplied : QImage::Format_ARGB32 );
+    render( &image );
+}
+
+}
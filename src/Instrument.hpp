@@ -0,0 +1,186 @@
+/***************************************************************************//**
+ * @file Instrument.h
+ * @author  Marek M. Cel <marekcel@marekcel.pl>
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * This file is part of QFlightInstruments. You can redistribute and modify it
+ * under the terms of GNU General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.
+ * 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ *
+ * Further information about the GNU General Public License can also be found
+ * on the world wide web at http://www.gnu.org.
+ *
+ * ---
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef __qfi_Instrument_H__
+#define __qfi_Instrument_H__
+
+#include <QtGlobal>
+
+#include "Compositor.hpp"
+#include "Profile.hpp"
+#include "Timings.hpp"
+
+class QGraphicsScene;
+class QImage;
+
+namespace qfi {
+
+//---------------------------------------------------
+// Class: Instrument
+// Description: Headless instrument base, owns the graphics scene of
+// the instrument layers and renders it offscreen without any widget
+//---------------------------------------------------
+class Instrument
+{
+public:
+
+    // flags of the parts of the view changed since the last refresh
+    enum Dirty
+    {
+        DirtyNone = 0x0000,
+        DirtyAll  = 0xffff
+    };
+
+    Instrument();
+    virtual ~Instrument();
+
+    // reinitiates instrument
+    void reinit();
+
+    //
+    // refreshes (redraws) instrument, the latest published state is applied
+    // first, then only the items depending on the values changed since the
+    // last refresh are updated and nothing is done at all if no value has
+    // changed, returns true if the view has been refreshed
+    //
+    bool update();
+
+    // marks the whole view to be refreshed by the next update
+    inline void invalidate() { m_dirty = DirtyAll; }
+
+    // returns true if the view has changes not refreshed yet
+    inline bool isDirty() const { return m_dirty != DirtyNone; }
+
+    // resizes instrument [px]
+    void resize(const int width, const int height);
+
+    // enables/disables cached raster mode of the SVG layers
+    void setRasterCache(const bool);
+
+    //
+    // sets performance profile, i.e. the scene index, the SVG layers cache
+    // mode and the headless rendering hints, the view part of the profile
+    // is applied by the widgets, see Profile
+    //
+    void setProfile(const Profile::Type profile);
+
+    inline Profile::Type profile() const { return m_profile; }
+
+    //
+    // renders instrument into the given image, instrument is resized to
+    // the image size and the image is cleared to transparent first
+    //
+    void render(QImage* image);
+
+    //
+    // renders instrument into the given raw ARGB32 buffer, premultiplied
+    // alpha is the fastest to paint into, the buffer has to hold at least
+    // height * bytesPerLine bytes
+    //
+    void render(uchar* data, const int width, const int height,
+                const int bytesPerLine, const bool premultiplied = false);
+
+    inline QGraphicsScene* scene() const { return m_scene; }
+
+    //
+    // composition of the cached layers, instruments set the default cache
+    // policies of their layers on init, policies can be changed afterwards
+    // until the instrument is reinitiated
+    //
+    inline Compositor* compositor() { return &m_compositor; }
+
+    //
+    // render phases timings, init covers reinit() and resize(), update
+    // covers setState(), the setters and applying published state,
+    // transform covers placing items by update() and paint covers render()
+    // and painting of the widget
+    //
+    inline const Timings& timings() const { return m_timings; }
+    inline Timings& timings() { return m_timings; }
+
+    inline int width()  const { return m_width;  }
+    inline int height() const { return m_height; }
+
+protected:
+
+    // creates scene items at the current size
+    virtual void init() = 0;
+
+    // adjusts existing scene items to the current size
+    virtual void rescale() = 0;
+
+    // applies changed instrument state (m_dirty flags) to the scene items
+    virtual void updateView() = 0;
+
+    // applies the latest state published from other threads, if any
+    virtual void fetchPublished() {}
+
+    //
+    // update() without timing and frame counting, used by init() and
+    // rescale() so that they do not count as rendered frames
+    //
+    void refresh();
+
+    QGraphicsScene* m_scene{};
+
+    Compositor m_compositor;
+
+    int m_width{};                      ///< [px]
+    int m_height{};                     ///< [px]
+
+    int m_dirty{DirtyAll};               ///< changed parts of the view
+
+    bool m_rasterCache{};
+
+    Profile::Type m_profile{Profile::Quality};
+
+    Timings m_timings;
+};
+
+}
+
+#endif
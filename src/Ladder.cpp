@@ -0,0 +1,287 @@
+/***************************************************************************//**
+ * @file Ladder.cpp
+ * @author  Marek M. Cel <marekcel@marekcel.pl>
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * This file is part of QFlightInstruments. You can redistribute and modify it
+ * under the terms of GNU General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.
+ * 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ *
+ * Further information about the GNU General Public License can also be found
+ * on the world wide web at http://www.gnu.org.
+ *
+ * ---
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include "Ladder.hpp"
+
+#include <QPainter>
+#include <QPen>
+
+#include <cmath>
+
+#include "Readout.hpp"
+#include "SvgItem.hpp"
+
+#ifndef M_PI
+#   define M_PI 3.14159265358979323846
+#endif
+
+namespace qfi {
+
+Ladder::Ladder(const QRectF& window, const QPointF& center, const float pixPerDeg,
+               QGraphicsItem* parent) :
+    QGraphicsItem(parent),
+    m_window(window),
+    m_center(center),
+    m_pixPerDeg(pixPerDeg)
+{
+    const QPointF corners[] = { m_window.topLeft(), m_window.topRight(),
+                                m_window.bottomRight(), m_window.bottomLeft() };
+
+    for ( const QPointF& corner : corners ) {
+        const QPointF d = corner - m_center;
+        m_radius = qMax( m_radius, std::sqrt( d.x() * d.x() + d.y() * d.y() ) );
+    }
+}
+
+void Ladder::setBackground(const QColor& sky, const QColor& ground)
+{
+    m_skyColor    = sky;
+    m_groundColor = ground;
+
+    update();
+}
+
+void Ladder::setLadder(const QColor& color, const QFont& labelsFont)
+{
+    m_ladderColor = color;
+    m_labelsAtlas.setFont( labelsFont, m_ladderColor );
+
+    update();
+}
+
+void Ladder::setHorizonLimit(const float limit)
+{
+    m_horizonLimit = limit;
+
+    update();
+}
+
+void Ladder::setAttitude(const float roll, const float pitch)
+{
+    if ( roll == m_roll && pitch == m_pitch ) return;
+
+    m_roll  = roll;
+    m_pitch = pitch;
+
+    update();
+}
+
+QRectF Ladder::boundingRect() const
+{
+    return m_window;
+}
+
+void Ladder::paint(QPainter* painter, const QStyleOptionGraphicsItem*, QWidget*)
+{
+    // labels are rendered at the device scale
+    const QSizeF scale = SvgItem::deviceScale( painter );
+    const qreal sx = scale.width();
+    const qreal sy = scale.height();
+
+    m_labelsAtlas.prepare( sx, sy );
+
+    const qreal roll_rad = M_PI * m_roll / 180.0;
+
+    const qreal sinRoll = std::sin( roll_rad );
+    const qreal cosRoll = std::cos( roll_rad );
+
+    // pitch displacement along the ladder axis
+    const qreal delta   = m_pixPerDeg * m_pitch;
+    const qreal limit   = m_pixPerDeg * m_horizonLimit;
+    const qreal horizon = qBound( -limit, delta, limit );
+
+    painter->save();
+    painter->setClipRect( m_window, Qt::IntersectClip );
+
+    paintBackground( painter, sinRoll, cosRoll, horizon );
+
+    // ladder frame, origin at the center, y axis along the ladder
+    painter->translate( m_center );
+    painter->rotate( -m_roll );
+
+    painter->fillRect( QRectF( -m_radius, horizon - 0.5, 2.0 * m_radius, 1.0 ), m_ladderColor );
+
+    paintLines( painter, delta );
+
+    painter->restore();
+}
+
+void Ladder::paintBackground(QPainter* painter, const qreal sinRoll, const qreal cosRoll,
+                             const qreal horizon)
+{
+    const QPointF corners[ 4 ] = { m_window.topLeft(), m_window.topRight(),
+                                   m_window.bottomRight(), m_window.bottomLeft() };
+
+    // signed distances of the window corners below the horizon
+    qreal distances[ 4 ];
+
+    for ( int i = 0; i < 4; ++i ) {
+        const QPointF d = corners[ i ] - m_center;
+        distances[ i ] = d.x() * sinRoll + d.y() * cosRoll - horizon;
+    }
+
+    // a line splits a rectangle into polygons of at most 5 vertices
+    QPointF polygon[ 8 ];
+
+    painter->setPen( Qt::NoPen );
+
+    int count = clip( corners, distances, -1.0, polygon );
+
+    if ( count > 2 ) {
+        painter->setBrush( m_skyColor );
+        painter->drawConvexPolygon( polygon, count );
+    }
+
+    count = clip( corners, distances, 1.0, polygon );
+
+    if ( count > 2 ) {
+        painter->setBrush( m_groundColor );
+        painter->drawConvexPolygon( polygon, count );
+    }
+}
+
+void Ladder::paintLines(QPainter* painter, const qreal delta)
+{
+    // lines are 2.5 deg apart, only the ones within the window are drawn
+    const qreal margin = m_radius + m_labelsAtlas.height();
+
+    const int first = static_cast<int>( std::ceil ( ( m_pitch - margin / m_pixPerDeg ) / 2.5 ) );
+    const int last  = static_cast<int>( std::floor( ( m_pitch + margin / m_pixPerDeg ) / 2.5 ) );
+
+    for ( int i = qMax( first, -36 ); i <= qMin( last, 36 ); ++i ) {
+        const float pitch = 2.5f * i;
+        const float absPitch = std::fabs( pitch );
+
+        qreal width = 0.0;
+
+        if ( i % 4 == 0 ) {
+            if ( absPitch <= 60.0f || absPitch == 90.0f ) width = m_majorWidth;
+        } else if ( absPitch < m_minorLimit ) {
+            width = i % 2 == 0 ? m_mediumWidth : m_minorWidth;
+        }
+
+        if ( width == 0.0 ) continue;
+
+        const qreal y = delta - m_pixPerDeg * pitch;
+
+        painter->fillRect( QRectF( -width / 2.0, y - 0.5, width, 1.0 ), m_ladderColor );
+
+        if ( width == m_majorWidth && i != 0 ) {
+            char text[ 8 ];
+            Readout::format( text, sizeof(text), absPitch, 0, 0 );
+
+            paintLabel( painter, text, -width / 2.0 - m_labelsGap, y, true  );
+            paintLabel( painter, text,  width / 2.0 + m_labelsGap, y, false );
+        }
+    }
+
+    // chevrons pointing to the horizon at extreme attitude
+    if ( m_pitch + margin / m_pixPerDeg >  65.0f ) paintChevron( painter, delta,  1.0f );
+    if ( m_pitch - margin / m_pixPerDeg < -65.0f ) paintChevron( painter, delta, -1.0f );
+}
+
+void Ladder::paintChevron(QPainter* painter, const qreal delta, const float sign)
+{
+    const qreal yTip  = delta - m_pixPerDeg * sign * 67.5f;
+    const qreal yTail = delta - m_pixPerDeg * sign * 87.5f;
+
+    const QPointF points[] = { QPointF( -15.0, yTail ), QPointF( 0.0, yTip ), QPointF( 15.0, yTail ) };
+
+    painter->setPen( QPen( Qt::red, 3.0 ) );
+    painter->setBrush( Qt::NoBrush );
+    painter->drawPolyline( points, 3 );
+}
+
+void Ladder::paintLabel(QPainter* painter, const char* text, const qreal x, const qreal y,
+                        const bool alignRight)
+{
+    if ( m_labelsAtlas.image().isNull() ) return;
+
+    qreal width = 0.0;
+
+    for ( const char* c = text; *c; ++c ) width += m_labelsAtlas.advance( *c );
+
+    qreal left = alignRight ? x - width : x;
+    const qreal top = y - m_labelsAtlas.height() / 2.0;
+
+    for ( const char* c = text; *c; ++c ) {
+        const int index = m_labelsAtlas.index( *c );
+        const qreal advance = m_labelsAtlas.advance( *c );
+
+        if ( index >= 0 ) {
+            painter->drawImage( QRectF( left, top, advance, m_labelsAtlas.height() ),
+                                m_labelsAtlas.image(), m_labelsAtlas.source( index ) );
+        }
+
+        left += advance;
+    }
+}
+
+int Ladder::clip(const QPointF* polygon, const qreal* distances,
+                 const qreal sign, QPointF* result)
+{
+    // keeps the part of the quadrilateral where sign * distance >= 0
+    int count = 0;
+
+    for ( int i = 0; i < 4; ++i ) {
+        const int j = ( i + 1 ) % 4;
+
+        const qreal a = sign * distances[ i ];
+        const qreal b = sign * distances[ j ];
+
+        if ( a >= 0.0 ) result[ count++ ] = polygon[ i ];
+
+        if ( ( a >= 0.0 ) != ( b >= 0.0 ) ) {
+            result[ count++ ] = polygon[ i ] + ( polygon[ j ] - polygon[ i ] ) * ( a / ( a - b ) );
+        }
+    }
+
+    return count;
+}
+
+}
@@ -0,0 +1,148 @@
+/***************************************************************************//**
+ * @file Ladder.h
+ * @author  Marek M. Cel <marekcel@marekcel.pl>
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * This file is part of QFlightInstruments. You can redistribute and modify it
+ * under the terms of GNU General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.
+ * 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ *
+ * Further information about the GNU General Public License can also be found
+ * on the world wide web at http://www.gnu.org.
+ *
+ * ---
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef __qfi_Ladder_H__
+#define __qfi_Ladder_H__
+
+#include <QColor>
+#include <QFont>
+#include <QGraphicsItem>
+
+#include "GlyphAtlas.hpp"
+
+class QPainter;
+class QStyleOptionGraphicsItem;
+class QWidget;
+
+namespace qfi {
+
+//---------------------------------------------------
+// Class: Ladder
+// Description: Attitude indicator sky and ground split and pitch ladder,
+// the split is filled as two polygons clipped to the visible window and
+// only the pitch lines and labels within the window are drawn, labels
+// are blitted from a glyph atlas
+//---------------------------------------------------
+class Ladder : public QGraphicsItem
+{
+public:
+
+    enum { Type = UserType + 4 };
+
+    //
+    // window [item units] visible part of the indicator
+    // center [item units] position of the horizon at zero attitude
+    // pixPerDeg [item units] pitch scale
+    //
+    Ladder(const QRectF& window, const QPointF& center, const float pixPerDeg,
+           QGraphicsItem* parent = nullptr);
+
+    void setBackground(const QColor& sky, const QColor& ground);
+
+    // sets color of the pitch lines, labels and horizon line and font of the labels
+    void setLadder(const QColor& color, const QFont& labelsFont);
+
+    //
+    // sets maximum horizon displacement [deg], beyond it the horizon
+    // stays at the edge so that both sky and ground remain visible
+    //
+    void setHorizonLimit(const float limit);
+
+    // roll [deg], pitch [deg]
+    void setAttitude(const float roll, const float pitch);
+
+    QRectF boundingRect() const;
+
+    int type() const
+    {
+        return Type;
+    }
+
+    void paint(QPainter*, const QStyleOptionGraphicsItem*, QWidget* = nullptr);
+
+private:
+
+    void paintBackground(QPainter* painter, const qreal sinRoll, const qreal cosRoll,
+                         const qreal horizon);
+
+    void paintLines(QPainter* painter, const qreal delta);
+
+    void paintChevron(QPainter* painter, const qreal delta, const float sign);
+
+    void paintLabel(QPainter* painter, const char* text, const qreal x, const qreal y,
+                    const bool alignRight);
+
+    static int clip(const QPointF* polygon, const qreal* distances,
+                    const qreal sign, QPointF* result);
+
+    GlyphAtlas m_labelsAtlas;
+
+    QRectF  m_window;
+    QPointF m_center;
+
+    QColor m_skyColor;
+    QColor m_groundColor;
+    QColor m_ladderColor;
+
+    float m_pixPerDeg{};
+    float m_horizonLimit{90.0f};
+
+    float m_roll{};
+    float m_pitch{};
+
+    qreal m_radius{};                   ///< farthest window corner distance from the center
+
+    const qreal m_majorWidth{50.0};     ///< 10 deg lines width
+    const qreal m_mediumWidth{25.0};    ///< 5 deg lines width
+    const qreal m_minorWidth{12.5};     ///< 2.5 deg lines width
+    const qreal m_labelsGap{3.0};
+    const float m_minorLimit{50.0f};    ///< [deg] minor lines extent
+};
+
+}
+
+#endif
@@ -0,0 +1,195 @@
+/***************************************************************************//**
+ * @file Mavlink.cpp
+ * @author  Marek M. Cel <marekcel@marekcel.pl>
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * This file is part of QFlightInstruments. You can redistribute and modify it
+ * under the terms of GNU General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.
+ * 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ *
+ * Further information about the GNU General Public License can also be found
+ * on the world wide web at http://www.gnu.org.
+ *
+ * ---
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include "Mavlink.hpp"
+
+#include <QtMath>
+
+namespace qfi {
+
+// unit conversions to the units of the sample values
+static const double knotsPerMeterPerSecond = 3600.0 / 1852.0;
+static const double feetPerMeter           = 1.0 / 0.3048;
+static const double feetPerMinutePerMps    = 60.0 / 0.3048;
+
+Mavlink::Parser::Result Mavlink::Parser::check(const uchar* data, const int size, Frame* frame, int* frameSize)
+{
+    const bool v2 = data[ 0 ] == 0xFD;
+
+    if ( !v2 && data[ 0 ] != 0xFE ) return Invalid;
+
+    const int headerSize = v2 ? 10 : 6;
+
+    if ( size < headerSize ) return Incomplete;
+
+    const int length = data[ 1 ];
+
+    int total = headerSize + length + 2;
+
+    if ( v2 ) {
+        // only the signature flag is defined
+        if ( data[ 2 ] & ~0x01 ) return Invalid;
+        if ( data[ 2 ] &  0x01 ) total += 13;
+    }
+
+    if ( size < total ) return Incomplete;
+
+    const quint32 message = v2 ? data[ 7 ] | ( data[ 8 ] << 8 ) | ( data[ 9 ] << 16 ) : data[ 5 ];
+
+    const int offset = v2 ? 4 : 2;
+
+    *frameSize = total;
+
+    frame->payload   = data + headerSize;
+    frame->size      = length;
+    frame->message   = message;
+    frame->sequence  = data[ offset     ];
+    frame->system    = data[ offset + 1 ];
+    frame->component = data[ offset + 2 ];
+
+    const int extra = crcExtra( message );
+
+    // sequence of unknown frames is tracked once they are skipped (see skip())
+    if ( extra < 0 ) return Unknown;
+
+    const uchar seed = static_cast<uchar>( extra );
+
+    const quint16 checksum = Mavlink::crc( &seed, 1, Mavlink::crc( data + 1, headerSize - 1 + length ) );
+
+    if ( checksum != ( data[ headerSize + length ] | ( data[ headerSize + length + 1 ] << 8 ) ) ) {
+        m_errors++;
+        return Invalid;
+    }
+
+    track( *frame );
+
+    m_frames++;
+
+    return Valid;
+}
+
+void Mavlink::Parser::skip(const Frame& frame)
+{
+    track( frame );
+
+    m_unknown++;
+}
+
+void Mavlink::Parser::track(const Frame& frame)
+{
+    if ( m_tracking && frame.system == m_system && frame.component == m_component ) {
+        m_lost += static_cast<quint8>( frame.sequence - m_sequence - 1 );
+    }
+
+    m_system    = frame.system;
+    m_component = frame.component;
+    m_sequence  = frame.sequence;
+    m_tracking  = true;
+}
+
+void Mavlink::Parser::resetCounters()
+{
+    m_frames  = 0;
+    m_errors  = 0;
+    m_unknown = 0;
+    m_lost    = 0;
+    m_bytes   = 0;
+
+    m_tracking = false;
+}
+
+int Mavlink::crcExtra(const quint32 message)
+{
+    switch ( message )
+    {
+    case Heartbeat:         return 50;
+    case Attitude:          return 39;
+    case GlobalPositionInt: return 104;
+    case VfrHud:            return 20;
+    }
+
+    return -1;
+}
+
+bool Mavlink::apply(const Frame& frame, TelemetrySample* sample)
+{
+    switch ( frame.message )
+    {
+    case Attitude:
+    {
+        // time_boot_ms, roll, pitch, yaw [rad], rollspeed, pitchspeed, yawspeed [rad/s]
+        const float heading = qRadiansToDegrees( frame.real( 12 ) );
+
+        sample->roll     = qRadiansToDegrees( frame.real( 4 ) );
+        sample->pitch    = qRadiansToDegrees( frame.real( 8 ) );
+        sample->heading  = heading < 0.0f ? heading + 360.0f : heading;
+        sample->turnRate = qRadiansToDegrees( frame.real( 24 ) );
+
+        return true;
+    }
+
+    case VfrHud:
+        // airspeed, groundspeed [m/s], alt [m], climb [m/s], heading [deg], throttle [%]
+        sample->airspeed  = static_cast<float>( knotsPerMeterPerSecond * frame.real( 0 ) );
+        sample->altitude  = static_cast<float>( feetPerMeter * frame.real( 8 ) );
+        sample->climbRate = static_cast<float>( feetPerMinutePerMps * frame.real( 12 ) );
+
+        return true;
+
+    case GlobalPositionInt:
+        // time_boot_ms, lat, lon [degE7], alt, relative_alt [mm], vx, vy, vz [cm/s], hdg [cdeg]
+        sample->altitude  = static_cast<float>( feetPerMeter * 1.0e-3 * frame.integer<qint32>( 12 ) );
+        sample->climbRate = static_cast<float>( -feetPerMinutePerMps * 1.0e-2 * frame.integer<qint16>( 24 ) );
+
+        return true;
+    }
+
+    return false;
+}
+
+}
@@ -0,0 +1,333 @@
+/***************************************************************************//**
+ * @file Mavlink.h
+ * @author  Marek M. Cel <marekcel@marekcel.pl>
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * This file is part of QFlightInstruments. You can redistribute and modify it
+ * under the terms of GNU General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.
+ * 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ *
+ * Further information about the GNU General Public License can also be found
+ * on the world wide web at http://www.gnu.org.
+ *
+ * ---
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef __qfi_Mavlink_H__
+#define __qfi_Mavlink_H__
+
+#include <QtEndian>
+#include <QtGlobal>
+
+#include <cstring>
+
+#include "Telemetry.hpp"
+
+namespace qfi {
+
+//---------------------------------------------------
+// Class: Mavlink
+// Description: MAVLink 1 and 2 framing and decoding of the messages
+// feeding the instruments, frames are parsed in place and only those of
+// the known messages are validated (checksum), see MavlinkInput
+//---------------------------------------------------
+class Mavlink
+{
+public:
+
+    enum Message
+    {
+        Heartbeat         = 0,
+        Attitude          = 30,
+        GlobalPositionInt = 33,
+        VfrHud            = 74
+    };
+
+    enum
+    {
+        MaxFrameSize = 10 + 255 + 2 + 13    ///< [B] MAVLink 2 signed frame
+    };
+
+    //---------------------------------------------------
+    // Struct: Mavlink::Frame
+    // Description: Valid frame, the payload points into the parsed data
+    //---------------------------------------------------
+    struct Frame
+    {
+        const uchar* payload{};
+        int size{};                     ///< [B] payload size, MAVLink 2 truncates trailing zeros
+
+        quint32 message{};              ///< message ID
+        quint8 sequence{};
+        quint8 system{};
+        quint8 component{};
+
+        // little endian integer field at the given offset
+        template <typename T>
+        inline T integer(const int offset) const
+        {
+            if ( offset + static_cast<int>( sizeof(T) ) <= size ) {
+                return qFromLittleEndian<T>( payload + offset );
+            }
+
+            // bytes of the truncated payload are zeros
+            uchar bytes[ sizeof(T) ] = {};
+            if ( offset < size ) std::memcpy( bytes, payload + offset, size - offset );
+
+            return qFromLittleEndian<T>( bytes );
+        }
+
+        // little endian float field at the given offset
+        inline float real(const int offset) const
+        {
+            const quint32 bits = integer<quint32>( offset );
+
+            float value;
+            std::memcpy( &value, &bits, sizeof(value) );
+
+            return value;
+        }
+    };
+
+    //---------------------------------------------------
+    // Class: Mavlink::Parser
+    // Description: Extracts frames of the received data in place, only
+    // a frame split between two consecutive data is copied
+    //---------------------------------------------------
+    class Parser
+    {
+    public:
+
+        enum Result
+        {
+            Valid = 0,                  ///< frame of a known message with valid checksum
+            Unknown,                    ///< frame of an unknown message, not validated
+            Invalid,                    ///< not a frame or invalid checksum
+            Incomplete                  ///< more data needed
+        };
+
+        //
+        // calls handler( const Frame& ) for every valid frame of the data
+        // (stream of frames, e.g. datagram or serial data), frames are
+        // valid only within the handler, returns number of valid frames
+        //
+        template <class Handler>
+        int parse(const uchar* data, const int size, Handler handler);
+
+        //
+        // checks frame beginning at the data (with the start byte), sets
+        // frame and its size in bytes if valid or unknown, frames of unknown
+        // messages are not counted until skipped
+        //
+        Result check(const uchar* data, const int size, Frame* frame, int* frameSize);
+
+        // counts the checked frame of unknown message as skipped
+        void skip(const Frame& frame);
+
+        // drops the incomplete frame
+        inline void reset() { m_carrySize = 0; }
+
+        // number of valid frames
+        inline qint64 frames() const { return m_frames; }
+
+        // number of frames with invalid checksum
+        inline qint64 errors() const { return m_errors; }
+
+        // number of skipped frames of unknown messages
+        inline qint64 unknown() const { return m_unknown; }
+
+        //
+        // number of frames lost according to the sequence numbers of
+        // consecutive frames (of known or unknown messages) of the same
+        // system and component
+        //
+        inline qint64 lost() const { return m_lost; }
+
+        // number of parsed bytes
+        inline qint64 bytes() const { return m_bytes; }
+
+        void resetCounters();
+
+    private:
+
+        // parses the data without the carried frame
+        template <class Handler>
+        int scan(const uchar* data, const int size, Handler handler);
+
+        //
+        // returns true if the frame of the given size is followed by another
+        // frame or the end of the data, frames of unknown messages are not
+        // validated and are skipped only then, they are noise otherwise
+        //
+        static inline bool follows(const uchar* data, const int size, const int frameSize)
+        {
+            return frameSize >= size || data[ frameSize ] == 0xFE || data[ frameSize ] == 0xFD;
+        }
+
+        // counts frames lost between the previous frame and the given one
+        void track(const Frame& frame);
+
+        uchar m_carry[ MaxFrameSize ];  ///< frame split between data
+        int m_carrySize{};
+
+        quint8 m_system{};              ///< last frame system
+        quint8 m_component{};           ///< last frame component
+        quint8 m_sequence{};            ///< last frame sequence number
+        bool m_tracking{};              ///< any frame has been tracked
+
+        qint64 m_frames{};
+        qint64 m_errors{};
+        qint64 m_unknown{};
+        qint64 m_lost{};
+        qint64 m_bytes{};
+    };
+
+    // MAVLink checksum (CRC-16/MCRF4XX) of the data
+    static inline quint16 crc(const uchar* data, const int size, quint16 crc = 0xFFFF)
+    {
+        for ( int i = 0; i < size; ++i ) {
+            quint8 tmp = data[ i ] ^ static_cast<quint8>( crc & 0xFF );
+            tmp ^= static_cast<quint8>( tmp << 4 );
+            crc = static_cast<quint16>( ( crc >> 8 ) ^ ( tmp << 8 ) ^ ( tmp << 3 ) ^ ( tmp >> 4 ) );
+        }
+
+        return crc;
+    }
+
+    // checksum seed of the message definition, -1 for unknown messages
+    static int crcExtra(const quint32 message);
+
+    //
+    // sets sample values of the frame of ATTITUDE, VFR_HUD or
+    // GLOBAL_POSITION_INT message, returns false for other messages
+    //
+    static bool apply(const Frame& frame, TelemetrySample* sample);
+};
+
+template <class Handler>
+int Mavlink::Parser::parse(const uchar* data, const int size, Handler handler)
+{
+    int frames = 0;
+    int pos    = 0;
+
+    m_bytes += size;
+
+    // frame split between the previous data and these ones is completed in the carry buffer
+    while ( m_carrySize > 0 ) {
+        const int taken = qMin( size, static_cast<int>( MaxFrameSize ) - m_carrySize );
+        std::memcpy( m_carry + m_carrySize, data, taken );
+
+        Frame frame;
+        int frameSize = 0;
+
+        Result result = check( m_carry, m_carrySize + taken, &frame, &frameSize );
+
+        if ( result == Incomplete ) {
+            m_carrySize += taken;
+            return frames;
+        }
+
+        if ( result == Unknown && !follows( m_carry, m_carrySize + taken, frameSize ) ) result = Invalid;
+
+        if ( result == Invalid ) {
+            // carried bytes following the invalid start are scanned again
+            uchar carried[ MaxFrameSize ];
+            const int carriedSize = m_carrySize - 1;
+
+            std::memcpy( carried, m_carry + 1, carriedSize );
+            m_carrySize = 0;
+
+            frames += scan( carried, carriedSize, handler );
+            continue;
+        }
+
+        if ( result == Valid ) {
+            handler( frame );
+            frames++;
+        } else {
+            skip( frame );
+        }
+
+        pos = frameSize - m_carrySize;
+        m_carrySize = 0;
+    }
+
+    return frames + scan( data + pos, size - pos, handler );
+}
+
+template <class Handler>
+int Mavlink::Parser::scan(const uchar* data, const int size, Handler handler)
+{
+    int frames = 0;
+    int pos    = 0;
+
+    Frame frame;
+    int frameSize = 0;
+
+    while ( pos < size ) {
+        if ( data[ pos ] != 0xFE && data[ pos ] != 0xFD ) {
+            pos++;
+            continue;
+        }
+
+        const Result result = check( data + pos, size - pos, &frame, &frameSize );
+
+        if ( result == Incomplete ) {
+            m_carrySize = size - pos;
+            std::memcpy( m_carry, data + pos, m_carrySize );
+            break;
+        }
+
+        if ( result == Invalid || ( result == Unknown && !follows( data + pos, size - pos, frameSize ) ) ) {
+            pos++;
+            continue;
+        }
+
+        if ( result == Valid ) {
+            handler( frame );
+            frames++;
+        } else {
+            skip( frame );
+        }
+
+        pos += frameSize;
+    }
+
+    return frames;
+}
+
+}
+
+#endif
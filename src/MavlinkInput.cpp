@@ -0,0 +1,442 @@
+/***************************************************************************//**
+ * @file MavlinkInput.cpp
+ * @author  Marek M. Cel <marekcel@marekcel.pl>
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * This file is part of QFlightInstruments. You can redistribute and modify it
+ * under the terms of GNU General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.
+ * 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ *
+ * Further information about the GNU General Public License can also be found
+ * on the world wide web at http://www.gnu.org.
+ *
+ * ---
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include "MavlinkInput.hpp"
+
+#include <QHostAddress>
+#include <QMetaObject>
+#include <QSocketNotifier>
+#include <QUdpSocket>
+
+#ifdef Q_OS_UNIX
+#   include <cerrno>
+#   include <cstring>
+#   include <fcntl.h>
+#   include <termios.h>
+#   include <unistd.h>
+#endif
+
+namespace qfi {
+
+MavlinkInput::MavlinkInput(QObject* parent)
+    : QObject(parent)
+{
+    m_buffer.resize( BufferSize );
+
+    connect( &m_linkTimer, &QTimer::timeout, this, &MavlinkInput::checkLink );
+
+    m_clock.start();
+}
+
+MavlinkInput::~MavlinkInput()
+{
+    close();
+}
+
+bool MavlinkInput::open(const QString& source)
+{
+    close();
+    resetCounters();
+
+    m_sample = TelemetrySample();
+
+    if ( source.startsWith( "udp:" ) ) {
+        // address may contain colons (IPv6), port follows the last one
+        const QString address = source.mid( 4 );
+        const int colon = address.lastIndexOf( ':' );
+
+        bool valid = false;
+        const quint16 port = address.mid( colon + 1 ).toUShort( &valid );
+
+        if ( !valid ) {
+            m_errorString = "invalid UDP port";
+            return false;
+        }
+
+        m_socket = new QUdpSocket( this );
+
+        const bool bound = colon > 0
+                ? m_socket->bind( QHostAddress( address.left( colon ) ), port, QUdpSocket::ShareAddress | QUdpSocket::ReuseAddressHint )
+                : m_socket->bind( QHostAddress( QHostAddress::Any ), port, QUdpSocket::ShareAddress | QUdpSocket::ReuseAddressHint );
+
+        if ( !bound ) {
+            m_errorString = m_socket->errorString();
+            close();
+            return false;
+        }
+
+        connect( m_socket, &QUdpSocket::readyRead, this, &MavlinkInput::readDatagrams );
+    } else if ( source.startsWith( "serial:" ) ) {
+        QString device = source.mid( 7 );
+        int baud = 57600;
+
+        const int colon = device.lastIndexOf( ':' );
+
+        if ( colon > 0 ) {
+            baud   = device.mid( colon + 1 ).toInt();
+            device = device.left( colon );
+        }
+
+        if ( !openSerial( device, baud ) ) {
+            close();
+            return false;
+        }
+    } else {
+        m_file.setFileName( source );
+
+        if ( !m_file.open( QFile::ReadOnly ) ) {
+            m_errorString = m_file.errorString();
+            return false;
+        }
+
+        m_map = m_file.size() > 0 ? m_file.map( 0, m_file.size() ) : nullptr;
+
+        if ( !m_map ) {
+            m_errorString = "cannot map file";
+            close();
+            return false;
+        }
+
+        m_log = source.endsWith( ".tlog" );
+
+        // decoded from the event loop, so that the caller can connect signals first
+        QMetaObject::invokeMethod( this, "readFile", Qt::QueuedConnection );
+
+        return true;
+    }
+
+    m_linkTimer.start( qMax( m_timeout / 4, 10 ) );
+
+    return true;
+}
+
+void MavlinkInput::close()
+{
+    m_linkTimer.stop();
+
+    // may be closed from the slot of a signal of the socket or notifier
+    if ( m_socket ) {
+        m_socket->deleteLater();
+        m_socket = nullptr;
+    }
+
+    if ( m_notifier ) {
+        m_notifier->deleteLater();
+        m_notifier = nullptr;
+    }
+
+    if ( m_map ) {
+        m_file.unmap( m_map );
+        m_map = nullptr;
+    }
+
+    if ( m_file.isOpen() ) m_file.close();
+
+    m_parser.reset();
+
+    m_lastMessage = -1;
+    m_log         = false;
+
+    if ( !m_stale ) {
+        m_stale = true;
+        emit staleChanged( true );
+    }
+}
+
+int MavlinkInput::decode(const uchar* data, const int size)
+{
+    const qint64 time = m_clock.nsecsElapsed();
+
+    return m_parser.parse( data, size, [ this, time ]( const Mavlink::Frame& frame ) { handle( frame, time ); } );
+}
+
+int MavlinkInput::decodeLog(const uchar* data, const qint64 size)
+{
+    const int timeSize = sizeof(quint64);
+
+    int frames = 0;
+
+    qint64 pos   = 0;
+    qint64 first = -1;
+
+    Mavlink::Frame frame;
+    int frameSize = 0;
+
+    while ( pos + timeSize < size ) {
+        const int left = static_cast<int>( qMin( size - pos - timeSize, static_cast<qint64>( Mavlink::MaxFrameSize ) ) );
+
+        const Mavlink::Parser::Result result = m_parser.check( data + pos + timeSize, left, &frame, &frameSize );
+
+        // records of the log are searched byte by byte after an invalid one
+        if ( result == Mavlink::Parser::Invalid || result == Mavlink::Parser::Incomplete ) {
+            pos++;
+            continue;
+        }
+
+        if ( result == Mavlink::Parser::Valid ) {
+            const qint64 time = static_cast<qint64>( qFromBigEndian<quint64>( data + pos ) );
+
+            if ( first < 0 ) first = time;
+
+            handle( frame, 1000 * ( time - first ) );
+            frames++;
+        } else {
+            m_parser.skip( frame );
+        }
+
+        pos += timeSize + frameSize;
+    }
+
+    return frames;
+}
+
+void MavlinkInput::setTimeout(const int timeout)
+{
+    m_timeout = timeout > 0 ? timeout : 1;
+
+    if ( m_linkTimer.isActive() ) m_linkTimer.start( qMax( m_timeout / 4, 10 ) );
+}
+
+qint64 MavlinkInput::age() const
+{
+    return m_lastMessage < 0 ? -1 : m_clock.nsecsElapsed() - m_lastMessage;
+}
+
+qint64 MavlinkInput::count(const Mavlink::Message message) const
+{
+    const int index = type( message );
+    return index < 0 ? 0 : m_counters[ index ].count;
+}
+
+double MavlinkInput::rate(const Mavlink::Message message) const
+{
+    const int index = type( message );
+    return index < 0 ? 0.0 : m_counters[ index ].rate;
+}
+
+void MavlinkInput::resetCounters()
+{
+    for ( Counter& counter : m_counters ) counter = Counter();
+
+    // rate windows of live sources follow the clock
+    const qint64 now = m_clock.nsecsElapsed();
+    for ( Counter& counter : m_counters ) counter.windowStart = now;
+
+    m_parser.resetCounters();
+}
+
+void MavlinkInput::readDatagrams()
+{
+    while ( m_socket && m_socket->hasPendingDatagrams() ) {
+        const qint64 size = m_socket->readDatagram( reinterpret_cast<char*>( m_buffer.data() ),
+                                                    static_cast<qint64>( m_buffer.size() ) );
+
+        if ( size > 0 ) decode( m_buffer.data(), static_cast<int>( size ) );
+    }
+}
+
+void MavlinkInput::readDevice()
+{
+#ifdef Q_OS_UNIX
+    if ( !m_notifier ) return;
+
+    const ssize_t size = ::read( m_file.handle(), m_buffer.data(), m_buffer.size() );
+
+    if ( size > 0 ) {
+        decode( m_buffer.data(), static_cast<int>( size ) );
+    } else if ( size == 0 ) {
+        // hang up, e.g. unplugged adapter
+        m_notifier->setEnabled( false );
+    }
+#endif
+}
+
+void MavlinkInput::readFile()
+{
+    if ( !m_map ) return;
+
+    // log times restart the rate windows
+    if ( m_log ) {
+        for ( Counter& counter : m_counters ) counter.windowStart = 0;
+
+        decodeLog( m_map, m_file.size() );
+    } else {
+        // frames split between the chunks are completed by the parser
+        for ( qint64 pos = 0; pos < m_file.size(); pos += BufferSize ) {
+            decode( m_map + pos, static_cast<int>( qMin( m_file.size() - pos, static_cast<qint64>( BufferSize ) ) ) );
+        }
+    }
+
+    emit finished();
+}
+
+void MavlinkInput::checkLink()
+{
+    const qint64 now = m_clock.nsecsElapsed();
+
+    for ( Counter& counter : m_counters ) updateRate( &counter, now );
+
+    const bool stale = m_lastMessage < 0 || now - m_lastMessage > m_timeout * Q_INT64_C(1000000);
+
+    if ( stale != m_stale ) {
+        m_stale = stale;
+        emit staleChanged( stale );
+    }
+}
+
+int MavlinkInput::type(const quint32 message)
+{
+    switch ( message )
+    {
+    case Mavlink::Heartbeat:         return 0;
+    case Mavlink::Attitude:          return 1;
+    case Mavlink::GlobalPositionInt: return 2;
+    case Mavlink::VfrHud:            return 3;
+    }
+
+    return -1;
+}
+
+void MavlinkInput::handle(const Mavlink::Frame& frame, const qint64 time)
+{
+    if ( Mavlink::apply( frame, &m_sample ) ) m_sample.time = time;
+
+    const int index = type( frame.message );
+
+    if ( index >= 0 ) {
+        m_counters[ index ].count++;
+        updateRate( &m_counters[ index ], time );
+    }
+
+    m_lastMessage = m_clock.nsecsElapsed();
+
+    if ( m_stale ) {
+        m_stale = false;
+        emit staleChanged( false );
+    }
+
+    emit received( static_cast<int>( frame.message ) );
+}
+
+void MavlinkInput::updateRate(Counter* counter, const qint64 time)
+{
+    const qint64 window = time - counter->windowStart;
+
+    if ( window < Q_INT64_C(1000000000) ) return;
+
+    counter->rate        = 1.0e9 * ( counter->count - counter->windowCount ) / window;
+    counter->windowCount = counter->count;
+    counter->windowStart = time;
+}
+
+bool MavlinkInput::openSerial(const QString& device, const int baud)
+{
+#ifdef Q_OS_UNIX
+    speed_t speed = B57600;
+
+    switch ( baud )
+    {
+    case 9600:   speed = B9600;   break;
+    case 19200:  speed = B19200;  break;
+    case 38400:  speed = B38400;  break;
+    case 57600:  speed = B57600;  break;
+    case 115200: speed = B115200; break;
+    case 230400: speed = B230400; break;
+#   ifdef B460800
+    case 460800: speed = B460800; break;
+#   endif
+#   ifdef B921600
+    case 921600: speed = B921600; break;
+#   endif
+    default:
+        m_errorString = "unsupported baud rate";
+        return false;
+    }
+
+    const int fd = ::open( QFile::encodeName( device ).constData(), O_RDONLY | O_NOCTTY | O_NONBLOCK );
+
+    if ( fd < 0 ) {
+        m_errorString = QString::fromLocal8Bit( std::strerror( errno ) );
+        return false;
+    }
+
+    termios options;
+
+    // other devices (e.g. pipes) are read as they are
+    if ( ::tcgetattr( fd, &options ) == 0 ) {
+        ::cfmakeraw( &options );
+        ::cfsetispeed( &options, speed );
+        ::cfsetospeed( &options, speed );
+
+        options.c_cflag |= CLOCAL | CREAD;
+
+        ::tcsetattr( fd, TCSANOW, &options );
+    }
+
+    if ( !m_file.open( fd, QFile::ReadOnly, QFile::AutoCloseHandle ) ) {
+        ::close( fd );
+        m_errorString = m_file.errorString();
+        return false;
+    }
+
+    m_notifier = new QSocketNotifier( fd, QSocketNotifier::Read, this );
+
+    // activated() is overloaded since Qt 5.15
+    connect( m_notifier, SIGNAL(activated(int)), this, SLOT(readDevice()) );
+
+    return true;
+#else
+    Q_UNUSED( device )
+    Q_UNUSED( baud )
+
+    m_errorString = "serial lines are supported on POSIX systems only";
+    return false;
+#endif
+}
+
+}
@@ -0,0 +1,217 @@
+/***************************************************************************//**
+ * @file MavlinkInput.h
+ * @author  Marek M. Cel <marekcel@marekcel.pl>
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * This file is part of QFlightInstruments. You can redistribute and modify it
+ * under the terms of GNU General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.
+ * 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ *
+ * Further information about the GNU General Public License can also be found
+ * on the world wide web at http://www.gnu.org.
+ *
+ * ---
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef __qfi_MavlinkInput_H__
+#define __qfi_MavlinkInput_H__
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QObject>
+#include <QString>
+#include <QTimer>
+
+#include <vector>
+
+#include "Mavlink.hpp"
+#include "Telemetry.hpp"
+
+class QSocketNotifier;
+class QUdpSocket;
+
+namespace qfi {
+
+//---------------------------------------------------
+// Class: MavlinkInput
+// Description: Feeds instruments from an autopilot speaking MAVLink,
+// ATTITUDE, VFR_HUD and GLOBAL_POSITION_INT messages received over UDP,
+// serial line or read from a file are applied to the telemetry sample
+// (see TelemetrySample::pfd(), nav(), ...), frames are decoded in place
+// of the receive buffer allocated once
+//---------------------------------------------------
+class MavlinkInput : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    explicit MavlinkInput(QObject* parent = nullptr);
+    virtual ~MavlinkInput();
+
+    //
+    // opens the source, returns false on error
+    //   udp:<port>              listens on all interfaces, e.g. "udp:14550"
+    //   udp:<address>:<port>    listens on the given interface
+    //   serial:<device>[:<baud>] serial line (default 57600 baud), POSIX only
+    //   <file>                  recorded telemetry log (*.tlog) or raw stream,
+    //                           decoded as fast as possible, see finished()
+    //
+    bool open(const QString& source);
+
+    void close();
+
+    inline bool isOpen() const { return m_socket || m_notifier || m_map; }
+
+    //
+    // decodes stream of frames (e.g. of another transport), returns number
+    // of the applied messages
+    //
+    int decode(const uchar* data, const int size);
+
+    //
+    // decodes telemetry log, every frame preceded by its big endian time
+    // [us], the sample time is relative to the first frame, returns number
+    // of the applied messages
+    //
+    int decodeLog(const uchar* data, const qint64 size);
+
+    // state of all the received messages
+    inline const TelemetrySample& sample() const { return m_sample; }
+
+    //
+    // sets time [ms] without any valid message after which the link is
+    // stale (default 2000 ms)
+    //
+    void setTimeout(const int timeout);
+
+    inline int timeout() const { return m_timeout; }
+
+    // returns true if no valid message has been received within the timeout
+    inline bool isStale() const { return m_stale; }
+
+    // time since the last valid message [ns], -1 if none
+    qint64 age() const;
+
+    // number of received messages of the given type
+    qint64 count(const Mavlink::Message message) const;
+
+    // messages of the given type received per second over the last second
+    double rate(const Mavlink::Message message) const;
+
+    // frames, checksum errors, unknown and lost frames counters
+    inline const Mavlink::Parser& parser() const { return m_parser; }
+
+    // resets messages and parser counters
+    void resetCounters();
+
+    inline QString errorString() const { return m_errorString; }
+
+signals:
+
+    // emitted after the message has been applied to the sample
+    void received(int message);
+
+    // emitted when the link becomes stale or alive again
+    void staleChanged(bool stale);
+
+    // emitted after the whole file has been decoded
+    void finished();
+
+private slots:
+
+    void readDatagrams();
+    void readDevice();
+    void readFile();
+    void checkLink();
+
+private:
+
+    enum
+    {
+        BufferSize = 1 << 16,           ///< [B] receive buffer size
+        Types      = 4                  ///< number of counted messages
+    };
+
+    struct Counter
+    {
+        qint64 count{};
+        qint64 windowCount{};           ///< count at the beginning of the rate window
+        qint64 windowStart{};           ///< [ns]
+        double rate{};                  ///< [Hz]
+    };
+
+    // returns counter index of the message, -1 if not counted
+    static int type(const quint32 message);
+
+    // applies frame received at the given time [ns]
+    void handle(const Mavlink::Frame& frame, const qint64 time);
+
+    // updates rate of the counter at the given time [ns]
+    static void updateRate(Counter* counter, const qint64 time);
+
+    bool openSerial(const QString& device, const int baud);
+
+    QUdpSocket* m_socket{};
+    QSocketNotifier* m_notifier{};      ///< serial line notifier
+
+    QFile m_file;
+
+    uchar* m_map{};                     ///< mapped file
+
+    std::vector<uchar> m_buffer;        ///< receive buffer
+
+    Mavlink::Parser m_parser;
+
+    TelemetrySample m_sample;
+
+    QElapsedTimer m_clock;
+    QTimer m_linkTimer;
+
+    Counter m_counters[ Types ];
+
+    qint64 m_lastMessage{-1};           ///< [ns] clock time of the last valid message
+
+    int m_timeout{2000};                ///< [ms]
+
+    bool m_stale{true};
+    bool m_log{};                       ///< file is a telemetry log
+
+    QString m_errorString;
+};
+
+}
+
+#endif
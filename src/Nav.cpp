@@ -48,7 +48,7 @@
 
 #include "Nav.hpp"
 
-#include <QGraphicsSvgItem>
+#include "SvgItem.hpp"
 
 #include <iostream>
 #include <cmath>
@@ -56,6 +56,58 @@
 namespace qfi {
 
 Nav::Nav(QWidget* parent) : QGraphicsView(parent)
+{
+    m_renderer = new Renderer();
+    setScene( m_renderer->scene() );
+    Profile::apply( this, m_renderer->profile() );
+    m_renderer->resize( width(), height() );
+    centerOn( width() / 2.0f , height() / 2.0f );
+}
+
+Nav::~Nav()
+{
+    if ( m_renderer ) {
+        delete m_renderer;
+        m_renderer = nullptr;
+    }
+}
+
+void Nav::reinit()
+{
+    m_renderer->reinit();
+    centerOn( width() / 2.0f , height() / 2.0f );
+}
+
+void Nav::update()
+{
+    m_renderer->update();
+}
+
+void Nav::setRasterCache(const bool rasterCache)
+{
+    m_renderer->setRasterCache( rasterCache );
+}
+
+void Nav::setProfile(const Profile::Type profile)
+{
+    m_renderer->setProfile( profile );
+    Profile::apply( this, profile );
+}
+
+void Nav::resizeEvent(QResizeEvent* event)
+{
+    QGraphicsView::resizeEvent( event );
+    m_renderer->resize( width(), height() );
+    centerOn( width() / 2.0f , height() / 2.0f );
+}
+
+void Nav::paintEvent(QPaintEvent* event)
+{
+    Timings::Scope scope( &m_renderer->timings(), Timings::Paint );
+    QGraphicsView::paintEvent( event );
+}
+
+Nav::Renderer::Renderer()
 {
 #ifdef WIN32
     m_crsTextFont.setFamily( "Courier" );
@@ -89,152 +141,186 @@ Nav::Nav(QWidget* parent) : QGraphicsView(parent)
     m_dmeTextFont.setWeight( QFont::Bold );
 #endif
 
-    m_scene = new QGraphicsScene( this );
-    setScene( m_scene );
-    m_scene->clear();
-    init();
-}
+    m_crsTextAtlas.setFont( m_crsTextFont, m_crsTextColor, "CRS" );
+    m_hdgTextAtlas.setFont( m_hdgTextFont, m_hdgTextColor, "HDG" );
+    m_dmeTextAtlas.setFont( m_dmeTextFont, m_dmeTextColor, "NM" );
 
-Nav::~Nav()
-{
-    if (m_scene) {
-        m_scene->clear();
-        delete m_scene;
-        m_scene = nullptr;
-    }
+    m_width  = m_originalWidth;
+    m_height = m_originalHeight;
 
-    reset();
+    reinit();
 }
 
-void Nav::reinit()
+Nav::Renderer::~Renderer()
 {
-    if (m_scene) {
-        m_scene->clear();
-        init();
-    }
+    if ( m_scene ) m_scene->clear();
+
+    reset();
 }
 
-void Nav::update()
+void Nav::Renderer::setHeading(const float heading)
 {
-    updateView();
+    Timings::Scope scope( &m_timings, Timings::Update );
 
-    m_devBarDeltaX_old = m_devBarDeltaX_new;
-    m_devBarDeltaY_old = m_devBarDeltaY_new;
-}
+    const float heading_prev = m_heading;
 
-void Nav::setHeading(const float heading)
-{
     m_heading = heading;
 
     while ( m_heading <   0.0f ) m_heading += 360.0f;
     while ( m_heading > 360.0f ) m_heading -= 360.0f;
+
+    if ( m_heading != heading_prev ) m_dirty |= DirtyHeading;
 }
 
-void Nav::setHeadingBug(const float headingBug)
+void Nav::Renderer::setHeadingBug(const float headingBug)
 {
+    Timings::Scope scope( &m_timings, Timings::Update );
+
+    const float headingBug_prev = m_headingBug;
+
     m_headingBug = headingBug;
 
     while ( m_headingBug <   0.0f ) m_headingBug += 360.0f;
     while ( m_headingBug > 360.0f ) m_headingBug -= 360.0f;
+
+    if ( m_headingBug != headingBug_prev ) m_dirty |= DirtyHeadingBug;
 }
 
-void Nav::setCourse(const float course)
+void Nav::Renderer::setCourse(const float course)
 {
+    Timings::Scope scope( &m_timings, Timings::Update );
+
+    const float course_prev = m_course;
+
     m_course = course;
 
     while ( m_course <   0.0f ) m_course += 360.0f;
     while ( m_course > 360.0f ) m_course -= 360.0f;
+
+    if ( m_course != course_prev ) m_dirty |= DirtyCourse;
 }
 
-void Nav::setBearing(const float bearing, const bool visible)
+void Nav::Renderer::setBearing(const float bearing, const bool visible)
 {
+    Timings::Scope scope( &m_timings, Timings::Update );
+
+    const float bearing_prev        = m_bearing;
+    const bool  bearingVisible_prev = m_bearingVisible;
+
     m_bearing        = bearing;
     m_bearingVisible = visible;
 
     while ( m_bearing <   0.0f ) m_bearing += 360.0f;
     while ( m_bearing > 360.0f ) m_bearing -= 360.0f;
+
+    if ( m_bearing != bearing_prev || m_bearingVisible != bearingVisible_prev ) m_dirty |= DirtyBearing;
 }
 
-void Nav::setDeviation(const float deviation, const bool visible)
+void Nav::Renderer::setDeviation(const float deviation, const bool visible)
 {
+    Timings::Scope scope( &m_timings, Timings::Update );
+
+    const float deviation_prev        = m_deviation;
+    const bool  deviationVisible_prev = m_deviationVisible;
+
     m_deviation        = deviation;
     m_deviationVisible = visible;
 
     if ( m_deviation < -1.0f ) m_deviation = -1.0f;
     if ( m_deviation >  1.0f ) m_deviation =  1.0f;
+
+    if ( m_deviation != deviation_prev || m_deviationVisible != deviationVisible_prev ) m_dirty |= DirtyDeviation;
 }
 
-void Nav::setDistance(const float distance, const bool visible)
+void Nav::Renderer::setDistance(const float distance, const bool visible)
 {
+    Timings::Scope scope( &m_timings, Timings::Update );
+
+    const float distance_prev        = m_distance;
+    const bool  distanceVisible_prev = m_distanceVisible;
+
     m_distance        = fabs( distance );
     m_distanceVisible = visible;
+
+    if ( m_distance != distance_prev || m_distanceVisible != distanceVisible_prev ) m_dirty |= DirtyDistance;
 }
 
-void Nav::resizeEvent( QResizeEvent* event)
+void Nav::Renderer::setState(const NavState& state)
 {
-    QGraphicsView::resizeEvent( event );
-    reinit();
+    Timings::Scope scope( &m_timings, Timings::Update );
+
+    setHeading( state.heading );
+    setHeadingBug( state.headingBug );
+    setCourse( state.course );
+    setBearing( state.bearing, state.bearingVisible );
+    setDeviation( state.deviation, state.deviationVisible );
+    setDistance( state.distance, state.distanceVisible );
+}
+
+void Nav::Renderer::publish(const NavState& state)
+{
+    m_published.publish( state );
 }
 
-void Nav::init()
+void Nav::Renderer::init()
 {
-    m_scaleX = static_cast<float>(width())  / static_cast<float>(m_originalWidth);
-    m_scaleY = static_cast<float>(height()) / static_cast<float>(m_originalHeight);
+    m_scaleX = static_cast<float>(m_width)  / static_cast<float>(m_originalWidth);
+    m_scaleY = static_cast<float>(m_height) / static_cast<float>(m_originalHeight);
 
-    m_itemBack = new QGraphicsSvgItem( ":/qfi/images/nav/nav_back.svg" );
+    m_itemBack = new SvgItem( ":/qfi/images/nav/nav_back.svg" );
     m_itemBack->setCacheMode( QGraphicsItem::NoCache );
     m_itemBack->setZValue( m_backZ );
     m_itemBack->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
     m_scene->addItem( m_itemBack );
 
-    m_itemMask = new QGraphicsSvgItem( ":/qfi/images/nav/nav_mask.svg" );
+    m_itemMask = new SvgItem( ":/qfi/images/nav/nav_mask.svg" );
     m_itemMask->setCacheMode( QGraphicsItem::NoCache );
     m_itemMask->setZValue( m_maskZ );
     m_itemMask->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
     m_scene->addItem( m_itemMask );
 
-    m_itemMark = new QGraphicsSvgItem( ":/qfi/images/nav/nav_mark.svg" );
+    m_itemMark = new SvgItem( ":/qfi/images/nav/nav_mark.svg" );
     m_itemMark->setCacheMode( QGraphicsItem::NoCache );
     m_itemMark->setZValue( m_markZ );
     m_itemMark->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
     m_scene->addItem( m_itemMark );
 
-    m_itemBrgArrow = new QGraphicsSvgItem( ":/qfi/images/nav/nav_brg_arrow.svg" );
+    m_itemBrgArrow = new SvgItem( ":/qfi/images/nav/nav_brg_arrow.svg" );
     m_itemBrgArrow->setCacheMode( QGraphicsItem::NoCache );
     m_itemBrgArrow->setZValue( m_brgArrowZ );
     m_itemBrgArrow->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
     m_itemBrgArrow->setTransformOriginPoint( m_originalNavCtr );
     m_scene->addItem( m_itemBrgArrow );
 
-    m_itemCrsArrow = new QGraphicsSvgItem( ":/qfi/images/nav/nav_crs_arrow.svg" );
+    m_itemCrsArrow = new SvgItem( ":/qfi/images/nav/nav_crs_arrow.svg" );
     m_itemCrsArrow->setCacheMode( QGraphicsItem::NoCache );
     m_itemCrsArrow->setZValue( m_crsArrowZ );
     m_itemCrsArrow->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
     m_itemCrsArrow->setTransformOriginPoint( m_originalNavCtr );
     m_scene->addItem( m_itemCrsArrow );
 
-    m_itemDevBar = new QGraphicsSvgItem( ":/qfi/images/nav/nav_dev_bar.svg" );
+    m_itemDevBar = new SvgItem( ":/qfi/images/nav/nav_dev_bar.svg" );
     m_itemDevBar->setCacheMode( QGraphicsItem::NoCache );
     m_itemDevBar->setZValue( m_devBarZ );
     m_itemDevBar->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
     m_itemDevBar->setTransformOriginPoint( m_originalNavCtr );
     m_scene->addItem( m_itemDevBar );
 
-    m_itemDevScale = new QGraphicsSvgItem( ":/qfi/images/nav/nav_dev_scale.svg" );
+    m_itemDevScale = new SvgItem( ":/qfi/images/nav/nav_dev_scale.svg" );
     m_itemDevScale->setCacheMode( QGraphicsItem::NoCache );
     m_itemDevScale->setZValue( m_devScaleZ );
     m_itemDevScale->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
     m_itemDevScale->setTransformOriginPoint( m_originalNavCtr );
     m_scene->addItem( m_itemDevScale );
 
-    m_itemHdgBug = new QGraphicsSvgItem( ":/qfi/images/nav/nav_hdg_bug.svg" );
+    m_itemHdgBug = new SvgItem( ":/qfi/images/nav/nav_hdg_bug.svg" );
     m_itemHdgBug->setCacheMode( QGraphicsItem::NoCache );
     m_itemHdgBug->setZValue( m_hdgBugZ );
     m_itemHdgBug->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
     m_itemHdgBug->setTransformOriginPoint( m_originalNavCtr );
     m_scene->addItem( m_itemHdgBug );
 
-    m_itemHdgScale = new QGraphicsSvgItem( ":/qfi/images/nav/nav_hdg_scale.svg" );
+    m_itemHdgScale = new SvgItem( ":/qfi/images/nav/nav_hdg_scale.svg" );
     m_itemHdgScale->setCacheMode( QGraphicsItem::NoCache );
     m_itemHdgScale->setZValue( m_hdgScaleZ );
     m_itemHdgScale->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
@@ -243,40 +329,70 @@ void Nav::init()
 
     m_itemCrsText = 0;
 
-    m_itemCrsText = new QGraphicsTextItem( QString( "CRS 999" ) );
+    m_itemCrsText = new Readout( &m_crsTextAtlas, "CRS 999" );
     m_itemCrsText->setCacheMode( QGraphicsItem::NoCache );
     m_itemCrsText->setZValue( m_crsTextZ );
-    m_itemCrsText->setDefaultTextColor( m_crsTextColor );
-    m_itemCrsText->setFont( m_crsTextFont );
     m_itemCrsText->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
-    m_itemCrsText->moveBy( m_scaleX * ( m_originalCrsTextCtr.x() - m_itemCrsText->boundingRect().width()  / 2.0f ),
-                           m_scaleY * ( m_originalCrsTextCtr.y() - m_itemCrsText->boundingRect().height() / 2.0f ) );
+    m_originalCrsTextPos = m_originalCrsTextCtr - QPointF( m_itemCrsText->boundingRect().width()  / 2.0f,
+                                                           m_itemCrsText->boundingRect().height() / 2.0f );
+    m_itemCrsText->moveBy( m_scaleX * m_originalCrsTextPos.x(), m_scaleY * m_originalCrsTextPos.y() );
     m_scene->addItem( m_itemCrsText );
 
-    m_itemHdgText = new QGraphicsTextItem( QString( "HDG 999" ) );
+    m_itemHdgText = new Readout( &m_hdgTextAtlas, "HDG 999" );
     m_itemHdgText->setCacheMode( QGraphicsItem::NoCache );
     m_itemHdgText->setZValue( m_hdgTextZ );
-    m_itemHdgText->setDefaultTextColor( m_hdgTextColor );
-    m_itemHdgText->setFont( m_hdgTextFont );
     m_itemHdgText->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
-    m_itemHdgText->moveBy( m_scaleX * ( m_originalHdgTextCtr.x() - m_itemHdgText->boundingRect().width()  / 2.0f ),
-                           m_scaleY * ( m_originalHdgTextCtr.y() - m_itemHdgText->boundingRect().height() / 2.0f ) );
+    m_originalHdgTextPos = m_originalHdgTextCtr - QPointF( m_itemHdgText->boundingRect().width()  / 2.0f,
+                                                           m_itemHdgText->boundingRect().height() / 2.0f );
+    m_itemHdgText->moveBy( m_scaleX * m_originalHdgTextPos.x(), m_scaleY * m_originalHdgTextPos.y() );
     m_scene->addItem( m_itemHdgText );
 
-    m_itemDmeText = new QGraphicsTextItem( QString( "99.9 NM" ) );
+    m_itemDmeText = new Readout( &m_dmeTextAtlas, "99.9 NM" );
     m_itemDmeText->setCacheMode( QGraphicsItem::NoCache );
     m_itemDmeText->setZValue( m_dmeTextZ );
-    m_itemDmeText->setDefaultTextColor( m_dmeTextColor );
-    m_itemDmeText->setFont( m_dmeTextFont );
     m_itemDmeText->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
-    m_itemDmeText->moveBy( m_scaleX * ( m_originalDmeTextCtr.x() - m_itemDmeText->boundingRect().width()  / 2.0f ),
-                           m_scaleY * ( m_originalDmeTextCtr.y() - m_itemDmeText->boundingRect().height() / 2.0f ) );
+    m_originalDmeTextPos = m_originalDmeTextCtr - QPointF( m_itemDmeText->boundingRect().width()  / 2.0f,
+                                                           m_itemDmeText->boundingRect().height() / 2.0f );
+    m_itemDmeText->moveBy( m_scaleX * m_originalDmeTextPos.x(), m_scaleY * m_originalDmeTextPos.y() );
     m_scene->addItem( m_itemDmeText );
 
-    updateView();
+    SvgItem::setRasterCache( m_scene, m_rasterCache );
+
+    invalidate();
+    refresh();
+}
+
+void Nav::Renderer::rescale()
+{
+    m_scaleX = static_cast<float>(m_width)  / static_cast<float>(m_originalWidth);
+    m_scaleY = static_cast<float>(m_height) / static_cast<float>(m_originalHeight);
+
+    const QTransform scale = QTransform::fromScale( m_scaleX, m_scaleY );
+
+    m_itemBack->setTransform( scale );
+    m_itemMask->setTransform( scale );
+    m_itemMark->setTransform( scale );
+    m_itemBrgArrow->setTransform( scale );
+    m_itemCrsArrow->setTransform( scale );
+    m_itemDevBar->setTransform( scale );
+    m_itemDevScale->setTransform( scale );
+    m_itemHdgBug->setTransform( scale );
+    m_itemHdgScale->setTransform( scale );
+
+    m_itemCrsText->setTransform( scale );
+    m_itemHdgText->setTransform( scale );
+    m_itemDmeText->setTransform( scale );
+
+    // text items keep their layout, only their corner follows the scale
+    m_itemCrsText->setPos( m_scaleX * m_originalCrsTextPos.x(), m_scaleY * m_originalCrsTextPos.y() );
+    m_itemHdgText->setPos( m_scaleX * m_originalHdgTextPos.x(), m_scaleY * m_originalHdgTextPos.y() );
+    m_itemDmeText->setPos( m_scaleX * m_originalDmeTextPos.x(), m_scaleY * m_originalDmeTextPos.y() );
+
+    invalidate();
+    refresh();
 }
 
-void Nav::reset()
+void Nav::Renderer::reset()
 {
     m_itemBrgArrow = nullptr;
     m_itemCrsArrow = nullptr;
@@ -299,29 +415,65 @@ void Nav::reset()
     m_bearingVisible   = true;
     m_deviationVisible = true;
     m_distanceVisible  = true;
+}
 
-    m_devBarDeltaX_new = 0.0f;
-    m_devBarDeltaX_old = 0.0f;
-    m_devBarDeltaY_new = 0.0f;
-    m_devBarDeltaY_old = 0.0f;
+void Nav::Renderer::fetchPublished()
+{
+    NavState state;
+
+    if ( m_published.fetch( &state ) ) setState( state );
 }
 
-void Nav::updateView()
+void Nav::Renderer::updateView()
 {
-    m_scaleX = static_cast<float>(width())  / static_cast<float>(m_originalWidth);
-    m_scaleY = static_cast<float>(height()) / static_cast<float>(m_originalHeight);
+    m_scaleX = static_cast<float>(m_width)  / static_cast<float>(m_originalWidth);
+    m_scaleY = static_cast<float>(m_height) / static_cast<float>(m_originalHeight);
 
-    m_itemCrsArrow->setRotation( -m_heading + m_course );
-    m_itemHdgBug->setRotation( -m_heading + m_headingBug );
-    m_itemHdgScale->setRotation( -m_heading );
+    if ( m_dirty & ( DirtyHeading | DirtyCourse ) ) {
+        m_itemCrsArrow->setRotation( -m_heading + m_course );
+    }
 
-    if (m_bearingVisible) {
-        m_itemBrgArrow->setVisible( true );
-        m_itemBrgArrow->setRotation( -m_heading + m_bearing );
-    } else {
-        m_itemBrgArrow->setVisible( false );
+    if ( m_dirty & ( DirtyHeading | DirtyHeadingBug ) ) {
+        m_itemHdgBug->setRotation( -m_heading + m_headingBug );
+    }
+
+    if ( m_dirty & DirtyHeading ) {
+        m_itemHdgScale->setRotation( -m_heading );
+    }
+
+    if ( m_dirty & ( DirtyHeading | DirtyBearing ) ) {
+        if (m_bearingVisible) {
+            m_itemBrgArrow->setVisible( true );
+            m_itemBrgArrow->setRotation( -m_heading + m_bearing );
+        } else {
+            m_itemBrgArrow->setVisible( false );
+        }
+    }
+
+    if ( m_dirty & ( DirtyHeading | DirtyCourse | DirtyDeviation ) ) {
+        updateDeviation();
+    }
+
+    if ( m_dirty & DirtyCourse ) {
+        m_itemCrsText->setNumber( m_course     , 3, 0, '0', "CRS " );
+    }
+
+    if ( m_dirty & DirtyHeadingBug ) {
+        m_itemHdgText->setNumber( m_headingBug , 3, 0, '0', "HDG " );
+    }
+
+    if ( m_dirty & DirtyDistance ) {
+        if ( m_distanceVisible ) {
+            m_itemDmeText->setVisible( true );
+            m_itemDmeText->setNumber( m_distance, 5, 1, ' ', "", " NM" );
+        } else {
+            m_itemDmeText->setVisible( false );
+        }
     }
+}
 
+void Nav::Renderer::updateDeviation()
+{
     if ( m_deviationVisible ) {
         m_itemDevBar->setVisible( true );
         m_itemDevScale->setVisible( true );
@@ -340,31 +492,11 @@ void Nav::updateView()
 
         const float delta{static_cast<float>(m_originalPixPerDev * m_deviation)};
 
-        m_devBarDeltaX_new = m_scaleX * delta * cosAngle;
-        m_devBarDeltaY_new = m_scaleY * delta * sinAngle;
-
-        m_itemDevBar->moveBy( m_devBarDeltaX_new - m_devBarDeltaX_old, m_devBarDeltaY_new - m_devBarDeltaY_old );
+        m_itemDevBar->setPos( m_scaleX * delta * cosAngle, m_scaleY * delta * sinAngle );
     } else {
         m_itemDevBar->setVisible( false );
         m_itemDevScale->setVisible( false );
-
-        m_devBarDeltaX_new = m_devBarDeltaX_old;
-        m_devBarDeltaY_new = m_devBarDeltaY_old;
-    }
-
-    m_itemCrsText->setPlainText( QString("CRS %1").arg( m_course     , 3, 'f', 0, QChar('0') ) );
-    m_itemHdgText->setPlainText( QString("HDG %1").arg( m_headingBug , 3, 'f', 0, QChar('0') ) );
-
-    if ( m_distanceVisible ) {
-        m_itemDmeText->setVisible( true );
-        m_itemDmeText->setPlainText( QString("%1 NM").arg( m_distance, 5, 'f', 1, QChar(' ') ) );
-    } else {
-        m_itemDmeText->setVisible( false );
     }
-
-    m_scene->update();
-
-    centerOn( width() / 2.0f , height() / 2.0f );
 }
 
 }
@@ -50,6 +50,10 @@
 
 #include <QGraphicsView>
 
+#include "Instrument.hpp"
+#include "Readout.hpp"
+#include "TripleBuffer.hpp"
+
 class QWidget;
 class QResizeEvent;
 class QGraphicsScene;
@@ -57,6 +61,23 @@ class QGraphicsSvgItem;
 
 namespace qfi {
 
+//---------------------------------------------------
+// Struct: NavState
+// Description: Navigation Display state snapshot
+//---------------------------------------------------
+struct NavState
+{
+    float heading{};                    ///< [deg]
+    float headingBug{};                 ///< [deg]
+    float course{};                     ///< [deg]
+    float bearing{};                    ///< [deg]
+    bool bearingVisible{true};
+    float deviation{};                  ///< normalized (range from -1.0 to 1.0)
+    bool deviationVisible{true};
+    float distance{};                   ///< [NM]
+    bool distanceVisible{true};
+};
+
 //---------------------------------------------------
 // Class: Nav
 // Description: Navigation Display
@@ -66,6 +87,125 @@ class Nav : public QGraphicsView
     Q_OBJECT
 
 public:
+
+    //---------------------------------------------------
+    // Class: Nav::Renderer
+    // Description: Navigation Display headless renderer
+    //---------------------------------------------------
+    class Renderer : public Instrument
+    {
+    public:
+        Renderer();
+        virtual ~Renderer();
+
+        void setHeading(const float);
+        void setHeadingBug(const float);
+        void setCourse(const float);
+        void setBearing(const float bearing, const bool visible = false);
+        void setDeviation(const float deviation, const bool visible = false);
+        void setDistance(const float distance, const bool visible = false);
+
+        // sets all the values at once
+        void setState(const NavState& state);
+
+        //
+        // publishes state to be applied by the next update(), can be called
+        // from any single producer thread, never blocks nor allocates
+        //
+        void publish(const NavState& state);
+
+    protected:
+        void init();
+        void rescale();
+        void updateView();
+        void fetchPublished();
+
+    private:
+        enum
+        {
+            DirtyHeading    = 0x0001,
+            DirtyHeadingBug = 0x0002,
+            DirtyCourse     = 0x0004,
+            DirtyBearing    = 0x0008,
+            DirtyDeviation  = 0x0010,
+            DirtyDistance   = 0x0020
+        };
+
+        void reset();
+        void updateDeviation();
+
+        QGraphicsSvgItem* m_itemBack{};       ///< NAV background
+        QGraphicsSvgItem* m_itemMask{};       ///< NAV mask
+        QGraphicsSvgItem* m_itemMark{};
+
+        QGraphicsSvgItem* m_itemBrgArrow{};
+        QGraphicsSvgItem* m_itemCrsArrow{};
+        QGraphicsSvgItem* m_itemDevBar{};
+        QGraphicsSvgItem* m_itemDevScale{};
+        QGraphicsSvgItem* m_itemHdgBug{};
+        QGraphicsSvgItem* m_itemHdgScale{};
+
+        Readout* m_itemCrsText{};
+        Readout* m_itemHdgText{};
+        Readout* m_itemDmeText{};
+
+        QColor m_crsTextColor{  0, 255,   0};
+        QColor m_hdgTextColor{255,   0, 255};
+        QColor m_dmeTextColor{255, 255, 255};
+
+        QFont m_crsTextFont;
+        QFont m_hdgTextFont;
+        QFont m_dmeTextFont;
+
+        GlyphAtlas m_crsTextAtlas;
+        GlyphAtlas m_hdgTextAtlas;
+        GlyphAtlas m_dmeTextAtlas;
+
+        float m_heading{};                    ///< [deg]
+        float m_headingBug{};                 ///< [deg]
+        float m_course{};
+        float m_bearing{};
+        float m_deviation{};
+        float m_distance{};
+
+        bool m_bearingVisible{true};
+        bool m_deviationVisible{true};
+        bool m_distanceVisible{true};
+
+        TripleBuffer<NavState> m_published;
+
+        float m_scaleX{1.0f};
+        float m_scaleY{1.0f};
+
+        float m_originalPixPerDev{52.5f};
+
+        QPointF m_originalNavCtr{150.0f, 150.0f};
+
+        QPointF m_originalCrsTextCtr{ 50.0f,  25.0f};
+        QPointF m_originalCrsTextPos;       ///< readout top left corner, set on init
+        QPointF m_originalHdgTextCtr{250.0f,  25.0f};
+        QPointF m_originalHdgTextPos;       ///< readout top left corner, set on init
+        QPointF m_originalDmeTextCtr{250.0f, 275.0f};
+        QPointF m_originalDmeTextPos;       ///< readout top left corner, set on init
+
+        const int m_originalHeight{300};         ///< [px]
+        const int m_originalWidth{300};          ///< [px]
+
+        const int m_backZ{};
+        const int m_maskZ{100};
+        const int m_markZ{200};
+
+        const int m_brgArrowZ{60};
+        const int m_crsArrowZ{70};
+        const int m_crsTextZ{130};
+        const int m_devBarZ{50};
+        const int m_devScaleZ{10};
+        const int m_hdgBugZ{120};
+        const int m_hdgScaleZ{110};
+        const int m_hdgTextZ{130};
+        const int m_dmeTextZ{130};
+    };
+
     explicit Nav(QWidget* parent = nullptr);
     virtual ~Nav();
 
@@ -75,89 +215,66 @@ public:
     // refreshes (redraws) widget
     void update();
 
-    void setHeading(const float);
-    void setHeadingBug(const float);
-    void setCourse(const float);
-    void setBearing(const float bearing, const bool visible = false);
-    void setDeviation(const float deviation, const bool visible = false);
-    void setDistance(const float distance, const bool visible = false);
+    // enables/disables cached raster mode of the SVG layers
+    void setRasterCache(const bool);
+
+    // sets performance profile of the widget and its renderer
+    void setProfile(const Profile::Type profile);
+
+    // headless renderer of the widget, e.g. to be registered in RenderScheduler
+    inline Renderer* renderer() const { return m_renderer; }
+
+    // sets all the values at once
+    inline void setState(const NavState& state)
+    {
+        m_renderer->setState( state );
+    }
+
+    //
+    // publishes state to be applied by the next update(), can be called
+    // from any single producer thread, never blocks nor allocates
+    //
+    inline void publish(const NavState& state)
+    {
+        m_renderer->publish( state );
+    }
+
+    inline void setHeading(const float heading)
+    {
+        m_renderer->setHeading( heading );
+    }
+
+    inline void setHeadingBug(const float headingBug)
+    {
+        m_renderer->setHeadingBug( headingBug );
+    }
+
+    inline void setCourse(const float course)
+    {
+        m_renderer->setCourse( course );
+    }
+
+    inline void setBearing(const float bearing, const bool visible = false)
+    {
+        m_renderer->setBearing( bearing, visible );
+    }
+
+    inline void setDeviation(const float deviation, const bool visible = false)
+    {
+        m_renderer->setDeviation( deviation, visible );
+    }
+
+    inline void setDistance(const float distance, const bool visible = false)
+    {
+        m_renderer->setDistance( distance, visible );
+    }
 
 protected:
+    void paintEvent(QPaintEvent*);
     void resizeEvent(QResizeEvent*);
 
 private:
-    void init();
-    void reset();
-    void updateView();
-
-    QGraphicsScene* m_scene{};            ///< graphics scene
-
-    QGraphicsSvgItem* m_itemBack{};       ///< NAV background
-    QGraphicsSvgItem* m_itemMask{};       ///< NAV mask
-    QGraphicsSvgItem* m_itemMark{};
-
-    QGraphicsSvgItem* m_itemBrgArrow{};
-    QGraphicsSvgItem* m_itemCrsArrow{};
-    QGraphicsSvgItem* m_itemDevBar{};
-    QGraphicsSvgItem* m_itemDevScale{};
-    QGraphicsSvgItem* m_itemHdgBug{};
-    QGraphicsSvgItem* m_itemHdgScale{};
-
-    QGraphicsTextItem* m_itemCrsText{};
-    QGraphicsTextItem* m_itemHdgText{};
-    QGraphicsTextItem* m_itemDmeText{};
-
-    QColor m_crsTextColor{  0, 255,   0};
-    QColor m_hdgTextColor{255,   0, 255};
-    QColor m_dmeTextColor{255, 255, 255};
-
-    QFont m_crsTextFont;
-    QFont m_hdgTextFont;
-    QFont m_dmeTextFont;
-
-    float m_heading{};                    ///< [deg]
-    float m_headingBug{};                 ///< [deg]
-    float m_course{};
-    float m_bearing{};
-    float m_deviation{};
-    float m_distance{};
-
-    bool m_bearingVisible{true};
-    bool m_deviationVisible{true};
-    bool m_distanceVisible{true};
-
-    float m_devBarDeltaX_new{};
-    float m_devBarDeltaX_old{};
-    float m_devBarDeltaY_new{};
-    float m_devBarDeltaY_old{};
-
-    float m_scaleX{1.0f};
-    float m_scaleY{1.0f};
-
-    float m_originalPixPerDev{52.5f};
-
-    QPointF m_originalNavCtr{150.0f, 150.0f};
-
-    QPointF m_originalCrsTextCtr{ 50.0f,  25.0f};
-    QPointF m_originalHdgTextCtr{250.0f,  25.0f};
-    QPointF m_originalDmeTextCtr{250.0f, 275.0f};
-
-    const int m_originalHeight{300};         ///< [px]
-    const int m_originalWidth{300};          ///< [px]
-
-    const int m_backZ{};
-    const int m_maskZ{100};
-    const int m_markZ{200};
-
-    const int m_brgArrowZ{60};
-    const int m_crsArrowZ{70};
-    const int m_crsTextZ{130};
-    const int m_devBarZ{50};
-    const int m_devScaleZ{10};
-    const int m_hdgBugZ{120};
-    const int m_hdgScaleZ{110};
-    const int m_hdgTextZ{130};
-    const int m_dmeTextZ{130};
+    Renderer* m_renderer{};
 };
 
 }
@@ -0,0 +1,245 @@
+/***************************************************************************//**
+ * @file Panel.cpp
+ * @author  Marek M. Cel <marekcel@marekcel.pl>
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * This file is part of QFlightInstruments. You can redistribute and modify it
+ * under the terms of GNU General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.
+ * 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ *
+ * Further information about the GNU General Public License can also be found
+ * on the world wide web at http://www.gnu.org.
+ *
+ * ---
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include "Panel.hpp"
+
+#include "Instrument.hpp"
+
+#include <QGraphicsItem>
+#include <QGraphicsScene>
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
+
+#include <algorithm>
+
+namespace qfi {
+
+//---------------------------------------------------
+// Class: Panel::Item
+// Description: Panel scene item drawing the scene of a hosted instrument,
+// only the exposed part is drawn and the instrument scene changes are
+// forwarded as the item updates
+//---------------------------------------------------
+class Panel::Item : public QGraphicsItem
+{
+public:
+
+    enum { Type = UserType + 6 };
+
+    explicit Item(Instrument* instrument) :
+        m_instrument(instrument)
+    {
+        setFlag( ItemUsesExtendedStyleOption );
+        m_bounds = QRectF( 0.0, 0.0, m_instrument->width(), m_instrument->height() );
+    }
+
+    // to be called after the instrument has been resized
+    void resized()
+    {
+        const QRectF bounds( 0.0, 0.0, m_instrument->width(), m_instrument->height() );
+
+        if ( bounds != m_bounds ) {
+            prepareGeometryChange();
+            m_bounds = bounds;
+        }
+    }
+
+    QRectF boundingRect() const
+    {
+        return m_bounds;
+    }
+
+    int type() const
+    {
+        return Type;
+    }
+
+    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget*)
+    {
+        Timings::Scope scope( &m_instrument->timings(), Timings::Paint );
+
+        // item coordinates are the instrument scene coordinates
+        const QRectF exposed = option->exposedRect.intersected( m_bounds );
+
+        if ( !exposed.isEmpty() ) {
+            painter->save();
+            painter->setClipRect( exposed );
+            m_instrument->scene()->render( painter, exposed, exposed, Qt::IgnoreAspectRatio );
+            painter->restore();
+        }
+    }
+
+private:
+
+    Instrument* m_instrument{};
+
+    QRectF m_bounds;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+Panel::Panel(QWidget* parent) : QGraphicsView(parent)
+{
+    QGraphicsScene* panelScene = new QGraphicsScene( this );
+
+    // a handful of large items, index would not pay off
+    panelScene->setItemIndexMethod( QGraphicsScene::NoIndex );
+
+    setScene( panelScene );
+
+    Profile::apply( this, m_profile );
+
+    setHorizontalScrollBarPolicy( Qt::ScrollBarAlwaysOff );
+    setVerticalScrollBarPolicy( Qt::ScrollBarAlwaysOff );
+    setAlignment( Qt::AlignLeft | Qt::AlignTop );
+}
+
+Panel::~Panel() {}
+
+void Panel::add(Instrument* instrument)
+{
+    if ( !instrument || m_instruments.contains( instrument ) ) return;
+
+    Item* item = new Item( instrument );
+
+    m_instruments.push_back( instrument );
+    m_items.push_back( item );
+
+    scene()->addItem( item );
+
+    instrument->setProfile( m_profile );
+
+    // instrument scene has no view of its own, its changes are
+    // repainted as the damaged parts of the panel item
+    connect( instrument->scene(), &QGraphicsScene::changed, this,
+             [ item ]( const QList<QRectF>& rects )
+    {
+        for ( const QRectF& rect : rects ) item->update( rect );
+    } );
+
+    relayout();
+}
+
+void Panel::remove(Instrument* instrument)
+{
+    const int index = m_instruments.indexOf( instrument );
+
+    if ( index < 0 ) return;
+
+    disconnect( instrument->scene(), nullptr, this, nullptr );
+
+    delete m_items[ index ];
+
+    m_instruments.remove( index );
+    m_items.remove( index );
+
+    relayout();
+}
+
+void Panel::setColumns(const int columns)
+{
+    m_columns = columns > 0 ? columns : 1;
+    relayout();
+}
+
+void Panel::update()
+{
+    for ( Instrument* instrument : m_instruments ) instrument->update();
+}
+
+void Panel::setRasterCache(const bool rasterCache)
+{
+    for ( Instrument* instrument : m_instruments ) instrument->setRasterCache( rasterCache );
+}
+
+void Panel::setProfile(const Profile::Type profile)
+{
+    m_profile = profile;
+
+    Profile::apply( this, m_profile );
+
+    for ( Instrument* instrument : m_instruments ) instrument->setProfile( m_profile );
+}
+
+void Panel::resizeEvent(QResizeEvent* event)
+{
+    QGraphicsView::resizeEvent( event );
+    relayout();
+}
+
+void Panel::relayout()
+{
+    const int w = viewport()->width();
+    const int h = viewport()->height();
+
+    setSceneRect( 0.0, 0.0, w, h );
+
+    if ( m_instruments.isEmpty() ) return;
+
+    const int cols = std::min( m_columns, m_instruments.size() );
+    const int rows = ( m_instruments.size() + cols - 1 ) / cols;
+
+    const int cell = std::max( 1, std::min( w / cols, h / rows ) );
+
+    // grid is centered in the viewport
+    const int x0 = ( w - cols * cell ) / 2;
+    const int y0 = ( h - rows * cell ) / 2;
+
+    for ( int i = 0; i < m_instruments.size(); i++ ) {
+        Instrument* instrument = m_instruments[ i ];
+
+        if ( instrument->width() != cell || instrument->height() != cell ) {
+            instrument->resize( cell, cell );
+        }
+
+        m_items[ i ]->resized();
+        m_items[ i ]->setPos( x0 + ( i % cols ) * cell, y0 + ( i / cols ) * cell );
+    }
+}
+
+}
@@ -0,0 +1,125 @@
+/***************************************************************************//**
+ * @file Panel.h
+ * @author  Marek M. Cel <marekcel@marekcel.pl>
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * This file is part of QFlightInstruments. You can redistribute and modify it
+ * under the terms of GNU General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.
+ * 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ *
+ * Further information about the GNU General Public License can also be found
+ * on the world wide web at http://www.gnu.org.
+ *
+ * ---
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef __qfi_Panel_H__
+#define __qfi_Panel_H__
+
+#include <QGraphicsView>
+#include <QVector>
+
+#include "Profile.hpp"
+
+class QWidget;
+class QResizeEvent;
+
+namespace qfi {
+
+class Instrument;
+
+//---------------------------------------------------
+// Class: Panel
+// Description: Hosts any number of instruments in a single scene and
+// viewport, the instruments are laid out in a grid of square cells and
+// the whole panel is painted in a single paint pass
+//---------------------------------------------------
+class Panel : public QGraphicsView
+{
+    Q_OBJECT
+
+public:
+
+    explicit Panel(QWidget* parent = nullptr);
+    virtual ~Panel();
+
+    //
+    // adds instrument to the panel (next grid cell) and sets the panel
+    // profile to it, the instrument is not owned by the panel and has
+    // to outlive it or be removed first
+    //
+    void add(Instrument* instrument);
+
+    // removes instrument from the panel
+    void remove(Instrument* instrument);
+
+    // sets number of the grid columns (default 3)
+    void setColumns(const int columns);
+
+    inline int columns() const { return m_columns; }
+
+    // number of the hosted instruments
+    inline int count() const { return m_instruments.size(); }
+
+    // refreshes (redraws) all the hosted instruments
+    void update();
+
+    // enables/disables cached raster mode of the SVG layers of all the instruments
+    void setRasterCache(const bool);
+
+    // sets performance profile of the panel and all the hosted instruments
+    void setProfile(const Profile::Type profile);
+
+protected:
+
+    void resizeEvent(QResizeEvent* event);
+
+private:
+
+    class Item;
+
+    void relayout();
+
+    QVector<Instrument*> m_instruments;
+    QVector<Item*> m_items;
+
+    int m_columns{3};
+
+    Profile::Type m_profile{Profile::Quality};
+};
+
+}
+
+#endif
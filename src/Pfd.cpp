@@ -48,7 +48,7 @@
 
 #include "Pfd.hpp"
 
-#include <QGraphicsSvgItem>
+#include "SvgItem.hpp"
 
 #include <cmath>
 
@@ -60,9 +60,60 @@ namespace qfi {
 
 Pfd::Pfd(QWidget* parent) : QGraphicsView(parent)
 {
-    m_scene = new QGraphicsScene(this);
-    setScene(m_scene);
-    m_scene->clear();
+    m_renderer = new Renderer();
+    setScene( m_renderer->scene() );
+    Profile::apply( this, m_renderer->profile() );
+    m_renderer->resize( width(), height() );
+    centerOn( width() / 2.0f , height() / 2.0f );
+}
+
+Pfd::~Pfd()
+{
+    if ( m_renderer ) {
+        delete m_renderer;
+        m_renderer = nullptr;
+    }
+}
+
+void Pfd::reinit()
+{
+    m_renderer->reinit();
+    centerOn( width() / 2.0f , height() / 2.0f );
+}
+
+void Pfd::update()
+{
+    m_renderer->update();
+}
+
+void Pfd::setRasterCache(const bool rasterCache)
+{
+    m_renderer->setRasterCache( rasterCache );
+}
+
+void Pfd::setProfile(const Profile::Type profile)
+{
+    m_renderer->setProfile( profile );
+    Profile::apply( this, profile );
+}
+
+void Pfd::resizeEvent(QResizeEvent* event)
+{
+    QGraphicsView::resizeEvent(event);
+    m_renderer->resize( width(), height() );
+    centerOn( width() / 2.0f , height() / 2.0f );
+}
+
+void Pfd::paintEvent(QPaintEvent* event)
+{
+    Timings::Scope scope( &m_renderer->timings(), Timings::Paint );
+    QGraphicsView::paintEvent( event );
+}
+
+Pfd::Renderer::Renderer()
+{
+    m_width  = m_originalWidth;
+    m_height = m_originalHeight;
 
     m_adi = new ADI(m_scene);
     m_alt = new ALT(m_scene);
@@ -70,16 +121,12 @@ Pfd::Pfd(QWidget* parent) : QGraphicsView(parent)
     m_hsi = new HSI(m_scene);
     m_vsi = new VSI(m_scene);
 
-    init();
+    reinit();
 }
 
-Pfd::~Pfd()
+Pfd::Renderer::~Renderer()
 {
-    if ( m_scene ) {
-        m_scene->clear();
-        delete m_scene;
-        m_scene = nullptr;
-    }
+    if ( m_scene ) m_scene->clear();
 
     reset();
 
@@ -90,29 +137,167 @@ Pfd::~Pfd()
     if ( m_vsi ) { delete m_vsi; m_vsi = nullptr; }
 }
 
-void Pfd::reinit()
+void Pfd::Renderer::setRoll(const float roll)
 {
-    if (m_scene) {
-        m_scene->clear();
-        init();
-    }
+    Timings::Scope scope( &m_timings, Timings::Update );
+
+    m_adi->setRoll( roll );
+
+    if ( m_adi->isDirty() ) m_dirty |= DirtyADI;
 }
 
-void Pfd::update()
+void Pfd::Renderer::setPitch(const float pitch)
+{
+    Timings::Scope scope( &m_timings, Timings::Update );
+
+    m_adi->setPitch( pitch );
+
+    if ( m_adi->isDirty() ) m_dirty |= DirtyADI;
+}
+
+void Pfd::Renderer::setFlightPathMarker(const float aoa, const float sideslip, const bool visible)
 {
-    updateView();
+    Timings::Scope scope( &m_timings, Timings::Update );
+
+    m_adi->setFlightPathMarker( aoa, sideslip, visible );
+
+    if ( m_adi->isDirty() ) m_dirty |= DirtyADI;
 }
 
-void Pfd::resizeEvent(QResizeEvent* event)
+void Pfd::Renderer::setSlipSkid(const float slipSkid)
 {
-    QGraphicsView::resizeEvent(event);
-    reinit();
+    Timings::Scope scope( &m_timings, Timings::Update );
+
+    m_adi->setSlipSkid( slipSkid );
+
+    if ( m_adi->isDirty() ) m_dirty |= DirtyADI;
+}
+
+void Pfd::Renderer::setTurnRate(const float turnRate)
+{
+    Timings::Scope scope( &m_timings, Timings::Update );
+
+    m_adi->setTurnRate( turnRate );
+
+    if ( m_adi->isDirty() ) m_dirty |= DirtyADI;
 }
 
-void Pfd::init()
+void Pfd::Renderer::setBarH(const float barH, const bool visible)
 {
-    m_scaleX = static_cast<float>(width())  / static_cast<float>(m_originalWidth);
-    m_scaleY = static_cast<float>(height()) / static_cast<float>(m_originalHeight);
+    Timings::Scope scope( &m_timings, Timings::Update );
+
+    m_adi->setBarH( barH, visible );
+
+    if ( m_adi->isDirty() ) m_dirty |= DirtyADI;
+}
+
+void Pfd::Renderer::setBarV(const float barV, const bool visible)
+{
+    Timings::Scope scope( &m_timings, Timings::Update );
+
+    m_adi->setBarV( barV, visible );
+
+    if ( m_adi->isDirty() ) m_dirty |= DirtyADI;
+}
+
+void Pfd::Renderer::setDotH(const float dotH, const bool visible)
+{
+    Timings::Scope scope( &m_timings, Timings::Update );
+
+    m_adi->setDotH( dotH, visible );
+
+    if ( m_adi->isDirty() ) m_dirty |= DirtyADI;
+}
+
+void Pfd::Renderer::setDotV(const float dotV, const bool visible)
+{
+    Timings::Scope scope( &m_timings, Timings::Update );
+
+    m_adi->setDotV( dotV, visible );
+
+    if ( m_adi->isDirty() ) m_dirty |= DirtyADI;
+}
+
+void Pfd::Renderer::setAltitude(const float altitude)
+{
+    Timings::Scope scope( &m_timings, Timings::Update );
+
+    m_alt->setAltitude( altitude );
+
+    if ( m_alt->isDirty() ) m_dirty |= DirtyALT;
+}
+
+void Pfd::Renderer::setPressure(const float pressure, const PressureUnit pressureUnit)
+{
+    Timings::Scope scope( &m_timings, Timings::Update );
+
+    m_alt->setPressure( pressure, pressureUnit );
+
+    if ( m_alt->isDirty() ) m_dirty |= DirtyALT;
+}
+
+void Pfd::Renderer::setAirspeed(const float airspeed)
+{
+    Timings::Scope scope( &m_timings, Timings::Update );
+
+    m_asi->setAirspeed( airspeed );
+
+    if ( m_asi->isDirty() ) m_dirty |= DirtyASI;
+}
+
+void Pfd::Renderer::setMachNo(const float machNo)
+{
+    Timings::Scope scope( &m_timings, Timings::Update );
+
+    m_asi->setMachNo( machNo );
+
+    if ( m_asi->isDirty() ) m_dirty |= DirtyASI;
+}
+
+void Pfd::Renderer::setHeading(const float heading)
+{
+    Timings::Scope scope( &m_timings, Timings::Update );
+
+    m_hsi->setHeading( heading );
+
+    if ( m_hsi->isDirty() ) m_dirty |= DirtyHSI;
+}
+
+void Pfd::Renderer::setClimbRate(const float climbRate)
+{
+    Timings::Scope scope( &m_timings, Timings::Update );
+
+    m_vsi->setClimbRate( climbRate );
+
+    if ( m_vsi->isDirty() ) m_dirty |= DirtyVSI;
+}
+
+void Pfd::Renderer::setState(const PfdState& state)
+{
+    Timings::Scope scope( &m_timings, Timings::Update );
+
+    m_adi->setState( state );
+    m_alt->setState( state );
+    m_asi->setState( state );
+    m_hsi->setState( state );
+    m_vsi->setState( state );
+
+    if ( m_adi->isDirty() ) m_dirty |= DirtyADI;
+    if ( m_alt->isDirty() ) m_dirty |= DirtyALT;
+    if ( m_asi->isDirty() ) m_dirty |= DirtyASI;
+    if ( m_hsi->isDirty() ) m_dirty |= DirtyHSI;
+    if ( m_vsi->isDirty() ) m_dirty |= DirtyVSI;
+}
+
+void Pfd::Renderer::publish(const PfdState& state)
+{
+    m_published.publish( state );
+}
+
+void Pfd::Renderer::init()
+{
+    m_scaleX = static_cast<float>(m_width)  / static_cast<float>(m_originalWidth);
+    m_scaleY = static_cast<float>(m_height) / static_cast<float>(m_originalHeight);
 
     m_adi->init( m_scaleX, m_scaleY );
     m_alt->init( m_scaleX, m_scaleY );
@@ -120,45 +305,81 @@ void Pfd::init()
     m_hsi->init( m_scaleX, m_scaleY );
     m_vsi->init( m_scaleX, m_scaleY );
 
-    m_itemBack = new QGraphicsSvgItem( ":/qfi/images/pfd/pfd_back.svg" );
+    m_itemBack = new SvgItem( ":/qfi/images/pfd/pfd_back.svg" );
     m_itemBack->setCacheMode( QGraphicsItem::NoCache );
     m_itemBack->setZValue( m_backZ );
     m_itemBack->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
     m_scene->addItem( m_itemBack );
 
-    m_itemMask = new QGraphicsSvgItem( ":/qfi/images/pfd/pfd_mask.svg" );
+    m_itemMask = new SvgItem( ":/qfi/images/pfd/pfd_mask.svg" );
     m_itemMask->setCacheMode( QGraphicsItem::NoCache );
     m_itemMask->setZValue( m_maskZ );
     m_itemMask->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
     m_scene->addItem( m_itemMask );
 
-    centerOn( width() / 2.0f , height() / 2.0f );
+    SvgItem::setRasterCache( m_scene, m_rasterCache );
 
-    updateView();
+    invalidate();
+    refresh();
 }
 
-void Pfd::reset()
+void Pfd::Renderer::rescale()
+{
+    m_scaleX = static_cast<float>(m_width)  / static_cast<float>(m_originalWidth);
+    m_scaleY = static_cast<float>(m_height) / static_cast<float>(m_originalHeight);
+
+    m_adi->rescale( m_scaleX, m_scaleY );
+    m_alt->rescale( m_scaleX, m_scaleY );
+    m_asi->rescale( m_scaleX, m_scaleY );
+    m_hsi->rescale( m_scaleX, m_scaleY );
+    m_vsi->rescale( m_scaleX, m_scaleY );
+
+    m_itemBack->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ) );
+    m_itemMask->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ) );
+
+    invalidate();
+    refresh();
+}
+
+void Pfd::Renderer::reset()
 {
     m_itemBack = nullptr;
     m_itemMask = nullptr;
 }
 
-void Pfd::updateView()
+void Pfd::Renderer::fetchPublished()
 {
-    m_scaleX = static_cast<float>(width())  / static_cast<float>(m_originalWidth);
-    m_scaleY = static_cast<float>(height()) / static_cast<float>(m_originalHeight);
+    PfdState state;
 
-    m_adi->update( m_scaleX, m_scaleY );
-    m_alt->update( m_scaleX, m_scaleY );
-    m_asi->update( m_scaleX, m_scaleY );
-    m_hsi->update( m_scaleX, m_scaleY );
-    m_vsi->update( m_scaleX, m_scaleY );
+    if ( m_published.fetch( &state ) ) setState( state );
+}
 
-    m_scene->update();
+void Pfd::Renderer::updateView()
+{
+    m_scaleX = static_cast<float>(m_width)  / static_cast<float>(m_originalWidth);
+    m_scaleY = static_cast<float>(m_height) / static_cast<float>(m_originalHeight);
+
+    if ( m_dirty & DirtyADI ) m_adi->update( m_scaleX, m_scaleY );
+    if ( m_dirty & DirtyALT ) m_alt->update( m_scaleX, m_scaleY );
+    if ( m_dirty & DirtyASI ) m_asi->update( m_scaleX, m_scaleY );
+    if ( m_dirty & DirtyHSI ) m_hsi->update( m_scaleX, m_scaleY );
+    if ( m_dirty & DirtyVSI ) m_vsi->update( m_scaleX, m_scaleY );
 }
 
 Pfd::ADI::ADI(QGraphicsScene* scene) : m_scene(scene)
 {
+#   ifdef WIN32
+    m_labelsFont.setFamily( "Arial" );
+    m_labelsFont.setPointSizeF( 6.0f );
+    m_labelsFont.setStretch( QFont::Condensed );
+    m_labelsFont.setWeight( QFont::Bold );
+#   else
+    m_labelsFont.setFamily( "Arial" );
+    m_labelsFont.setPointSizeF( 7.0f );
+    m_labelsFont.setStretch( QFont::Condensed );
+    m_labelsFont.setWeight( QFont::Bold );
+#   endif
+
     reset();
 }
 
@@ -169,23 +390,16 @@ void Pfd::ADI::init(const float scaleX, const float scaleY)
 
     reset();
 
-    m_itemBack = new QGraphicsSvgItem( ":/qfi/images/pfd/pfd_adi_back.svg" );
-    m_itemBack->setCacheMode( QGraphicsItem::NoCache );
-    m_itemBack->setZValue( m_backZ );
-    m_itemBack->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
-    m_itemBack->setTransformOriginPoint( m_originalAdiCtr - m_originalBackPos );
-    m_itemBack->moveBy( m_scaleX * m_originalBackPos.x(), m_scaleY * m_originalBackPos.y() );
-    m_scene->addItem( m_itemBack );
-
-    m_itemLadd = new QGraphicsSvgItem( ":/qfi/images/pfd/pfd_adi_ladd.svg" );
+    m_itemLadd = new Ladder( m_originalWindow, m_originalAdiCtr, m_originalPixPerDeg );
+    m_itemLadd->setBackground( m_skyColor, m_groundColor );
+    m_itemLadd->setLadder( m_ladderColor, m_labelsFont );
+    m_itemLadd->setHorizonLimit( m_horizonLimit );
     m_itemLadd->setCacheMode( QGraphicsItem::NoCache );
     m_itemLadd->setZValue( m_laddZ );
     m_itemLadd->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
-    m_itemLadd->setTransformOriginPoint( m_originalAdiCtr - m_originalLaddPos );
-    m_itemLadd->moveBy( m_scaleX * m_originalLaddPos.x(), m_scaleY * m_originalLaddPos.y() );
     m_scene->addItem( m_itemLadd );
 
-    m_itemRoll = new QGraphicsSvgItem( ":/qfi/images/pfd/pfd_adi_roll.svg" );
+    m_itemRoll = new SvgItem( ":/qfi/images/pfd/pfd_adi_roll.svg" );
     m_itemRoll->setCacheMode( QGraphicsItem::NoCache );
     m_itemRoll->setZValue( m_rollZ );
     m_itemRoll->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
@@ -193,7 +407,7 @@ void Pfd::ADI::init(const float scaleX, const float scaleY)
     m_itemRoll->moveBy( m_scaleX * m_originalRollPos.x(), m_scaleY * m_originalRollPos.y() );
     m_scene->addItem( m_itemRoll );
 
-    m_itemSlip = new QGraphicsSvgItem( ":/qfi/images/pfd/pfd_adi_slip.svg" );
+    m_itemSlip = new SvgItem( ":/qfi/images/pfd/pfd_adi_slip.svg" );
     m_itemSlip->setCacheMode( QGraphicsItem::NoCache );
     m_itemSlip->setZValue( m_slipZ );
     m_itemSlip->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
@@ -201,70 +415,70 @@ void Pfd::ADI::init(const float scaleX, const float scaleY)
     m_itemSlip->moveBy( m_scaleX * m_originalSlipPos.x(), m_scaleY * m_originalSlipPos.y() );
     m_scene->addItem( m_itemSlip );
 
-    m_itemTurn = new QGraphicsSvgItem( ":/qfi/images/pfd/pfd_adi_turn.svg" );
+    m_itemTurn = new SvgItem( ":/qfi/images/pfd/pfd_adi_turn.svg" );
     m_itemTurn->setCacheMode( QGraphicsItem::NoCache );
     m_itemTurn->setZValue( m_turnZ );
     m_itemTurn->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
     m_itemTurn->moveBy( m_scaleX * m_originalTurnPos.x(), m_scaleY * m_originalTurnPos.y() );
     m_scene->addItem( m_itemTurn );
 
-    m_itemPath = new QGraphicsSvgItem( ":/qfi/images/pfd/pfd_adi_path.svg" );
+    m_itemPath = new SvgItem( ":/qfi/images/pfd/pfd_adi_path.svg" );
     m_itemPath->setCacheMode( QGraphicsItem::NoCache );
     m_itemPath->setZValue( m_pathZ );
     m_itemPath->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
     m_itemPath->moveBy( m_scaleX * m_originalPathPos.x(), m_scaleY * m_originalPathPos.y() );
     m_scene->addItem( m_itemPath );
 
-    m_itemMark = new QGraphicsSvgItem( ":/qfi/images/pfd/pfd_adi_mark.svg" );
+    m_itemMark = new SvgItem( ":/qfi/images/pfd/pfd_adi_mark.svg" );
     m_itemMark->setCacheMode( QGraphicsItem::NoCache );
     m_itemMark->setZValue( m_pathZ );
     m_itemMark->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
     m_itemMark->moveBy( m_scaleX * m_originalPathPos.x(), m_scaleY * m_originalPathPos.y() );
     m_scene->addItem( m_itemMark );
 
-    m_itemBarH = new QGraphicsSvgItem( ":/qfi/images/pfd/pfd_adi_barh.svg" );
+    m_itemBarH = new SvgItem( ":/qfi/images/pfd/pfd_adi_barh.svg" );
     m_itemBarH->setCacheMode( QGraphicsItem::NoCache );
     m_itemBarH->setZValue( m_barsZ );
     m_itemBarH->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
     m_itemBarH->moveBy( m_scaleX * m_originalBarHPos.x(), m_scaleY * m_originalBarHPos.y() );
     m_scene->addItem( m_itemBarH );
 
-    m_itemBarV = new QGraphicsSvgItem( ":/qfi/images/pfd/pfd_adi_barv.svg" );
+    m_itemBarV = new SvgItem( ":/qfi/images/pfd/pfd_adi_barv.svg" );
     m_itemBarV->setCacheMode( QGraphicsItem::NoCache );
     m_itemBarV->setZValue( m_barsZ );
     m_itemBarV->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
     m_itemBarV->moveBy( m_scaleX * m_originalBarVPos.x(), m_scaleY * m_originalBarVPos.y() );
     m_scene->addItem( m_itemBarV );
 
-    m_itemDotH = new QGraphicsSvgItem( ":/qfi/images/pfd/pfd_adi_doth.svg" );
+    m_itemDotH = new SvgItem( ":/qfi/images/pfd/pfd_adi_doth.svg" );
     m_itemDotH->setCacheMode( QGraphicsItem::NoCache );
     m_itemDotH->setZValue( m_dotsZ );
     m_itemDotH->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
     m_itemDotH->moveBy( m_scaleX * m_originalDotHPos.x(), m_scaleY * m_originalDotHPos.y() );
     m_scene->addItem( m_itemDotH );
 
-    m_itemDotV = new QGraphicsSvgItem( ":/qfi/images/pfd/pfd_adi_dotv.svg" );
+    m_itemDotV = new SvgItem( ":/qfi/images/pfd/pfd_adi_dotv.svg" );
     m_itemDotV->setCacheMode( QGraphicsItem::NoCache );
     m_itemDotV->setZValue( m_dotsZ );
     m_itemDotV->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
     m_itemDotV->moveBy( m_scaleX * m_originalDotVPos.x(), m_scaleY * m_originalDotVPos.y() );
     m_scene->addItem( m_itemDotV );
 
-    m_itemScaleH = new QGraphicsSvgItem( ":/qfi/images/pfd/pfd_adi_scaleh.svg" );
+    m_itemScaleH = new SvgItem( ":/qfi/images/pfd/pfd_adi_scaleh.svg" );
     m_itemScaleH->setCacheMode( QGraphicsItem::NoCache );
     m_itemScaleH->setZValue( m_scalesZ );
     m_itemScaleH->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
     m_itemScaleH->moveBy( m_scaleX * m_originalScaleHPos.x(), m_scaleY * m_originalScaleHPos.y() );
     m_scene->addItem( m_itemScaleH );
 
-    m_itemScaleV = new QGraphicsSvgItem( ":/qfi/images/pfd/pfd_adi_scalev.svg" );
+    m_itemScaleV = new SvgItem( ":/qfi/images/pfd/pfd_adi_scalev.svg" );
     m_itemScaleV->setCacheMode( QGraphicsItem::NoCache );
     m_itemScaleV->setZValue( m_scalesZ );
     m_itemScaleV->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
     m_itemScaleV->moveBy( m_scaleX * m_originalScaleVPos.x(), m_scaleY * m_originalScaleVPos.y() );
     m_scene->addItem( m_itemScaleV );
 
-    m_itemMask = new QGraphicsSvgItem( ":/qfi/images/pfd/pfd_adi_mask.svg" );
+    m_itemMask = new SvgItem( ":/qfi/images/pfd/pfd_adi_mask.svg" );
     m_itemMask->setCacheMode( QGraphicsItem::NoCache );
     m_itemMask->setZValue( m_maskZ );
     m_itemMask->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
@@ -273,62 +487,106 @@ void Pfd::ADI::init(const float scaleX, const float scaleY)
     update( scaleX, scaleY );
 }
 
-void Pfd::ADI::update(const float scaleX, const float scaleY)
+void Pfd::ADI::rescale(const float scaleX, const float scaleY)
 {
     m_scaleX = scaleX;
     m_scaleY = scaleY;
 
-    const float delta{static_cast<float>(m_originalPixPerDeg * m_pitch)};
+    const QTransform scale = QTransform::fromScale( m_scaleX, m_scaleY );
+
+    m_itemLadd->setTransform( scale );
+
+    m_itemRoll->setTransform( scale );
+    m_itemRoll->setPos( m_scaleX * m_originalRollPos.x(), m_scaleY * m_originalRollPos.y() );
+
+    m_itemSlip->setTransform( scale );
+    m_itemSlip->setPos( m_scaleX * m_originalSlipPos.x(), m_scaleY * m_originalSlipPos.y() );
+
+    m_itemTurn->setTransform( scale );
+    m_itemTurn->setPos( m_scaleX * m_originalTurnPos.x(), m_scaleY * m_originalTurnPos.y() );
+
+    m_itemPath->setTransform( scale );
+    m_itemPath->setPos( m_scaleX * m_originalPathPos.x(), m_scaleY * m_originalPathPos.y() );
+
+    m_itemMark->setTransform( scale );
+    m_itemMark->setPos( m_scaleX * m_originalPathPos.x(), m_scaleY * m_originalPathPos.y() );
+
+    m_itemBarH->setTransform( scale );
+    m_itemBarH->setPos( m_scaleX * m_originalBarHPos.x(), m_scaleY * m_originalBarHPos.y() );
+
+    m_itemBarV->setTransform( scale );
+    m_itemBarV->setPos( m_scaleX * m_originalBarVPos.x(), m_scaleY * m_originalBarVPos.y() );
+
+    m_itemDotH->setTransform( scale );
+    m_itemDotH->setPos( m_scaleX * m_originalDotHPos.x(), m_scaleY * m_originalDotHPos.y() );
+
+    m_itemDotV->setTransform( scale );
+    m_itemDotV->setPos( m_scaleX * m_originalDotVPos.x(), m_scaleY * m_originalDotVPos.y() );
+
+    m_itemScaleH->setTransform( scale );
+    m_itemScaleH->setPos( m_scaleX * m_originalScaleHPos.x(), m_scaleY * m_originalScaleHPos.y() );
+
+    m_itemScaleV->setTransform( scale );
+    m_itemScaleV->setPos( m_scaleX * m_originalScaleVPos.x(), m_scaleY * m_originalScaleVPos.y() );
+
+    m_itemMask->setTransform( scale );
+
+    // state is reapplied at the new scale by the next update
+    m_dirty = Instrument::DirtyAll;
+}
+
+void Pfd::ADI::update(const float scaleX, const float scaleY)
+{
+    m_scaleX = scaleX;
+    m_scaleY = scaleY;
 
     const float roll_rad{static_cast<float>(M_PI * m_roll / 180.0f)};
 
     const float sinRoll{static_cast<float>(std::sin(roll_rad))};
     const float cosRoll{static_cast<float>(std::cos(roll_rad))};
 
-    updateLadd( delta, sinRoll, cosRoll );
-    updateLaddBack( delta, sinRoll, cosRoll );
-    updateRoll();
-    updateSlipSkid( sinRoll, cosRoll );
-    updateTurnRate();
-    updateBars();
-    updateDots();
-    updateFlightPath();
-
-    m_laddDeltaX_old     = m_laddDeltaX_new;
-    m_laddDeltaY_old     = m_laddDeltaY_new;
-    m_laddBackDeltaX_old = m_laddBackDeltaX_new;
-    m_laddBackDeltaY_old = m_laddBackDeltaY_new;
-    m_slipDeltaX_old     = m_slipDeltaX_new;
-    m_slipDeltaY_old     = m_slipDeltaY_new;
-    m_turnDeltaX_old     = m_turnDeltaX_new;
-    m_pathDeltaX_old     = m_pathDeltaX_new;
-    m_pathDeltaY_old     = m_pathDeltaY_new;
-    m_markDeltaX_old     = m_markDeltaX_new;
-    m_markDeltaY_old     = m_markDeltaY_new;
-    m_barHDeltaX_old     = m_barHDeltaX_new;
-    m_barVDeltaY_old     = m_barVDeltaY_new;
-    m_dotHDeltaX_old     = m_dotHDeltaX_new;
-    m_dotVDeltaY_old     = m_dotVDeltaY_new;
+    if ( m_dirty & ( DirtyRoll | DirtyPitch )    ) updateLadd();
+    if ( m_dirty & DirtyRoll                     ) updateRoll();
+    if ( m_dirty & ( DirtyRoll | DirtySlipSkid ) ) updateSlipSkid( sinRoll, cosRoll );
+    if ( m_dirty & DirtyTurnRate                 ) updateTurnRate();
+    if ( m_dirty & DirtyBars                     ) updateBars();
+    if ( m_dirty & DirtyDots                     ) updateDots();
+    if ( m_dirty & DirtyFlightPath               ) updateFlightPath();
+
+    m_dirty = Instrument::DirtyNone;
 }
 
 void Pfd::ADI::setRoll(const float roll)
 {
+    const float roll_prev = m_roll;
+
     m_roll = roll;
 
     if      ( m_roll < -180.0f ) m_roll = -180.0f;
     else if ( m_roll >  180.0f ) m_roll =  180.0f;
+
+    if ( m_roll != roll_prev ) m_dirty |= DirtyRoll;
 }
 
 void Pfd::ADI::setPitch(const float pitch)
 {
+    const float pitch_prev = m_pitch;
+
     m_pitch = pitch;
 
     if      ( m_pitch < -90.0f ) m_pitch = -90.0f;
     else if ( m_pitch >  90.0f ) m_pitch =  90.0f;
+
+    if ( m_pitch != pitch_prev ) m_dirty |= DirtyPitch;
 }
 
 void Pfd::ADI::setFlightPathMarker(const float aoa, const float sideslip, const bool visible)
 {
+    const float angleOfAttack_prev = m_angleOfAttack;
+    const float sideslipAngle_prev = m_sideslipAngle;
+    const bool  pathValid_prev     = m_pathValid;
+    const bool  pathVisible_prev   = m_pathVisible;
+
     m_angleOfAttack = aoa;
     m_sideslipAngle = sideslip;
 
@@ -351,67 +609,113 @@ void Pfd::ADI::setFlightPathMarker(const float aoa, const float sideslip, const
     }
 
     m_pathVisible = visible;
+
+    if ( m_angleOfAttack != angleOfAttack_prev || m_sideslipAngle != sideslipAngle_prev
+      || m_pathValid != pathValid_prev || m_pathVisible != pathVisible_prev )
+    {
+        m_dirty |= DirtyFlightPath;
+    }
 }
 
 void Pfd::ADI::setSlipSkid(const float slipSkid)
 {
+    const float slipSkid_prev = m_slipSkid;
+
     m_slipSkid = slipSkid;
 
     if      ( m_slipSkid < -1.0f ) m_slipSkid = -1.0f;
     else if ( m_slipSkid >  1.0f ) m_slipSkid =  1.0f;
+
+    if ( m_slipSkid != slipSkid_prev ) m_dirty |= DirtySlipSkid;
 }
 
 void Pfd::ADI::setTurnRate(const float turnRate)
 {
+    const float turnRate_prev = m_turnRate;
+
     m_turnRate = turnRate;
 
     if      ( m_turnRate < -1.0f ) m_turnRate = -1.0f;
     else if ( m_turnRate >  1.0f ) m_turnRate =  1.0f;
+
+    if ( m_turnRate != turnRate_prev ) m_dirty |= DirtyTurnRate;
 }
 
 void Pfd::ADI::setBarH(const float barH, const bool visible )
 {
+    const float barH_prev        = m_barH;
+    const bool  barHVisible_prev = m_barHVisible;
+
     m_barH = barH;
 
     if      ( m_barH < -1.0f ) m_barH = -1.0f;
     else if ( m_barH >  1.0f ) m_barH =  1.0f;
 
     m_barHVisible = visible;
+
+    if ( m_barH != barH_prev || m_barHVisible != barHVisible_prev ) m_dirty |= DirtyBars;
 }
 
 void Pfd::ADI::setBarV(const float barV, const bool visible )
 {
+    const float barV_prev        = m_barV;
+    const bool  barVVisible_prev = m_barVVisible;
+
     m_barV = barV;
 
     if      ( m_barV < -1.0f ) m_barV = -1.0f;
     else if ( m_barV >  1.0f ) m_barV =  1.0f;
 
     m_barVVisible = visible;
+
+    if ( m_barV != barV_prev || m_barVVisible != barVVisible_prev ) m_dirty |= DirtyBars;
 }
 
 void Pfd::ADI::setDotH(const float dotH, const bool visible )
 {
+    const float dotH_prev        = m_dotH;
+    const bool  dotHVisible_prev = m_dotHVisible;
+
     m_dotH = dotH;
 
     if      ( m_dotH < -1.0f ) m_dotH = -1.0f;
     else if ( m_dotH >  1.0f ) m_dotH =  1.0f;
 
     m_dotHVisible = visible;
+
+    if ( m_dotH != dotH_prev || m_dotHVisible != dotHVisible_prev ) m_dirty |= DirtyDots;
 }
 
 void Pfd::ADI::setDotV(const float dotV, const bool visible )
 {
+    const float dotV_prev        = m_dotV;
+    const bool  dotVVisible_prev = m_dotVVisible;
+
     m_dotV = dotV;
 
     if      ( m_dotV < -1.0f ) m_dotV = -1.0f;
     else if ( m_dotV >  1.0f ) m_dotV =  1.0f;
 
     m_dotVVisible = visible;
+
+    if ( m_dotV != dotV_prev || m_dotVVisible != dotVVisible_prev ) m_dirty |= DirtyDots;
+}
+
+void Pfd::ADI::setState(const PfdState& state)
+{
+    setRoll( state.roll );
+    setPitch( state.pitch );
+    setFlightPathMarker( state.angleOfAttack, state.sideslipAngle, state.flightPathVisible );
+    setSlipSkid( state.slipSkid );
+    setTurnRate( state.turnRate );
+    setBarH( state.barH, state.barHVisible );
+    setBarV( state.barV, state.barVVisible );
+    setDotH( state.dotH, state.dotHVisible );
+    setDotV( state.dotV, state.dotVVisible );
 }
 
 void Pfd::ADI::reset()
 {
-    m_itemBack   = 0;
     m_itemLadd   = 0;
     m_itemRoll   = 0;
     m_itemSlip   = 0;
@@ -445,66 +749,12 @@ void Pfd::ADI::reset()
     m_dotHVisible = true;
     m_dotVVisible = true;
 
-    m_laddDeltaX_new     = 0.0f;
-    m_laddDeltaX_old     = 0.0f;
-    m_laddBackDeltaX_new = 0.0f;
-    m_laddBackDeltaX_old = 0.0f;
-    m_laddBackDeltaY_new = 0.0f;
-    m_laddBackDeltaY_old = 0.0f;
-    m_laddDeltaY_new     = 0.0f;
-    m_laddDeltaY_old     = 0.0f;
-    m_slipDeltaX_new     = 0.0f;
-    m_slipDeltaX_old     = 0.0f;
-    m_slipDeltaY_new     = 0.0f;
-    m_slipDeltaY_old     = 0.0f;
-    m_turnDeltaX_new     = 0.0f;
-    m_turnDeltaX_old     = 0.0f;
-    m_pathDeltaX_new     = 0.0f;
-    m_pathDeltaX_old     = 0.0f;
-    m_pathDeltaY_new     = 0.0f;
-    m_pathDeltaY_old     = 0.0f;
-    m_markDeltaX_new     = 0.0f;
-    m_markDeltaX_old     = 0.0f;
-    m_markDeltaY_new     = 0.0f;
-    m_markDeltaY_old     = 0.0f;
-    m_barHDeltaX_new     = 0.0f;
-    m_barHDeltaX_old     = 0.0f;
-    m_barVDeltaY_new     = 0.0f;
-    m_barVDeltaY_old     = 0.0f;
-    m_dotHDeltaX_new     = 0.0f;
-    m_dotHDeltaX_old     = 0.0f;
-    m_dotVDeltaY_new     = 0.0f;
-    m_dotVDeltaY_old     = 0.0f;
-}
-
-void Pfd::ADI::updateLadd(const float delta, const float sinRoll, const float cosRoll)
-{
-    m_itemLadd->setRotation(-m_roll);
-
-    m_laddDeltaX_new = m_scaleX * delta * sinRoll;
-    m_laddDeltaY_new = m_scaleY * delta * cosRoll;
-
-    m_itemLadd->moveBy( m_laddDeltaX_new - m_laddDeltaX_old, m_laddDeltaY_new - m_laddDeltaY_old );
-}
-
-void Pfd::ADI::updateLaddBack(const float delta, const float sinRoll, const float cosRoll)
-{
-    m_itemBack->setRotation(-m_roll);
-
-    float deltaLaddBack = 0.0;
-
-    if (delta > m_deltaLaddBack_max) {
-        deltaLaddBack = m_deltaLaddBack_max;
-    } else if ( delta < m_deltaLaddBack_min ) {
-        deltaLaddBack = m_deltaLaddBack_min;
-    } else {
-        deltaLaddBack = delta;
-    }
-
-    m_laddBackDeltaX_new = m_scaleX * deltaLaddBack * sinRoll;
-    m_laddBackDeltaY_new = m_scaleY * deltaLaddBack * cosRoll;
+    m_dirty = Instrument::DirtyAll;
+}
 
-    m_itemBack->moveBy( m_laddBackDeltaX_new - m_laddBackDeltaX_old, m_laddBackDeltaY_new - m_laddBackDeltaY_old );
+void Pfd::ADI::updateLadd()
+{
+    m_itemLadd->setAttitude( m_roll, m_pitch );
 }
 
 void Pfd::ADI::updateRoll()
@@ -518,16 +768,14 @@ void Pfd::ADI::updateSlipSkid(const float sinRoll, const float cosRoll)
 
     const float deltaSlip = m_maxSlipDeflection * m_slipSkid;
 
-    m_slipDeltaX_new =  m_scaleX * deltaSlip * cosRoll;
-    m_slipDeltaY_new = -m_scaleY * deltaSlip * sinRoll;
-
-    m_itemSlip->moveBy( m_slipDeltaX_new - m_slipDeltaX_old, m_slipDeltaY_new - m_slipDeltaY_old );
+    m_itemSlip->setPos( m_scaleX * ( m_originalSlipPos.x() + deltaSlip * cosRoll ),
+                        m_scaleY * ( m_originalSlipPos.y() - deltaSlip * sinRoll ) );
 }
 
 void Pfd::ADI::updateTurnRate()
 {
-    m_turnDeltaX_new = m_scaleX * m_maxTurnDeflection * m_turnRate;
-    m_itemTurn->moveBy( m_turnDeltaX_new - m_turnDeltaX_old, 0.0 );
+    m_itemTurn->setPos( m_scaleX * ( m_originalTurnPos.x() + m_maxTurnDeflection * m_turnRate ),
+                        m_scaleY * m_originalTurnPos.y() );
 }
 
 void Pfd::ADI::updateFlightPath()
@@ -535,31 +783,20 @@ void Pfd::ADI::updateFlightPath()
     if (m_pathVisible) {
         m_itemPath->setVisible( true );
 
-        m_pathDeltaX_new = m_scaleX * m_originalPixPerDeg * m_sideslipAngle;
-        m_pathDeltaY_new = m_scaleY * m_originalPixPerDeg * m_angleOfAttack;
+        const QPointF pathPos( m_scaleX * ( m_originalPathPos.x() + m_originalPixPerDeg * m_sideslipAngle ),
+                               m_scaleY * ( m_originalPathPos.y() - m_originalPixPerDeg * m_angleOfAttack ) );
 
-        m_itemPath->moveBy( m_pathDeltaX_new - m_pathDeltaX_old, m_pathDeltaY_old - m_pathDeltaY_new );
+        m_itemPath->setPos( pathPos );
 
         if (!m_pathValid) {
             m_itemMark->setVisible( true );
-
-            m_markDeltaX_new = m_pathDeltaX_new;
-            m_markDeltaY_new = m_pathDeltaY_new;
-
-            m_itemMark->moveBy( m_markDeltaX_new - m_markDeltaX_old, m_markDeltaY_old - m_markDeltaY_new );
+            m_itemMark->setPos( pathPos );
         } else {
             m_itemMark->setVisible( false );
-            m_markDeltaX_new = m_markDeltaX_old;
-            m_markDeltaY_new = m_markDeltaY_old;
         }
     } else {
         m_itemPath->setVisible( false );
-        m_pathDeltaX_new = m_pathDeltaX_old;
-        m_pathDeltaY_new = m_pathDeltaY_old;
-
         m_itemMark->setVisible( false );
-        m_markDeltaX_new = m_markDeltaX_old;
-        m_markDeltaY_new = m_markDeltaY_old;
     }
 }
 
@@ -567,24 +804,18 @@ void Pfd::ADI::updateBars()
 {
     if (m_barVVisible) {
         m_itemBarV->setVisible( true );
-
-        m_barVDeltaY_new = m_scaleY * m_maxBarsDeflection * m_barV;
-
-        m_itemBarV->moveBy( 0.0f, m_barVDeltaY_old - m_barVDeltaY_new );
+        m_itemBarV->setPos( m_scaleX * m_originalBarVPos.x(),
+                            m_scaleY * ( m_originalBarVPos.y() - m_maxBarsDeflection * m_barV ) );
     } else {
         m_itemBarV->setVisible( false );
-        m_barVDeltaY_new = m_barVDeltaY_old;
     }
 
     if (m_barHVisible) {
         m_itemBarH->setVisible( true );
-
-        m_barHDeltaX_new = m_scaleX * m_maxBarsDeflection * m_barH;
-
-        m_itemBarH->moveBy( m_barHDeltaX_new - m_barHDeltaX_old, 0.0f );
+        m_itemBarH->setPos( m_scaleX * ( m_originalBarHPos.x() + m_maxBarsDeflection * m_barH ),
+                            m_scaleY * m_originalBarHPos.y() );
     } else {
         m_itemBarH->setVisible( false );
-        m_barHDeltaX_new = m_barHDeltaX_old;
     }
 }
 
@@ -594,28 +825,22 @@ void Pfd::ADI::updateDots()
         m_itemDotH->setVisible( true );
         m_itemScaleH->setVisible( true );
 
-        m_dotHDeltaX_new = m_scaleX * m_maxDotsDeflection * m_dotH;
-
-        m_itemDotH->moveBy( m_dotHDeltaX_new - m_dotHDeltaX_old, 0.0f );
+        m_itemDotH->setPos( m_scaleX * ( m_originalDotHPos.x() + m_maxDotsDeflection * m_dotH ),
+                            m_scaleY * m_originalDotHPos.y() );
     } else {
         m_itemDotH->setVisible( false );
         m_itemScaleH->setVisible( false );
-
-        m_dotHDeltaX_new = m_dotHDeltaX_old;
     }
 
     if (m_dotVVisible) {
         m_itemDotV->setVisible( true );
         m_itemScaleV->setVisible( true );
 
-        m_dotVDeltaY_new = m_scaleY * m_maxDotsDeflection * m_dotV;
-
-        m_itemDotV->moveBy( 0.0f, m_dotVDeltaY_old - m_dotVDeltaY_new );
+        m_itemDotV->setPos( m_scaleX * m_originalDotVPos.x(),
+                            m_scaleY * ( m_originalDotVPos.y() - m_maxDotsDeflection * m_dotV ) );
     } else {
         m_itemDotV->setVisible( false );
         m_itemScaleV->setVisible( false );
-
-        m_dotVDeltaY_new = m_dotVDeltaY_old;
     }
 }
 
@@ -643,6 +868,9 @@ Pfd::ALT::ALT(QGraphicsScene* scene) : m_scene(scene)
     m_labelsFont.setWeight( QFont::Bold );
 #   endif
 
+    m_frameTextAtlas.setFont( m_frameTextFont, m_frameTextColor );
+    m_pressTextAtlas.setFont( m_frameTextFont, m_pressTextColor, "STDMBIN" );
+
     reset();
 }
 
@@ -653,119 +881,113 @@ void Pfd::ALT::init(const float scaleX, const float scaleY)
 
     reset();
 
-    m_itemBack = new QGraphicsSvgItem( ":/qfi/images/pfd/pfd_alt_back.svg" );
+    m_itemBack = new SvgItem( ":/qfi/images/pfd/pfd_alt_back.svg" );
     m_itemBack->setCacheMode( QGraphicsItem::NoCache );
     m_itemBack->setZValue( m_backZ );
     m_itemBack->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
     m_itemBack->moveBy( m_scaleX * m_originalBackPos.x(), m_scaleY * m_originalBackPos.y() );
     m_scene->addItem( m_itemBack );
 
-    m_itemScale1 = new QGraphicsSvgItem( ":/qfi/images/pfd/pfd_alt_scale.svg" );
-    m_itemScale1->setCacheMode( QGraphicsItem::NoCache );
-    m_itemScale1->setZValue( m_scaleZ );
-    m_itemScale1->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
-    m_itemScale1->moveBy( m_scaleX * m_originalScale1Pos.x(), m_scaleY * m_originalScale1Pos.y() );
-    m_scene->addItem( m_itemScale1 );
-
-    m_itemScale2 = new QGraphicsSvgItem( ":/qfi/images/pfd/pfd_alt_scale.svg" );
-    m_itemScale2->setCacheMode( QGraphicsItem::NoCache );
-    m_itemScale2->setZValue( m_scaleZ );
-    m_itemScale2->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
-    m_itemScale2->moveBy( m_scaleX * m_originalScale2Pos.x(), m_scaleY * m_originalScale2Pos.y() );
-    m_scene->addItem( m_itemScale2 );
-
-    m_itemLabel1 = new QGraphicsTextItem( QString( "99999" ) );
-    m_itemLabel1->setCacheMode( QGraphicsItem::NoCache );
-    m_itemLabel1->setZValue( m_labelsZ );
-    m_itemLabel1->setDefaultTextColor( m_labelsColor );
-    m_itemLabel1->setFont( m_labelsFont );
-    m_itemLabel1->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
-    m_itemLabel1->moveBy( m_scaleX * ( m_originalLabelsX - m_itemLabel1->boundingRect().width()  / 2.0f ),
-                         m_scaleY * ( m_originalLabel1Y - m_itemLabel1->boundingRect().height() / 2.0f ) );
-    m_scene->addItem( m_itemLabel1 );
-
-    m_itemLabel2 = new QGraphicsTextItem( QString( "99999" ) );
-    m_itemLabel2->setCacheMode( QGraphicsItem::NoCache );
-    m_itemLabel2->setZValue( m_labelsZ );
-    m_itemLabel2->setDefaultTextColor( m_labelsColor );
-    m_itemLabel2->setFont( m_labelsFont );
-    m_itemLabel2->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
-    m_itemLabel2->moveBy( m_scaleX * ( m_originalLabelsX - m_itemLabel2->boundingRect().width()  / 2.0f ),
-                         m_scaleY * ( m_originalLabel2Y - m_itemLabel2->boundingRect().height() / 2.0f ) );
-    m_scene->addItem( m_itemLabel2 );
-
-    m_itemLabel3 = new QGraphicsTextItem( QString( "99999" ) );
-    m_itemLabel3->setCacheMode( QGraphicsItem::NoCache );
-    m_itemLabel3->setZValue( m_labelsZ );
-    m_itemLabel3->setDefaultTextColor( m_labelsColor );
-    m_itemLabel3->setFont( m_labelsFont );
-    m_itemLabel3->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
-    m_itemLabel3->moveBy( m_scaleX * ( m_originalLabelsX - m_itemLabel3->boundingRect().width()  / 2.0f ),
-                         m_scaleY * ( m_originalLabel3Y - m_itemLabel3->boundingRect().height() / 2.0f ) );
-    m_scene->addItem( m_itemLabel3 );
-
-    m_itemGround = new QGraphicsSvgItem( ":/qfi/images/pfd/pfd_alt_ground.svg" );
+    m_itemTape = new Tape( m_originalTapeWindow, m_originalReferenceY, m_originalPixPerAlt );
+    m_itemTape->setTicks( m_originalTicksStep, m_originalTick, m_labelsColor );
+    m_itemTape->setLabels( m_originalLabelsStep, m_originalLabelsX, 5, m_labelsFont, m_labelsColor );
+    m_itemTape->setRange( m_minAltitude, m_maxAltitude );
+    m_itemTape->setCacheMode( QGraphicsItem::NoCache );
+    m_itemTape->setZValue( m_tapeZ );
+    m_itemTape->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
+    m_scene->addItem( m_itemTape );
+
+    m_itemGround = new SvgItem( ":/qfi/images/pfd/pfd_alt_ground.svg" );
     m_itemGround->setCacheMode( QGraphicsItem::NoCache );
     m_itemGround->setZValue( m_groundZ );
     m_itemGround->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
     m_itemGround->moveBy( m_scaleX * m_originalGroundPos.x(), m_scaleY * m_originalGroundPos.y() );
     m_scene->addItem( m_itemGround );
 
-    m_itemFrame = new QGraphicsSvgItem( ":/qfi/images/pfd/pfd_alt_frame.svg" );
+    m_itemFrame = new SvgItem( ":/qfi/images/pfd/pfd_alt_frame.svg" );
     m_itemFrame->setCacheMode( QGraphicsItem::NoCache );
     m_itemFrame->setZValue( m_frameZ );
     m_itemFrame->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
     m_itemFrame->moveBy( m_scaleX * m_originalFramePos.x(), m_scaleY * m_originalFramePos.y() );
     m_scene->addItem( m_itemFrame );
 
-    m_itemAltitude = new QGraphicsTextItem( QString( "    0" ) );
+    m_itemAltitude = new Readout( &m_frameTextAtlas, "    0" );
     m_itemAltitude->setCacheMode( QGraphicsItem::NoCache );
     m_itemAltitude->setZValue( m_frameTextZ );
-    m_itemAltitude->setDefaultTextColor( m_frameTextColor );
-    m_itemAltitude->setFont( m_frameTextFont );
     m_itemAltitude->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
-    m_itemAltitude->moveBy( m_scaleX * ( m_originalAltitudeCtr.x() - m_itemAltitude->boundingRect().width()  / 2.0f ),
-                           m_scaleY * ( m_originalAltitudeCtr.y() - m_itemAltitude->boundingRect().height() / 2.0f ) );
+    m_originalAltitudePos = m_originalAltitudeCtr - QPointF( m_itemAltitude->boundingRect().width()  / 2.0f,
+                                                             m_itemAltitude->boundingRect().height() / 2.0f );
+    m_itemAltitude->moveBy( m_scaleX * m_originalAltitudePos.x(), m_scaleY * m_originalAltitudePos.y() );
     m_scene->addItem( m_itemAltitude );
 
-    m_itemPressure = new QGraphicsTextItem( QString( "  STD  " ) );
+    m_itemPressure = new Readout( &m_pressTextAtlas, "  STD  " );
     m_itemPressure->setCacheMode( QGraphicsItem::NoCache );
     m_itemPressure->setZValue( m_frameTextZ );
-    m_itemPressure->setDefaultTextColor( m_pressTextColor );
-    m_itemPressure->setFont( m_frameTextFont );
     m_itemPressure->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
-    m_itemPressure->moveBy( m_scaleX * ( m_originalPressureCtr.x() - m_itemPressure->boundingRect().width()  / 2.0f ),
-                           m_scaleY * ( m_originalPressureCtr.y() - m_itemPressure->boundingRect().height() / 2.0f ) );
+    m_originalPressurePos = m_originalPressureCtr - QPointF( m_itemPressure->boundingRect().width()  / 2.0f,
+                                                             m_itemPressure->boundingRect().height() / 2.0f );
+    m_itemPressure->moveBy( m_scaleX * m_originalPressurePos.x(), m_scaleY * m_originalPressurePos.y() );
     m_scene->addItem( m_itemPressure );
 
     update( scaleX, scaleY );
 }
 
-void Pfd::ALT::update(const float scaleX, const float scaleY)
+void Pfd::ALT::rescale(const float scaleX, const float scaleY)
 {
     m_scaleX = scaleX;
     m_scaleY = scaleY;
 
-    updateAltitude();
-    updatePressure();
+    const QTransform scale = QTransform::fromScale( m_scaleX, m_scaleY );
+
+    m_itemBack->setTransform( scale );
+    m_itemBack->setPos( m_scaleX * m_originalBackPos.x(), m_scaleY * m_originalBackPos.y() );
+
+    m_itemTape->setTransform( scale );
+
+    m_itemGround->setTransform( scale );
+    m_itemGround->setPos( m_scaleX * m_originalGroundPos.x(), m_scaleY * m_originalGroundPos.y() );
+
+    m_itemFrame->setTransform( scale );
+    m_itemFrame->setPos( m_scaleX * m_originalFramePos.x(), m_scaleY * m_originalFramePos.y() );
+
+    m_itemAltitude->setTransform( scale );
+    m_itemAltitude->setPos( m_scaleX * m_originalAltitudePos.x(), m_scaleY * m_originalAltitudePos.y() );
+
+    m_itemPressure->setTransform( scale );
+    m_itemPressure->setPos( m_scaleX * m_originalPressurePos.x(), m_scaleY * m_originalPressurePos.y() );
+
+    // state is reapplied at the new scale by the next update
+    m_dirty = Instrument::DirtyAll;
+}
+
+void Pfd::ALT::update(const float scaleX, const float scaleY)
+{
+    m_scaleX = scaleX;
+    m_scaleY = scaleY;
 
-    m_scale1DeltaY_old = m_scale1DeltaY_new;
-    m_scale2DeltaY_old = m_scale2DeltaY_new;
-    m_groundDeltaY_old = m_groundDeltaY_new;
-    m_labelsDeltaY_old = m_labelsDeltaY_new;
+    if ( m_dirty & DirtyAltitude ) updateAltitude();
+    if ( m_dirty & DirtyPressure ) updatePressure();
 
+    m_dirty = Instrument::DirtyNone;
 }
 
 void Pfd::ALT::setAltitude(const float altitude)
 {
+    const float altitude_prev = m_altitude;
+
     m_altitude = altitude;
 
-    if      ( m_altitude <     0.0f ) m_altitude =     0.0f;
-    else if ( m_altitude > 99999.0f ) m_altitude = 99999.0f;
+    if      ( m_altitude < m_minAltitude ) m_altitude = m_minAltitude;
+    else if ( m_altitude > m_maxAltitude ) m_altitude = m_maxAltitude;
+
+    if ( m_altitude != altitude_prev ) m_dirty |= DirtyAltitude;
 }
 
 void Pfd::ALT::setPressure(const float pressure, const int pressureUnit)
 {
+    const float pressure_prev     = m_pressure;
+    const int   pressureUnit_prev = m_pressureUnit;
+
     m_pressure = pressure;
 
     if      ( m_pressure <    0.0f ) m_pressure =    0.0f;
@@ -775,16 +997,20 @@ void Pfd::ALT::setPressure(const float pressure, const int pressureUnit)
 
     if      ( pressureUnit == 1 ) m_pressureUnit = 1;
     else if ( pressureUnit == 2 ) m_pressureUnit = 2;
+
+    if ( m_pressure != pressure_prev || m_pressureUnit != pressureUnit_prev ) m_dirty |= DirtyPressure;
+}
+
+void Pfd::ALT::setState(const PfdState& state)
+{
+    setAltitude( state.altitude );
+    setPressure( state.pressure, state.pressureUnit );
 }
 
 void Pfd::ALT::reset()
 {
     m_itemBack     = 0;
-    m_itemScale1   = 0;
-    m_itemScale2   = 0;
-    m_itemLabel1   = 0;
-    m_itemLabel2   = 0;
-    m_itemLabel3   = 0;
+    m_itemTape     = 0;
     m_itemGround   = 0;
     m_itemFrame    = 0;
     m_itemAltitude = 0;
@@ -795,104 +1021,35 @@ void Pfd::ALT::reset()
 
     m_pressureUnit = 0;
 
-    m_scale1DeltaY_new = 0.0f;
-    m_scale1DeltaY_old = 0.0f;
-    m_scale2DeltaY_new = 0.0f;
-    m_scale2DeltaY_old = 0.0f;
-    m_groundDeltaY_new = 0.0f;
-    m_groundDeltaY_old = 0.0f;
-    m_labelsDeltaY_new = 0.0f;
-    m_labelsDeltaY_old = 0.0f;
+    m_dirty = Instrument::DirtyAll;
 }
 
 void Pfd::ALT::updateAltitude()
 {
-    m_itemAltitude->setPlainText( QString("%1").arg(m_altitude, 5, 'f', 0, QChar(' ')) );
+    m_itemAltitude->setNumber( m_altitude, 5, 0 );
 
     updateScale();
-    updateScaleLabels();
 }
 
 void Pfd::ALT::updatePressure()
 {
     if (m_pressureUnit == 0) {
-        m_itemPressure->setPlainText( QString( "  STD  " ) );
+        m_itemPressure->setText( "  STD  " );
     } else if ( m_pressureUnit == 1 ) {
-        m_itemPressure->setPlainText( QString::number( m_pressure, 'f', 0 ) + QString( " MB" ) );
+        m_itemPressure->setNumber( m_pressure, 0, 0, ' ', "", " MB" );
     } else if ( m_pressureUnit == 2 ) {
-        m_itemPressure->setPlainText( QString::number( m_pressure, 'f', 2 ) + QString( " IN" ) );
+        m_itemPressure->setNumber( m_pressure, 0, 2, ' ', "", " IN" );
     }
 }
 
 void Pfd::ALT::updateScale()
 {
-    m_scale1DeltaY_new = m_scaleY * m_originalPixPerAlt * m_altitude;
-    m_scale2DeltaY_new = m_scale1DeltaY_new;
-    m_groundDeltaY_new = m_scale1DeltaY_new;
-
-    const float scaleSingleHeight = m_scaleY * m_originalScaleHeight;
-    const float scaleDoubleHeight = m_scaleY * m_originalScaleHeight * 2.0f;
-
-    while ( m_scale1DeltaY_new > scaleSingleHeight + m_scaleY * 74.5f ) {
-        m_scale1DeltaY_new = m_scale1DeltaY_new - scaleDoubleHeight;
-    }
+    float groundDeltaY = m_scaleY * m_originalPixPerAlt * m_altitude;
 
-    while ( m_scale2DeltaY_new > scaleDoubleHeight + m_scaleY * 74.5f ) {
-        m_scale2DeltaY_new = m_scale2DeltaY_new - scaleDoubleHeight;
-    }
-
-    if ( m_groundDeltaY_new > m_scaleY * 100.0f ) m_groundDeltaY_new = m_scaleY * 100.0f;
+    if ( groundDeltaY > m_scaleY * 100.0f ) groundDeltaY = m_scaleY * 100.0f;
 
-    m_itemScale1->moveBy( 0.0f, m_scale1DeltaY_new - m_scale1DeltaY_old );
-    m_itemScale2->moveBy( 0.0f, m_scale2DeltaY_new - m_scale2DeltaY_old );
-    m_itemGround->moveBy( 0.0f, m_groundDeltaY_new - m_groundDeltaY_old );
-}
-
-void Pfd::ALT::updateScaleLabels()
-{
-    const int tmp = std::floor( m_altitude + 0.5f );
-    const int alt = tmp - ( tmp % 500 );
-
-    float alt1{static_cast<float>(alt + 500.0f)};
-    float alt2{static_cast<float>(alt)};
-    float alt3{static_cast<float>(alt - 500.0f)};
-
-    m_labelsDeltaY_new = m_scaleY * m_originalPixPerAlt * m_altitude;
-
-    while ( m_labelsDeltaY_new > m_scaleY * 37.5f ) {
-        m_labelsDeltaY_new = m_labelsDeltaY_new - m_scaleY * 75.0f;
-    }
-
-    if ( m_labelsDeltaY_new < 0.0f && m_altitude > alt2 ) {
-        alt1 += 500.0f;
-        alt2 += 500.0f;
-        alt3 += 500.0f;
-    }
-
-    m_itemLabel1->moveBy( 0.0f, m_labelsDeltaY_new - m_labelsDeltaY_old );
-    m_itemLabel2->moveBy( 0.0f, m_labelsDeltaY_new - m_labelsDeltaY_old );
-    m_itemLabel3->moveBy( 0.0f, m_labelsDeltaY_new - m_labelsDeltaY_old );
-
-    if ( alt1 > 0.0f && alt1 <= 100000.0f ) {
-        m_itemLabel1->setVisible( true );
-        m_itemLabel1->setPlainText( QString("%1").arg(alt1, 5, 'f', 0, QChar(' ')) );
-    } else {
-        m_itemLabel1->setVisible( false );
-    }
-
-    if ( alt2 > 0.0f && alt2 <= 100000.0f ) {
-        m_itemLabel2->setVisible( true );
-        m_itemLabel2->setPlainText( QString("%1").arg(alt2, 5, 'f', 0, QChar(' ')) );
-    } else {
-        m_itemLabel2->setVisible( false );
-    }
-
-    if ( alt3 > 0.0f && alt3 <= 100000.0f ) {
-        m_itemLabel3->setVisible( true );
-        m_itemLabel3->setPlainText( QString("%1").arg(alt3, 5, 'f', 0, QChar(' ')) );
-    } else {
-        m_itemLabel3->setVisible( false );
-    }
+    m_itemTape->setValue( m_altitude );
+    m_itemGround->setPos( m_scaleX * m_originalGroundPos.x(), m_scaleY * m_originalGroundPos.y() + groundDeltaY );
 }
 
 Pfd::ASI::ASI(QGraphicsScene* scene) : m_scene(scene)
@@ -919,6 +1076,8 @@ Pfd::ASI::ASI(QGraphicsScene* scene) : m_scene(scene)
     m_labelsFont.setWeight( QFont::Bold );
 #   endif
 
+    m_frameTextAtlas.setFont( m_frameTextFont, m_frameTextColor );
+
     reset();
 }
 
@@ -929,169 +1088,120 @@ void Pfd::ASI::init(const float scaleX, const float scaleY)
 
     reset();
 
-    m_itemBack = new QGraphicsSvgItem( ":/qfi/images/pfd/pfd_asi_back.svg" );
+    m_itemBack = new SvgItem( ":/qfi/images/pfd/pfd_asi_back.svg" );
     m_itemBack->setCacheMode( QGraphicsItem::NoCache );
     m_itemBack->setZValue( m_backZ );
     m_itemBack->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
     m_itemBack->moveBy( m_scaleX * m_originalBackPos.x(), m_scaleY * m_originalBackPos.y() );
     m_scene->addItem( m_itemBack );
 
-    m_itemScale1 = new QGraphicsSvgItem( ":/qfi/images/pfd/pfd_asi_scale.svg" );
-    m_itemScale1->setCacheMode( QGraphicsItem::NoCache );
-    m_itemScale1->setZValue( m_scaleZ );
-    m_itemScale1->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
-    m_itemScale1->moveBy( m_scaleX * m_originalScale1Pos.x(), m_scaleY * m_originalScale1Pos.y() );
-    m_scene->addItem( m_itemScale1 );
-
-    m_itemScale2 = new QGraphicsSvgItem( ":/qfi/images/pfd/pfd_asi_scale.svg" );
-    m_itemScale2->setCacheMode( QGraphicsItem::NoCache );
-    m_itemScale2->setZValue( m_scaleZ );
-    m_itemScale2->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
-    m_itemScale2->moveBy( m_scaleX * m_originalScale2Pos.x(), m_scaleY * m_originalScale2Pos.y() );
-    m_scene->addItem( m_itemScale2 );
-
-    m_itemLabel1 = new QGraphicsTextItem( QString( "999" ) );
-    m_itemLabel1->setCacheMode( QGraphicsItem::NoCache );
-    m_itemLabel1->setZValue( m_labelsZ );
-    m_itemLabel1->setDefaultTextColor( m_labelsColor );
-    m_itemLabel1->setFont( m_labelsFont );
-    m_itemLabel1->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
-    m_itemLabel1->moveBy( m_scaleX * ( m_originalLabelsX - m_itemLabel1->boundingRect().width()  / 2.0f ),
-                         m_scaleY * ( m_originalLabel1Y - m_itemLabel1->boundingRect().height() / 2.0f ) );
-    m_scene->addItem( m_itemLabel1 );
-
-    m_itemLabel2 = new QGraphicsTextItem( QString( "999" ) );
-    m_itemLabel2->setCacheMode( QGraphicsItem::NoCache );
-    m_itemLabel2->setZValue( m_labelsZ );
-    m_itemLabel2->setDefaultTextColor( m_labelsColor );
-    m_itemLabel2->setFont( m_labelsFont );
-    m_itemLabel2->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
-    m_itemLabel2->moveBy( m_scaleX * ( m_originalLabelsX - m_itemLabel2->boundingRect().width()  / 2.0f ),
-                         m_scaleY * ( m_originalLabel2Y - m_itemLabel2->boundingRect().height() / 2.0f ) );
-    m_scene->addItem( m_itemLabel2 );
-
-    m_itemLabel3 = new QGraphicsTextItem( QString( "999" ) );
-    m_itemLabel3->setCacheMode( QGraphicsItem::NoCache );
-    m_itemLabel3->setZValue( m_labelsZ );
-    m_itemLabel3->setDefaultTextColor( m_labelsColor );
-    m_itemLabel3->setFont( m_labelsFont );
-    m_itemLabel3->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
-    m_itemLabel3->moveBy( m_scaleX * ( m_originalLabelsX - m_itemLabel3->boundingRect().width()  / 2.0f ),
-                         m_scaleY * ( m_originalLabel3Y - m_itemLabel3->boundingRect().height() / 2.0f ) );
-    m_scene->addItem( m_itemLabel3 );
-
-    m_itemLabel4 = new QGraphicsTextItem( QString( "999" ) );
-    m_itemLabel4->setCacheMode( QGraphicsItem::NoCache );
-    m_itemLabel4->setZValue( m_labelsZ );
-    m_itemLabel4->setDefaultTextColor( m_labelsColor );
-    m_itemLabel4->setFont( m_labelsFont );
-    m_itemLabel4->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
-    m_itemLabel4->moveBy( m_scaleX * ( m_originalLabelsX - m_itemLabel4->boundingRect().width()  / 2.0f ),
-                         m_scaleY * ( m_originalLabel4Y - m_itemLabel4->boundingRect().height() / 2.0f ) );
-    m_scene->addItem( m_itemLabel4 );
-
-    m_itemLabel5 = new QGraphicsTextItem( QString( "999" ) );
-    m_itemLabel5->setCacheMode( QGraphicsItem::NoCache );
-    m_itemLabel5->setZValue( m_labelsZ );
-    m_itemLabel5->setDefaultTextColor( m_labelsColor );
-    m_itemLabel5->setFont( m_labelsFont );
-    m_itemLabel5->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
-    m_itemLabel5->moveBy( m_scaleX * ( m_originalLabelsX - m_itemLabel5->boundingRect().width()  / 2.0f ),
-                         m_scaleY * ( m_originalLabel5Y - m_itemLabel5->boundingRect().height() / 2.0f ) );
-    m_scene->addItem( m_itemLabel5 );
-
-    m_itemLabel6 = new QGraphicsTextItem( QString( "999" ) );
-    m_itemLabel6->setCacheMode( QGraphicsItem::NoCache );
-    m_itemLabel6->setZValue( m_labelsZ );
-    m_itemLabel6->setDefaultTextColor( m_labelsColor );
-    m_itemLabel6->setFont( m_labelsFont );
-    m_itemLabel6->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
-    m_itemLabel6->moveBy( m_scaleX * ( m_originalLabelsX - m_itemLabel6->boundingRect().width()  / 2.0f ),
-                         m_scaleY * ( m_originalLabel6Y - m_itemLabel6->boundingRect().height() / 2.0f ) );
-    m_scene->addItem( m_itemLabel6 );
-
-    m_itemLabel7 = new QGraphicsTextItem( QString( "999" ) );
-    m_itemLabel7->setCacheMode( QGraphicsItem::NoCache );
-    m_itemLabel7->setZValue( m_labelsZ );
-    m_itemLabel7->setDefaultTextColor( m_labelsColor );
-    m_itemLabel7->setFont( m_labelsFont );
-    m_itemLabel7->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
-    m_itemLabel7->moveBy( m_scaleX * ( m_originalLabelsX - m_itemLabel7->boundingRect().width()  / 2.0f ),
-                         m_scaleY * ( m_originalLabel7Y - m_itemLabel7->boundingRect().height() / 2.0f ) );
-    m_scene->addItem( m_itemLabel7 );
-
-    m_itemFrame = new QGraphicsSvgItem( ":/qfi/images/pfd/pfd_asi_frame.svg" );
+    m_itemTape = new Tape( m_originalTapeWindow, m_originalReferenceY, m_originalPixPerSpd );
+    m_itemTape->setTicks( m_originalTicksStep, m_originalTick, m_labelsColor );
+    m_itemTape->setLabels( m_originalLabelsStep, m_originalLabelsX, 3, m_labelsFont, m_labelsColor );
+    m_itemTape->setRange( 0.0f, m_maxAirspeed );
+    m_itemTape->setCacheMode( QGraphicsItem::NoCache );
+    m_itemTape->setZValue( m_tapeZ );
+    m_itemTape->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
+    m_scene->addItem( m_itemTape );
+
+    m_itemFrame = new SvgItem( ":/qfi/images/pfd/pfd_asi_frame.svg" );
     m_itemFrame->setCacheMode( QGraphicsItem::NoCache );
     m_itemFrame->setZValue( m_frameZ );
     m_itemFrame->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
     m_itemFrame->moveBy( m_scaleX * m_originalFramePos.x(), m_scaleY * m_originalFramePos.y() );
     m_scene->addItem( m_itemFrame );
 
-    m_itemAirspeed = new QGraphicsTextItem( QString( "000" ) );
+    m_itemAirspeed = new Readout( &m_frameTextAtlas, "000" );
     m_itemAirspeed->setCacheMode( QGraphicsItem::NoCache );
     m_itemAirspeed->setZValue( m_frameTextZ );
-    m_itemAirspeed->setTextInteractionFlags( Qt::NoTextInteraction );
-    m_itemAirspeed->setDefaultTextColor( m_frameTextColor );
-    m_itemAirspeed->setFont( m_frameTextFont );
     m_itemAirspeed->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
-    m_itemAirspeed->moveBy( m_scaleX * ( m_originalAirspeedCtr.x() - m_itemAirspeed->boundingRect().width()  / 2.0f ),
-                           m_scaleY * ( m_originalAirspeedCtr.y() - m_itemAirspeed->boundingRect().height() / 2.0f ) );
+    m_originalAirspeedPos = m_originalAirspeedCtr - QPointF( m_itemAirspeed->boundingRect().width()  / 2.0f,
+                                                             m_itemAirspeed->boundingRect().height() / 2.0f );
+    m_itemAirspeed->moveBy( m_scaleX * m_originalAirspeedPos.x(), m_scaleY * m_originalAirspeedPos.y() );
     m_scene->addItem( m_itemAirspeed );
 
-    m_itemMachNo = new QGraphicsTextItem( QString( ".000" ) );
+    m_itemMachNo = new Readout( &m_frameTextAtlas, ".000" );
     m_itemMachNo->setCacheMode( QGraphicsItem::NoCache );
     m_itemMachNo->setZValue( m_frameTextZ );
-    m_itemMachNo->setTextInteractionFlags( Qt::NoTextInteraction );
-    m_itemMachNo->setDefaultTextColor( m_frameTextColor );
-    m_itemMachNo->setFont( m_frameTextFont );
     m_itemMachNo->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
-    m_itemMachNo->moveBy( m_scaleX * ( m_originalMachNoCtr.x() - m_itemMachNo->boundingRect().width()  / 2.0f ),
-                         m_scaleY * ( m_originalMachNoCtr.y() - m_itemMachNo->boundingRect().height() / 2.0f ) );
+    m_originalMachNoPos = m_originalMachNoCtr - QPointF( m_itemMachNo->boundingRect().width()  / 2.0f,
+                                                         m_itemMachNo->boundingRect().height() / 2.0f );
+    m_itemMachNo->moveBy( m_scaleX * m_originalMachNoPos.x(), m_scaleY * m_originalMachNoPos.y() );
     m_scene->addItem( m_itemMachNo );
 
     update( scaleX, scaleY );
 }
 
+void Pfd::ASI::rescale(const float scaleX, const float scaleY)
+{
+    m_scaleX = scaleX;
+    m_scaleY = scaleY;
+
+    const QTransform scale = QTransform::fromScale( m_scaleX, m_scaleY );
+
+    m_itemBack->setTransform( scale );
+    m_itemBack->setPos( m_scaleX * m_originalBackPos.x(), m_scaleY * m_originalBackPos.y() );
+
+    m_itemTape->setTransform( scale );
+
+    m_itemFrame->setTransform( scale );
+    m_itemFrame->setPos( m_scaleX * m_originalFramePos.x(), m_scaleY * m_originalFramePos.y() );
+
+    m_itemAirspeed->setTransform( scale );
+    m_itemAirspeed->setPos( m_scaleX * m_originalAirspeedPos.x(), m_scaleY * m_originalAirspeedPos.y() );
+
+    m_itemMachNo->setTransform( scale );
+    m_itemMachNo->setPos( m_scaleX * m_originalMachNoPos.x(), m_scaleY * m_originalMachNoPos.y() );
+
+    // state is reapplied at the new scale by the next update
+    m_dirty = Instrument::DirtyAll;
+}
+
 void Pfd::ASI::update(const float scaleX, const float scaleY)
 {
     m_scaleX = scaleX;
     m_scaleY = scaleY;
 
-    updateAirspeed();
+    if ( m_dirty & DirtyAirspeed ) updateAirspeed();
+    if ( m_dirty & DirtyMachNo   ) updateMachNo();
 
-    m_scale1DeltaY_old = m_scale1DeltaY_new;
-    m_scale2DeltaY_old = m_scale2DeltaY_new;
-    m_labelsDeltaY_old = m_labelsDeltaY_new;
+    m_dirty = Instrument::DirtyNone;
 }
 
 void Pfd::ASI::setAirspeed(const float airspeed)
 {
+    const float airspeed_prev = m_airspeed;
+
     m_airspeed = airspeed;
 
-    if      ( m_airspeed <    0.0f ) m_airspeed =    0.0f;
-    else if ( m_airspeed > 9999.0f ) m_airspeed = 9999.0f;
+    if      ( m_airspeed < 0.0f          ) m_airspeed = 0.0f;
+    else if ( m_airspeed > m_maxAirspeed ) m_airspeed = m_maxAirspeed;
+
+    if ( m_airspeed != airspeed_prev ) m_dirty |= DirtyAirspeed;
 }
 
 void Pfd::ASI::setMachNo(const float machNo)
 {
+    const float machNo_prev = m_machNo;
+
     m_machNo = machNo;
 
     if      ( m_machNo <  0.0f ) m_machNo =  0.0f;
     else if ( m_machNo > 99.9f ) m_machNo = 99.9f;
+
+    if ( m_machNo != machNo_prev ) m_dirty |= DirtyMachNo;
+}
+
+void Pfd::ASI::setState(const PfdState& state)
+{
+    setAirspeed( state.airspeed );
+    setMachNo( state.machNo );
 }
 
 void Pfd::ASI::reset()
 {
     m_itemBack     = 0;
-    m_itemScale1   = 0;
-    m_itemScale2   = 0;
-    m_itemLabel1   = 0;
-    m_itemLabel2   = 0;
-    m_itemLabel3   = 0;
-    m_itemLabel4   = 0;
-    m_itemLabel5   = 0;
-    m_itemLabel6   = 0;
-    m_itemLabel7   = 0;
+    m_itemTape     = 0;
     m_itemFrame    = 0;
     m_itemAirspeed = 0;
     m_itemMachNo   = 0;
@@ -1099,138 +1209,32 @@ void Pfd::ASI::reset()
     m_airspeed = 0.0f;
     m_machNo   = 0.0f;
 
-    m_scale1DeltaY_new = 0.0f;
-    m_scale1DeltaY_old = 0.0f;
-    m_scale2DeltaY_new = 0.0f;
-    m_scale2DeltaY_old = 0.0f;
-    m_labelsDeltaY_new = 0.0f;
-    m_labelsDeltaY_old = 0.0f;
+    m_dirty = Instrument::DirtyAll;
 }
 
 void Pfd::ASI::updateAirspeed()
 {
-    m_itemAirspeed->setPlainText( QString("%1").arg(m_airspeed, 3, 'f', 0, QChar('0')) );
+    m_itemAirspeed->setNumber( m_airspeed, 3, 0, '0' );
+
+    updateScale();
+}
 
+void Pfd::ASI::updateMachNo()
+{
     if ( m_machNo < 1.0f ) {
-        float machNo = 1000.0f * m_machNo;
-        m_itemMachNo->setPlainText( QString(".%1").arg(machNo, 3, 'f', 0, QChar('0')) );
+        m_itemMachNo->setNumber( 1000.0f * m_machNo, 3, 0, '0', "." );
     } else {
         if ( m_machNo < 10.0f ) {
-            m_itemMachNo->setPlainText( QString::number( m_machNo, 'f', 2 ) );
+            m_itemMachNo->setNumber( m_machNo, 0, 2 );
         } else {
-            m_itemMachNo->setPlainText( QString::number( m_machNo, 'f', 1 ) );
+            m_itemMachNo->setNumber( m_machNo, 0, 1 );
         }
     }
-
-    updateScale();
-    updateScaleLabels();
 }
 
 void Pfd::ASI::updateScale()
 {
-    m_scale1DeltaY_new = m_scaleY * m_originalPixPerSpd * m_airspeed;
-    m_scale2DeltaY_new = m_scale1DeltaY_new;
-
-    const float scaleSingleHeight = m_scaleY * m_originalScaleHeight;
-    const float scaleDoubleHeight = m_scaleY * m_originalScaleHeight * 2.0f;
-
-    while ( m_scale1DeltaY_new > scaleSingleHeight + m_scaleY * 74.5f ) {
-        m_scale1DeltaY_new = m_scale1DeltaY_new - scaleDoubleHeight;
-    }
-
-    while ( m_scale2DeltaY_new > scaleDoubleHeight + m_scaleY * 74.5f ) {
-        m_scale2DeltaY_new = m_scale2DeltaY_new - scaleDoubleHeight;
-    }
-
-    m_itemScale1->moveBy( 0.0f, m_scale1DeltaY_new - m_scale1DeltaY_old );
-    m_itemScale2->moveBy( 0.0f, m_scale2DeltaY_new - m_scale2DeltaY_old );
-}
-
-void Pfd::ASI::updateScaleLabels()
-{
-    m_labelsDeltaY_new = m_scaleY * m_originalPixPerSpd * m_airspeed;
-
-    const int tmp = std::floor( m_airspeed + 0.5f );
-    const int spd = tmp - ( tmp % 20 );
-
-    float spd1{static_cast<float>(spd + 60.0f)};
-    float spd2{static_cast<float>(spd + 40.0f)};
-    float spd3{static_cast<float>(spd + 20.0f)};
-    float spd4{static_cast<float>(spd)};
-    float spd5{static_cast<float>(spd - 20.0f)};
-    float spd6{static_cast<float>(spd - 40.0f)};
-    float spd7{static_cast<float>(spd - 60.0f)};
-
-    while ( m_labelsDeltaY_new > m_scaleY * 15.0f ) {
-        m_labelsDeltaY_new = m_labelsDeltaY_new - m_scaleY * 30.0f;
-    }
-
-    if ( m_labelsDeltaY_new < 0.0 && m_airspeed > spd4 ) {
-        spd1 += 20.0f;
-        spd2 += 20.0f;
-        spd3 += 20.0f;
-        spd4 += 20.0f;
-        spd5 += 20.0f;
-        spd6 += 20.0f;
-        spd7 += 20.0f;
-    }
-
-    m_itemLabel1->moveBy( 0.0f, m_labelsDeltaY_new - m_labelsDeltaY_old );
-    m_itemLabel2->moveBy( 0.0f, m_labelsDeltaY_new - m_labelsDeltaY_old );
-    m_itemLabel3->moveBy( 0.0f, m_labelsDeltaY_new - m_labelsDeltaY_old );
-    m_itemLabel4->moveBy( 0.0f, m_labelsDeltaY_new - m_labelsDeltaY_old );
-    m_itemLabel5->moveBy( 0.0f, m_labelsDeltaY_new - m_labelsDeltaY_old );
-    m_itemLabel6->moveBy( 0.0f, m_labelsDeltaY_new - m_labelsDeltaY_old );
-    m_itemLabel7->moveBy( 0.0f, m_labelsDeltaY_new - m_labelsDeltaY_old );
-
-    if ( spd1 >= 0.0f && spd1 <= 10000.0f ) {
-        m_itemLabel1->setVisible( true );
-        m_itemLabel1->setPlainText( QString("%1").arg(spd1, 3, 'f', 0, QChar(' ')) );
-    } else {
-        m_itemLabel1->setVisible( false );
-    }
-
-    if ( spd2 >= 0.0f && spd2 <= 10000.0f ) {
-        m_itemLabel2->setVisible( true );
-        m_itemLabel2->setPlainText( QString("%1").arg(spd2, 3, 'f', 0, QChar(' ')) );
-    } else {
-        m_itemLabel2->setVisible( false );
-    }
-
-    if ( spd3 >= 0.0f && spd3 <= 10000.0f ) {
-        m_itemLabel3->setVisible( true );
-        m_itemLabel3->setPlainText( QString("%1").arg(spd3, 3, 'f', 0, QChar(' ')) );
-    } else {
-        m_itemLabel3->setVisible( false );
-    }
-
-    if ( spd4 >= 0.0f && spd4 <= 10000.0f ) {
-        m_itemLabel4->setVisible( true );
-        m_itemLabel4->setPlainText( QString("%1").arg(spd4, 3, 'f', 0, QChar(' ')) );
-    } else {
-        m_itemLabel4->setVisible( false );
-    }
-
-    if ( spd5 >= 0.0f && spd5 <= 10000.0f ) {
-        m_itemLabel5->setVisible( true );
-        m_itemLabel5->setPlainText( QString("%1").arg(spd5, 3, 'f', 0, QChar(' ')) );
-    } else {
-        m_itemLabel5->setVisible( false );
-    }
-
-    if ( spd6 >= 0.0f && spd6 <= 10000.0f ) {
-        m_itemLabel6->setVisible( true );
-        m_itemLabel6->setPlainText( QString("%1").arg(spd6, 3, 'f', 0, QChar(' ')) );
-    } else {
-        m_itemLabel6->setVisible( false );
-    }
-
-    if ( spd7 >= 0.0f && spd7 <= 10000.0f ) {
-        m_itemLabel7->setVisible( true );
-        m_itemLabel7->setPlainText( QString("%1").arg(spd7, 3, 'f', 0, QChar(' ')) );
-    } else {
-        m_itemLabel7->setVisible( false );
-    }
+    m_itemTape->setValue( m_airspeed );
 }
 
 Pfd::HSI::HSI(QGraphicsScene* scene) : m_scene(scene)
@@ -1240,6 +1244,8 @@ Pfd::HSI::HSI(QGraphicsScene* scene) : m_scene(scene)
     m_frameTextFont.setStretch( QFont::Condensed );
     m_frameTextFont.setWeight( QFont::Bold );
 
+    m_frameTextAtlas.setFont( m_frameTextFont, m_frameTextColor );
+
     reset();
 }
 
@@ -1250,14 +1256,14 @@ void Pfd::HSI::init( float scaleX, float scaleY )
 
     reset();
 
-    m_itemBack = new QGraphicsSvgItem( ":/qfi/images/pfd/pfd_hsi_back.svg" );
+    m_itemBack = new SvgItem( ":/qfi/images/pfd/pfd_hsi_back.svg" );
     m_itemBack->setCacheMode( QGraphicsItem::NoCache );
     m_itemBack->setZValue( m_backZ );
     m_itemBack->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
     m_itemBack->moveBy( m_scaleX * m_originalBackPos.x(), m_scaleY * m_originalBackPos.y() );
     m_scene->addItem( m_itemBack );
 
-    m_itemFace = new QGraphicsSvgItem( ":/qfi/images/pfd/pfd_hsi_face.svg" );
+    m_itemFace = new SvgItem( ":/qfi/images/pfd/pfd_hsi_face.svg" );
     m_itemFace->setCacheMode( QGraphicsItem::NoCache );
     m_itemFace->setZValue( m_faceZ );
     m_itemFace->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
@@ -1265,37 +1271,62 @@ void Pfd::HSI::init( float scaleX, float scaleY )
     m_itemFace->moveBy( m_scaleX * m_originalFacePos.x(), m_scaleY * m_originalFacePos.y() );
     m_scene->addItem( m_itemFace );
 
-    m_itemMarks = new QGraphicsSvgItem( ":/qfi/images/pfd/pfd_hsi_marks.svg" );
+    m_itemMarks = new SvgItem( ":/qfi/images/pfd/pfd_hsi_marks.svg" );
     m_itemMarks->setCacheMode( QGraphicsItem::NoCache );
     m_itemMarks->setZValue( m_marksZ );
     m_itemMarks->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
     m_itemMarks->moveBy( m_scaleX * m_originalMarksPos.x(), m_scaleY * m_originalMarksPos.y() );
     m_scene->addItem( m_itemMarks );
 
-    m_itemFrameText = new QGraphicsTextItem( QString( "000" ) );
+    m_itemFrameText = new Readout( &m_frameTextAtlas, "000" );
     m_itemFrameText->setCacheMode( QGraphicsItem::NoCache );
     m_itemFrameText->setZValue( m_frameTextZ );
-    m_itemFrameText->setTextInteractionFlags( Qt::NoTextInteraction );
-    m_itemFrameText->setDefaultTextColor( m_frameTextColor );
-    m_itemFrameText->setFont( m_frameTextFont );
     m_itemFrameText->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
-    m_itemFrameText->moveBy( m_scaleX * ( m_originalFrameTextCtr.x() - m_itemFrameText->boundingRect().width()  / 2.0f ),
-                            m_scaleY * ( m_originalFrameTextCtr.y() - m_itemFrameText->boundingRect().height() / 2.0f ) );
+    m_originalFrameTextPos = m_originalFrameTextCtr - QPointF( m_itemFrameText->boundingRect().width()  / 2.0f,
+                                                               m_itemFrameText->boundingRect().height() / 2.0f );
+    m_itemFrameText->moveBy( m_scaleX * m_originalFrameTextPos.x(), m_scaleY * m_originalFrameTextPos.y() );
     m_scene->addItem( m_itemFrameText );
 
     update( scaleX, scaleY );
 }
 
+void Pfd::HSI::rescale(const float scaleX, const float scaleY)
+{
+    m_scaleX = scaleX;
+    m_scaleY = scaleY;
+
+    const QTransform scale = QTransform::fromScale( m_scaleX, m_scaleY );
+
+    m_itemBack->setTransform( scale );
+    m_itemBack->setPos( m_scaleX * m_originalBackPos.x(), m_scaleY * m_originalBackPos.y() );
+
+    m_itemFace->setTransform( scale );
+    m_itemFace->setPos( m_scaleX * m_originalFacePos.x(), m_scaleY * m_originalFacePos.y() );
+
+    m_itemMarks->setTransform( scale );
+    m_itemMarks->setPos( m_scaleX * m_originalMarksPos.x(), m_scaleY * m_originalMarksPos.y() );
+
+    m_itemFrameText->setTransform( scale );
+    m_itemFrameText->setPos( m_scaleX * m_originalFrameTextPos.x(), m_scaleY * m_originalFrameTextPos.y() );
+
+    // state is reapplied at the new scale by the next update
+    m_dirty = Instrument::DirtyAll;
+}
+
 void Pfd::HSI::update( float scaleX, float scaleY )
 {
     m_scaleX = scaleX;
     m_scaleY = scaleY;
 
-    updateHeading();
+    if ( m_dirty != Instrument::DirtyNone ) updateHeading();
+
+    m_dirty = Instrument::DirtyNone;
 }
 
 void Pfd::HSI::setHeading( float heading )
 {
+    const float heading_prev = m_heading;
+
     m_heading = heading;
 
     while ( m_heading < 0.0f ) {
@@ -1305,6 +1336,13 @@ void Pfd::HSI::setHeading( float heading )
     while ( m_heading > 360.0f ) {
         m_heading -= 360.0f;
     }
+
+    if ( m_heading != heading_prev ) m_dirty = Instrument::DirtyAll;
+}
+
+void Pfd::HSI::setState(const PfdState& state)
+{
+    setHeading( state.heading );
 }
 
 void Pfd::HSI::reset()
@@ -1315,13 +1353,15 @@ void Pfd::HSI::reset()
     m_itemFrameText = nullptr;
 
     m_heading  = 0.0f;
+
+    m_dirty = Instrument::DirtyAll;
 }
 
 void Pfd::HSI::updateHeading()
 {
     m_itemFace->setRotation( - m_heading );
     const float fHeading{static_cast<float>(floor(m_heading + 0.5f))};
-    m_itemFrameText->setPlainText( QString("%1").arg(fHeading, 3, 'f', 0, QChar('0')) );
+    m_itemFrameText->setNumber( fHeading, 3, 0, '0' );
 }
 
 Pfd::VSI::VSI(QGraphicsScene* scene) : m_scene(scene)
@@ -1336,14 +1376,14 @@ void Pfd::VSI::init(const float scaleX, const float scaleY)
 
     reset();
 
-    m_itemScale = new QGraphicsSvgItem( ":/qfi/images/pfd/pfd_vsi_scale.svg" );
+    m_itemScale = new SvgItem( ":/qfi/images/pfd/pfd_vsi_scale.svg" );
     m_itemScale->setCacheMode( QGraphicsItem::NoCache );
     m_itemScale->setZValue( m_scaleZ );
     m_itemScale->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
     m_itemScale->moveBy( m_scaleX * m_originalScalePos.x(), m_scaleY * m_originalScalePos.y() );
     m_scene->addItem( m_itemScale );
 
-    m_itemArrow = new QGraphicsSvgItem( ":/qfi/images/pfd/pfd_vsi_arrow.svg" );
+    m_itemArrow = new SvgItem( ":/qfi/images/pfd/pfd_vsi_arrow.svg" );
     m_itemArrow->setCacheMode( QGraphicsItem::NoCache );
     m_itemArrow->setZValue( m_arrowZ );
     m_itemArrow->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
@@ -1353,22 +1393,48 @@ void Pfd::VSI::init(const float scaleX, const float scaleY)
     update( scaleX, scaleY );
 }
 
+void Pfd::VSI::rescale(const float scaleX, const float scaleY)
+{
+    m_scaleX = scaleX;
+    m_scaleY = scaleY;
+
+    const QTransform scale = QTransform::fromScale( m_scaleX, m_scaleY );
+
+    m_itemScale->setTransform( scale );
+    m_itemScale->setPos( m_scaleX * m_originalScalePos.x(), m_scaleY * m_originalScalePos.y() );
+
+    m_itemArrow->setTransform( scale );
+    m_itemArrow->setPos( m_scaleX * m_originalArrowPos.x(), m_scaleY * m_originalArrowPos.y() );
+
+    // state is reapplied at the new scale by the next update
+    m_dirty = Instrument::DirtyAll;
+}
+
 void Pfd::VSI::update(const float scaleX, const float scaleY)
 {
     m_scaleX = scaleX;
     m_scaleY = scaleY;
 
-    updateVSI();
+    if ( m_dirty != Instrument::DirtyNone ) updateVSI();
 
-    m_arrowDeltaY_old = m_arrowDeltaY_new;
+    m_dirty = Instrument::DirtyNone;
 }
 
 void Pfd::VSI::setClimbRate(const float climbRate)
 {
+    const float climbRate_prev = m_climbRate;
+
     m_climbRate = climbRate;
 
     if      ( m_climbRate >  6.3f ) m_climbRate =  6.3f;
     else if ( m_climbRate < -6.3f ) m_climbRate = -6.3f;
+
+    if ( m_climbRate != climbRate_prev ) m_dirty = Instrument::DirtyAll;
+}
+
+void Pfd::VSI::setState(const PfdState& state)
+{
+    setClimbRate( state.climbRate );
 }
 
 void Pfd::VSI::reset()
@@ -1378,8 +1444,7 @@ void Pfd::VSI::reset()
 
     m_climbRate = 0.0;
 
-    m_arrowDeltaY_new = 0.0f;
-    m_arrowDeltaY_old = 0.0f;
+    m_dirty = Instrument::DirtyAll;
 }
 
 void Pfd::VSI::updateVSI()
@@ -1396,8 +1461,7 @@ void Pfd::VSI::updateVSI()
     }
 
     if ( m_climbRate < 0.0f ) arrowDeltaY *= -1.0f;
-    m_arrowDeltaY_new = m_scaleY * arrowDeltaY;
-    m_itemArrow->moveBy( 0.0f, m_arrowDeltaY_old - m_arrowDeltaY_new );
+    m_itemArrow->setPos( m_scaleX * m_originalArrowPos.x(), m_scaleY * ( m_originalArrowPos.y() - arrowDeltaY ) );
 }
 
 }
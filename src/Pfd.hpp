@@ -50,6 +50,12 @@
 
 #include <QGraphicsView>
 
+#include "Instrument.hpp"
+#include "Ladder.hpp"
+#include "Readout.hpp"
+#include "Tape.hpp"
+#include "TripleBuffer.hpp"
+
 class QWidget;
 class QResizeEvent;
 class QGraphicsScene;
@@ -57,6 +63,36 @@ class QGraphicsSvgItem;
 
 namespace qfi {
 
+//---------------------------------------------------
+// Struct: PfdState
+// Description: Primary Flight Display state snapshot
+//---------------------------------------------------
+struct PfdState
+{
+    float roll{};                       ///< [deg]
+    float pitch{};                      ///< [deg]
+    float angleOfAttack{};              ///< [deg]
+    float sideslipAngle{};              ///< [deg]
+    bool flightPathVisible{true};
+    float slipSkid{};                   ///< normalized (range from -1.0 to 1.0)
+    float turnRate{};                   ///< normalized (range from -1.0 to 1.0)
+    float barH{};                       ///< normalized (range from -1.0 to 1.0)
+    bool barHVisible{true};
+    float barV{};                       ///< normalized (range from -1.0 to 1.0)
+    bool barVVisible{true};
+    float dotH{};                       ///< normalized (range from -1.0 to 1.0)
+    bool dotHVisible{true};
+    float dotV{};                       ///< normalized (range from -1.0 to 1.0)
+    bool dotVVisible{true};
+    float altitude{};                   ///< dimensionless numeric value
+    float pressure{};                   ///< dimensionless numeric value
+    int pressureUnit{};                 ///< according to Pfd::PressureUnit
+    float airspeed{};                   ///< dimensionless numeric value
+    float machNo{};                     ///< Mach number
+    float heading{};                    ///< [deg]
+    float climbRate{};                  ///< dimensionless numeric value
+};
+
 //---------------------------------------------------
 // Class: Pfd
 // Description: Primary Flight Display widget
@@ -75,6 +111,127 @@ public:
         IN          ///< inches of mercury
     };
 
+private:
+
+    class ADI;
+    class ALT;
+    class ASI;
+    class HSI;
+    class VSI;
+
+public:
+
+    //---------------------------------------------------
+    // Class: Pfd::Renderer
+    // Description: Primary Flight Display headless renderer
+    //---------------------------------------------------
+    class Renderer : public Instrument
+    {
+    public:
+        Renderer();
+        virtual ~Renderer();
+
+        void setRoll(const float roll);
+
+        void setPitch(const float pitch);
+
+        // angle of attack [deg]
+        // angle of sideslip [deg]
+        // flight path marker visibility
+        void setFlightPathMarker(const float aoa, const float sideslip, const bool visible = true );
+
+        // normalized slip or skid (range from -1.0 to 1.0)
+        void setSlipSkid(const float slipSkid);
+
+        //
+        // normalized turn rate (range from -1.0 to 1.0),
+        // hash marks positions are set to be -0.5 and 0.5
+        //
+        void setTurnRate(const float turnRate);
+
+        // normalized horizontal deviation bar position (range from -1.0 to 1.0)
+        // horizontal deviation bar visibility
+        void setBarH(const float barH, const bool visible = true);
+
+        // normalized vertical deviation bar position (range from -1.0 to 1.0)
+        // vertical deviation bar visibility
+        void setBarV(const float barV, const bool visible = true);
+
+        // normalized horizontal deviation dot position (range from -1.0 to 1.0)
+        // horizontal deviation dot visibility
+        void setDotH(const float dotH, const bool visible = true);
+
+        // normalized vertical deviation dot position (range from -1.0 to 1.0)
+        // vertical deviation dot visibility
+        void setDotV(const float dotV, const bool visible = true );
+
+        // altitude (dimensionless numeric value)
+        void setAltitude(const float altitude);
+
+        // pressure (dimensionless numeric value)
+        // pressure unit according to GraphicsPFD::PressureUnit
+        void setPressure(const float pressure, const PressureUnit pressureUnit);
+
+        // airspeed (dimensionless numeric value)
+        void setAirspeed(const float airspeed);
+
+        // Mach number
+        void setMachNo(const float machNo);
+
+        // heading [deg]
+        void setHeading(const float heading);
+
+        // climb rate (dimensionless numeric value)
+        void setClimbRate(const float climbRate);
+
+        // sets all the values at once
+        void setState(const PfdState& state);
+
+        //
+        // publishes state to be applied by the next update(), can be called
+        // from any single producer thread, never blocks nor allocates
+        //
+        void publish(const PfdState& state);
+
+    protected:
+        void init();
+        void rescale();
+        void updateView();
+        void fetchPublished();
+
+    private:
+        enum
+        {
+            DirtyADI = 0x0001,
+            DirtyALT = 0x0002,
+            DirtyASI = 0x0004,
+            DirtyHSI = 0x0008,
+            DirtyVSI = 0x0010
+        };
+
+        void reset();
+
+        ADI* m_adi{};
+        ALT* m_alt{};
+        ASI* m_asi{};
+        HSI* m_hsi{};
+        VSI* m_vsi{};
+
+        QGraphicsSvgItem* m_itemBack{};
+        QGraphicsSvgItem* m_itemMask{};
+
+        TripleBuffer<PfdState> m_published;
+
+        float m_scaleX{1.0f};
+        float m_scaleY{1.0f};
+
+        const int m_originalHeight{300};
+        const int m_originalWidth{300};
+
+        const int m_backZ{};
+        const int m_maskZ{100};
+    };
+
     explicit Pfd(QWidget* parent = nullptr);
     ~Pfd();
 
@@ -84,14 +241,38 @@ public:
     // refreshes (redraws) widget
     void update();
 
+    // enables/disables cached raster mode of the SVG layers
+    void setRasterCache(const bool);
+
+    // sets performance profile of the widget and its renderer
+    void setProfile(const Profile::Type profile);
+
+    // headless renderer of the widget, e.g. to be registered in RenderScheduler
+    inline Renderer* renderer() const { return m_renderer; }
+
+    // sets all the values at once
+    inline void setState(const PfdState& state)
+    {
+        m_renderer->setState( state );
+    }
+
+    //
+    // publishes state to be applied by the next update(), can be called
+    // from any single producer thread, never blocks nor allocates
+    //
+    inline void publish(const PfdState& state)
+    {
+        m_renderer->publish( state );
+    }
+
     inline void setRoll(const float roll)
     {
-        m_adi->setRoll( roll );
+        m_renderer->setRoll( roll );
     }
 
     inline void setPitch(const float pitch)
     {
-        m_adi->setPitch( pitch );
+        m_renderer->setPitch( pitch );
     }
 
     // angle of attack [deg]
@@ -99,13 +280,13 @@ public:
     // flight path marker visibility
     inline void setFlightPathMarker(const float aoa, const float sideslip, const bool visible = true )
     {
-        m_adi->setFlightPathMarker( aoa, sideslip, visible );
+        m_renderer->setFlightPathMarker( aoa, sideslip, visible );
     }
 
     // normalized slip or skid (range from -1.0 to 1.0)
     inline void setSlipSkid(const float slipSkid)
     {
-        m_adi->setSlipSkid( slipSkid );
+        m_renderer->setSlipSkid( slipSkid );
     }
 
     //
@@ -114,75 +295,76 @@ public:
     //
     inline void setTurnRate(const float turnRate)
     {
-        m_adi->setTurnRate( turnRate );
+        m_renderer->setTurnRate( turnRate );
     }
 
     // normalized horizontal deviation bar position (range from -1.0 to 1.0)
     // horizontal deviation bar visibility
     inline void setBarH(const float barH, const bool visible = true)
     {
-        m_adi->setBarH( barH, visible );
+        m_renderer->setBarH( barH, visible );
     }
 
     // normalized vertical deviation bar position (range from -1.0 to 1.0)
     // vertical deviation bar visibility
     inline void setBarV(const float barV, const bool visible = true)
     {
-        m_adi->setBarV( barV, visible );
+        m_renderer->setBarV( barV, visible );
     }
 
     // normalized horizontal deviation dot position (range from -1.0 to 1.0)
     // horizontal deviation dot visibility
     inline void setDotH(const float dotH, const bool visible = true)
     {
-        m_adi->setDotH( dotH, visible );
+        m_renderer->setDotH( dotH, visible );
     }
 
     // normalized vertical deviation dot position (range from -1.0 to 1.0)
     // vertical deviation dot visibility
     inline void setDotV(const float dotV, const bool visible = true )
     {
-        m_adi->setDotV( dotV, visible );
+        m_renderer->setDotV( dotV, visible );
     }
 
     // altitude (dimensionless numeric value)
     inline void setAltitude(const float altitude)
     {
-        m_alt->setAltitude( altitude );
+        m_renderer->setAltitude( altitude );
     }
 
     // pressure (dimensionless numeric value)
     // pressure unit according to GraphicsPFD::PressureUnit
     inline void setPressure(const float pressure, const PressureUnit pressureUnit )
     {
-        m_alt->setPressure( pressure, pressureUnit );
+        m_renderer->setPressure( pressure, pressureUnit );
     }
 
     // airspeed (dimensionless numeric value)
     inline void setAirspeed(const float airspeed)
     {
-        m_asi->setAirspeed( airspeed );
+        m_renderer->setAirspeed( airspeed );
     }
 
     // Mach number
     inline void setMachNo(const float machNo)
     {
-        m_asi->setMachNo( machNo );
+        m_renderer->setMachNo( machNo );
     }
 
     // heading [deg]
     inline void setHeading(const float heading)
     {
-        m_hsi->setHeading( heading );
+        m_renderer->setHeading( heading );
     }
 
     // climb rate (dimensionless numeric value)
     inline void setClimbRate(const float climbRate)
     {
-        m_vsi->setClimbRate( climbRate );
+        m_renderer->setClimbRate( climbRate );
     }
 
 protected:
+    void paintEvent(QPaintEvent*);
     void resizeEvent(QResizeEvent*);
 
 private:
@@ -192,7 +374,9 @@ private:
     public:
         ADI(QGraphicsScene*);
         void init(const float scaleX, const float scaleY);
+        void rescale(const float scaleX, const float scaleY);
         void update(const float scaleX, const float scaleY);
+        inline bool isDirty() const { return m_dirty != Instrument::DirtyNone; }
         void setRoll(const float);
         void setPitch(const float);
         void setFlightPathMarker(const float aoa, const float sideslip, const bool visible = true);
@@ -202,11 +386,22 @@ private:
         void setBarV(const float barV, const bool visible = true);
         void setDotH(const float dotH, const bool visible = true);
         void setDotV(const float dotV, const bool visible = true);
+        void setState(const PfdState& state);
 
     private:
+        enum
+        {
+            DirtyRoll       = 0x0001,
+            DirtyPitch      = 0x0002,
+            DirtyFlightPath = 0x0004,
+            DirtySlipSkid   = 0x0008,
+            DirtyTurnRate   = 0x0010,
+            DirtyBars       = 0x0020,
+            DirtyDots       = 0x0040
+        };
+
         void reset();
-        void updateLadd(const float delta, const float sinRoll, const float cosRoll);
-        void updateLaddBack(const float delta, const float sinRoll, const float cosRoll);
+        void updateLadd();
         void updateRoll();
         void updateSlipSkid(const float sinRoll, const float cosRoll);
         void updateTurnRate();
@@ -216,8 +411,9 @@ private:
 
         QGraphicsScene* m_scene{};
 
-        QGraphicsSvgItem* m_itemBack{};
-        QGraphicsSvgItem* m_itemLadd{};
+        int m_dirty{Instrument::DirtyAll};
+
+        Ladder* m_itemLadd{};
         QGraphicsSvgItem* m_itemRoll{};
         QGraphicsSvgItem* m_itemSlip{};
         QGraphicsSvgItem* m_itemTurn{};
@@ -231,6 +427,12 @@ private:
         QGraphicsSvgItem* m_itemScaleH{};
         QGraphicsSvgItem* m_itemScaleV{};
 
+        QColor m_skyColor{0, 128, 255};
+        QColor m_groundColor{128, 64, 0};
+        QColor m_ladderColor{255, 255, 255};
+
+        QFont m_labelsFont;
+
         float m_roll{};
         float m_pitch{};
         float m_angleOfAttack{};
@@ -250,51 +452,19 @@ private:
         bool m_dotHVisible{true};
         bool m_dotVVisible{true};
 
-        float m_laddDeltaX_new{};
-        float m_laddDeltaX_old{};
-        float m_laddBackDeltaX_new{};
-        float m_laddBackDeltaX_old{};
-        float m_laddBackDeltaY_new{};
-        float m_laddBackDeltaY_old{};
-        float m_laddDeltaY_new{};
-        float m_laddDeltaY_old{};
-        float m_slipDeltaX_new{};
-        float m_slipDeltaX_old{};
-        float m_slipDeltaY_new{};
-        float m_slipDeltaY_old{};
-        float m_turnDeltaX_new{};
-        float m_turnDeltaX_old{};
-        float m_pathDeltaX_new{};
-        float m_pathDeltaX_old{};
-        float m_pathDeltaY_new{};
-        float m_pathDeltaY_old{};
-        float m_markDeltaX_new{};
-        float m_markDeltaX_old{};
-        float m_markDeltaY_new{};
-        float m_markDeltaY_old{};
-        float m_barHDeltaX_new{};
-        float m_barHDeltaX_old{};
-        float m_barVDeltaY_new{};
-        float m_barVDeltaY_old{};
-        float m_dotHDeltaX_new{};
-        float m_dotHDeltaX_old{};
-        float m_dotVDeltaY_new{};
-        float m_dotVDeltaY_old{};
-
         float m_scaleX{1.0f};
         float m_scaleY{1.0f};
 
         const float m_originalPixPerDeg{3.0f};
-        const float m_deltaLaddBack_max{52.5f};
-        const float m_deltaLaddBack_min{-52.5f};
+        const float m_horizonLimit{17.5f};
         const float m_maxSlipDeflection{20.0f};
         const float m_maxTurnDeflection{55.0f};
         const float m_maxBarsDeflection{40.0f};
         const float m_maxDotsDeflection{50.0f};
 
+        QRectF  m_originalWindow{75.0f, 50.0f, 150.0f, 150.0f};
+
         QPointF m_originalAdiCtr{150.0f,   125.0f};
-        QPointF m_originalBackPos{ 45.0f,  -85.0f};
-        QPointF m_originalLaddPos{110.0f, -175.0f};
         QPointF m_originalRollPos{ 45.0f,   20.0f};
         QPointF m_originalSlipPos{145.5f,   68.5f};
         QPointF m_originalTurnPos{142.5f,  206.0f};
@@ -306,7 +476,6 @@ private:
         QPointF m_originalScaleHPos{0.0f,    0.0f};
         QPointF m_originalScaleVPos{0.0f,    0.0f};
 
-        const int m_backZ{10};
         const int m_laddZ{20};
         const int m_rollZ{30};
         const int m_slipZ{40};
@@ -323,29 +492,35 @@ private:
     public:
         ALT(QGraphicsScene*);
         void init(const float scaleX, const float scaleY);
+        void rescale(const float scaleX, const float scaleY);
         void update(const float scaleX, const float scaleY);
+        inline bool isDirty() const { return m_dirty != Instrument::DirtyNone; }
         void setAltitude(const float);
         void setPressure(const float pressure, const int pressureUnit);
+        void setState(const PfdState& state);
 
     private:
+        enum
+        {
+            DirtyAltitude = 0x0001,
+            DirtyPressure = 0x0002
+        };
+
         void reset();
         void updateAltitude();
         void updatePressure();
         void updateScale();
-        void updateScaleLabels();
 
         QGraphicsScene* m_scene{};
 
+        int m_dirty{Instrument::DirtyAll};
+
         QGraphicsSvgItem* m_itemBack{};
-        QGraphicsSvgItem* m_itemScale1{};
-        QGraphicsSvgItem* m_itemScale2{};
-        QGraphicsTextItem* m_itemLabel1{};
-        QGraphicsTextItem* m_itemLabel2{};
-        QGraphicsTextItem* m_itemLabel3{};
+        Tape* m_itemTape{};
         QGraphicsSvgItem* m_itemGround{};
         QGraphicsSvgItem* m_itemFrame{};
-        QGraphicsTextItem* m_itemAltitude{};
-        QGraphicsTextItem* m_itemPressure{};
+        Readout* m_itemAltitude{};
+        Readout* m_itemPressure{};
 
         QColor m_frameTextColor{255, 255, 255};
         QColor m_pressTextColor{  0, 255,   0};
@@ -354,41 +529,39 @@ private:
         QFont m_frameTextFont;
         QFont m_labelsFont;
 
+        GlyphAtlas m_frameTextAtlas;
+        GlyphAtlas m_pressTextAtlas;
+
         float m_altitude{};
         float m_pressure{};
 
         int m_pressureUnit{};
 
-        float m_scale1DeltaY_new{};
-        float m_scale1DeltaY_old{};
-        float m_scale2DeltaY_new{};
-        float m_scale2DeltaY_old{};
-        float m_groundDeltaY_new{};
-        float m_groundDeltaY_old{};
-        float m_labelsDeltaY_new{};
-        float m_labelsDeltaY_old{};
-
         float m_scaleX{1.0};
         float m_scaleY{1.0};
 
+        const float m_minAltitude{-9999.0f};
+        const float m_maxAltitude{99999.0f};
+
         const float m_originalPixPerAlt{0.150f};
-        const float m_originalScaleHeight{300.0f};
+        const float m_originalTicksStep{100.0f};
+        const float m_originalLabelsStep{500.0f};
         const float m_originalLabelsX{250.0f};
-        const float m_originalLabel1Y{50.0f};
-        const float m_originalLabel2Y{125.0f};
-        const float m_originalLabel3Y{200.0f};
+        const float m_originalReferenceY{125.0f};
+
+        QRectF  m_originalTapeWindow{231.0f, 37.5f, 40.0f, 175.0f};
+        QRectF  m_originalTick{231.0f, -0.5f, 5.0f, 1.0f};
 
         QPointF m_originalBackPos{231.0f, 37.5f};
-        QPointF m_originalScale1Pos{231.0f, -174.5f};
-        QPointF m_originalScale2Pos{231.0f, -474.5f};
         QPointF m_originalGroundPos{231.5f,  124.5f};
         QPointF m_originalFramePos{225.0f, 110.0f};
         QPointF m_originalAltitudeCtr{254.0f, 126.0f};
+        QPointF m_originalAltitudePos;      ///< readout top left corner, set on init
         QPointF m_originalPressureCtr{254.0f, 225.0f};
+        QPointF m_originalPressurePos;      ///< readout top left corner, set on init
 
         const int m_backZ{70};
-        const int m_scaleZ{77};
-        const int m_labelsZ{78};
+        const int m_tapeZ{77};
         const int m_groundZ{79};
         const int m_frameZ{110};
         const int m_frameTextZ{120};
@@ -399,31 +572,34 @@ private:
     public:
         ASI(QGraphicsScene*);
         void init(const float scaleX, const float scaleY);
+        void rescale(const float scaleX, const float scaleY);
         void update(const float scaleX, const float scaleY);
+        inline bool isDirty() const { return m_dirty != Instrument::DirtyNone; }
         void setAirspeed(const float);
         void setMachNo(const float);
+        void setState(const PfdState& state);
 
     private:
+        enum
+        {
+            DirtyAirspeed = 0x0001,
+            DirtyMachNo   = 0x0002
+        };
+
         void reset();
         void updateAirspeed();
+        void updateMachNo();
         void updateScale();
-        void updateScaleLabels();
 
         QGraphicsScene* m_scene{};
 
+        int m_dirty{Instrument::DirtyAll};
+
         QGraphicsSvgItem* m_itemBack{};
-        QGraphicsSvgItem* m_itemScale1{};
-        QGraphicsSvgItem* m_itemScale2{};
-        QGraphicsTextItem* m_itemLabel1{};
-        QGraphicsTextItem* m_itemLabel2{};
-        QGraphicsTextItem* m_itemLabel3{};
-        QGraphicsTextItem* m_itemLabel4{};
-        QGraphicsTextItem* m_itemLabel5{};
-        QGraphicsTextItem* m_itemLabel6{};
-        QGraphicsTextItem* m_itemLabel7{};
+        Tape* m_itemTape{};
         QGraphicsSvgItem* m_itemFrame{};
-        QGraphicsTextItem* m_itemAirspeed{};
-        QGraphicsTextItem* m_itemMachNo{};
+        Readout* m_itemAirspeed{};
+        Readout* m_itemMachNo{};
 
         QColor m_frameTextColor{255, 255, 255};
         QColor m_labelsColor{255, 255, 255};
@@ -431,40 +607,34 @@ private:
         QFont m_frameTextFont{};
         QFont m_labelsFont{};
 
+        GlyphAtlas m_frameTextAtlas;
+
         float m_airspeed{};
         float m_machNo{};
 
-        float m_scale1DeltaY_new{};
-        float m_scale1DeltaY_old{};
-        float m_scale2DeltaY_new{};
-        float m_scale2DeltaY_old{};
-        float m_labelsDeltaY_new{};
-        float m_labelsDeltaY_old{};
-
         float m_scaleX{1.0f};
         float m_scaleY{1.0f};
 
+        const float m_maxAirspeed{9999.0f};
+
         const float m_originalPixPerSpd{1.5f};
-        const float m_originalScaleHeight{300.0f};
+        const float m_originalTicksStep{10.0f};
+        const float m_originalLabelsStep{20.0f};
         const float m_originalLabelsX{43.0f};
-        const float m_originalLabel1Y{35.0f};
-        const float m_originalLabel2Y{65.0f};
-        const float m_originalLabel3Y{95.0f};
-        const float m_originalLabel4Y{125.0f};
-        const float m_originalLabel5Y{155.0f};
-        const float m_originalLabel6Y{185.0f};
-        const float m_originalLabel7Y{215.0f};
+        const float m_originalReferenceY{125.0f};
+
+        QRectF  m_originalTapeWindow{25.0f, 37.5f, 36.0f, 175.0f};
+        QRectF  m_originalTick{56.0f, -0.5f, 5.0f, 1.0f};
 
         QPointF m_originalBackPos{25.0f, 37.5f};
-        QPointF m_originalScale1Pos{56.0f, -174.5f};
-        QPointF m_originalScale2Pos{56.0f, -474.5f};
         QPointF m_originalFramePos{0.0f, 110.0f};
         QPointF m_originalAirspeedCtr{40.0f, 126.0f};
+        QPointF m_originalAirspeedPos;      ///< readout top left corner, set on init
         QPointF m_originalMachNoCtr{43.0f, 225.0f};
+        QPointF m_originalMachNoPos;        ///< readout top left corner, set on init
 
         const int m_backZ{70};
-        const int m_scaleZ{80};
-        const int m_labelsZ{90};
+        const int m_tapeZ{80};
         const int m_frameZ{110};
         const int m_frameTextZ{120};
     };
@@ -474,8 +644,11 @@ private:
     public:
         HSI(QGraphicsScene*);
         void init(const float scaleX, const float scaleY);
+        void rescale(const float scaleX, const float scaleY);
         void update(const float scaleX, const float scaleY);
+        inline bool isDirty() const { return m_dirty != Instrument::DirtyNone; }
         void setHeading(const float);
+        void setState(const PfdState& state);
 
     private:
         void reset();
@@ -483,15 +656,19 @@ private:
 
         QGraphicsScene* m_scene{};
 
+        int m_dirty{Instrument::DirtyAll};
+
         QGraphicsSvgItem* m_itemBack{};
         QGraphicsSvgItem* m_itemFace{};
         QGraphicsSvgItem* m_itemMarks{};
-        QGraphicsTextItem* m_itemFrameText{};
+        Readout* m_itemFrameText{};
 
         QColor m_frameTextColor{255, 255, 255};
 
         QFont m_frameTextFont{};
 
+        GlyphAtlas m_frameTextAtlas;
+
         float m_heading{};
 
         float m_scaleX{1.0f};
@@ -502,6 +679,7 @@ private:
         QPointF m_originalFacePos{45.0f, 240.0f};
         QPointF m_originalMarksPos{134.0f, 219.0f};
         QPointF m_originalFrameTextCtr{149.5f, 227.5f};
+        QPointF m_originalFrameTextPos;     ///< readout top left corner, set on init
 
         const int m_backZ{80};
         const int m_faceZ{90};
@@ -514,8 +692,11 @@ private:
     public:
         VSI(QGraphicsScene*);
         void init(const float scaleX, const float scaleY);
+        void rescale(const float scaleX, const float scaleY);
         void update(const float scaleX, const float scaleY);
+        inline bool isDirty() const { return m_dirty != Instrument::DirtyNone; }
         void setClimbRate(const float);
+        void setState(const PfdState& state);
 
     private:
         void reset();
@@ -523,14 +704,13 @@ private:
 
         QGraphicsScene* m_scene{};
 
+        int m_dirty{Instrument::DirtyAll};
+
         QGraphicsSvgItem* m_itemScale{};
         QGraphicsSvgItem* m_itemArrow{};
 
         float m_climbRate{};
 
-        float m_arrowDeltaY_new{};
-        float m_arrowDeltaY_old{};
-
         float m_scaleX{1.0f};
         float m_scaleY{1.0f};
 
@@ -546,29 +726,7 @@ private:
         const int m_arrowZ{80};
     };
 
-    void init();
-    void reset();
-    void updateView();
-
-    QGraphicsScene* m_scene{};
-
-    ADI* m_adi{};
-    ALT* m_alt{};
-    ASI* m_asi{};
-    HSI* m_hsi{};
-    VSI* m_vsi{};
-
-    QGraphicsSvgItem* m_itemBack{};
-    QGraphicsSvgItem* m_itemMask{};
-
-    float m_scaleX{1.0f};
-    float m_scaleY{1.0f};
-
-    const int m_originalHeight{300};
-    const int m_originalWidth{300};
-
-    const int m_backZ{};
-    const int m_maskZ{100};
+    Renderer* m_renderer{};
 };
 
 }
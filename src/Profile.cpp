@@ -0,0 +1,127 @@
+/***************************************************************************//**
+ * @file Profile.cpp
+ * @author  Marek M. Cel <marekcel@marekcel.pl>
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * This file is part of QFlightInstruments. You can redistribute and modify it
+ * under the terms of GNU General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.
+ * 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ *
+ * Further information about the GNU General Public License can also be found
+ * on the world wide web at http://www.gnu.org.
+ *
+ * ---
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include "Profile.hpp"
+
+namespace qfi {
+
+void Profile::apply(QGraphicsView* view, const Type profile)
+{
+    view->setViewportUpdateMode( viewportUpdateMode( profile ) );
+    view->setOptimizationFlags( optimizationFlags( profile ) );
+    view->setRenderHints( renderHints( profile ) );
+}
+
+QGraphicsScene::ItemIndexMethod Profile::itemIndexMethod(const Type profile)
+{
+    //
+    // instruments hold a handful of items, most of them moved or rotated
+    // every frame, so maintaining the BSP tree costs more than finding
+    // the items to draw by checking all of them
+    //
+    return profile == Quality ? QGraphicsScene::BspTreeIndex : QGraphicsScene::NoIndex;
+}
+
+QGraphicsView::ViewportUpdateMode Profile::viewportUpdateMode(const Type profile)
+{
+    //
+    // bounding rect update avoids computing the exposed region of
+    // the many small changes of a frame, minimal update repaints
+    // the least pixels
+    //
+    return profile == Throughput ? QGraphicsView::BoundingRectViewportUpdate
+                                 : QGraphicsView::MinimalViewportUpdate;
+}
+
+QGraphicsView::OptimizationFlags Profile::optimizationFlags(const Type profile)
+{
+    // all the qfi items restore the painter state they change themselves
+    if ( profile == Quality ) return QGraphicsView::OptimizationFlags();
+
+    return QGraphicsView::DontSavePainterState | QGraphicsView::DontAdjustForAntialiasing;
+}
+
+QPainter::RenderHints Profile::renderHints(const Type profile)
+{
+    // QGraphicsView default hints, the instruments have always been drawn with them
+    if ( profile == LowPower ) return QPainter::RenderHints();
+
+    return QPainter::TextAntialiasing;
+}
+
+bool Profile::rasterCache(const Type profile)
+{
+    return profile != Quality;
+}
+
+QString Profile::name(const Type profile)
+{
+    switch ( profile )
+    {
+    case Quality:    return "quality";
+    case Throughput: return "throughput";
+    case LowPower:   return "low-power";
+    }
+
+    return QString();
+}
+
+Profile::Type Profile::fromName(const QString& name, bool* ok)
+{
+    if ( ok ) *ok = true;
+
+    if ( name == "quality"    ) return Quality;
+    if ( name == "throughput" ) return Throughput;
+    if ( name == "low-power"  ) return LowPower;
+
+    if ( ok ) *ok = false;
+
+    return Quality;
+}
+
+}
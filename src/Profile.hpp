@@ -0,0 +1,105 @@
+/***************************************************************************//**
+ * @file Profile.h
+ * @author  Marek M. Cel <marekcel@marekcel.pl>
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * This file is part of QFlightInstruments. You can redistribute and modify it
+ * under the terms of GNU General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.
+ * 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ *
+ * Further information about the GNU General Public License can also be found
+ * on the world wide web at http://www.gnu.org.
+ *
+ * ---
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef __qfi_Profile_H__
+#define __qfi_Profile_H__
+
+#include <QGraphicsScene>
+#include <QGraphicsView>
+#include <QPainter>
+#include <QString>
+
+namespace qfi {
+
+//---------------------------------------------------
+// Class: Profile
+// Description: Performance profiles, each profile configures the scene
+// index, the view update mode, optimization flags and render hints and
+// the layers cache mode together
+//---------------------------------------------------
+class Profile
+{
+public:
+
+    enum Type
+    {
+        Quality = 0,                    ///< BSP index, minimal updates, default view render hints, vector layers (default)
+        Throughput,                     ///< no index, bounding rect updates, no painter state saving, cached layers
+        LowPower                        ///< no index, minimal updates, no painter state saving, no text antialiasing, cached layers
+    };
+
+    // applies view part of the profile (update mode, optimization flags, render hints)
+    static void apply(QGraphicsView* view, const Type profile);
+
+    // scene item index method of the profile
+    static QGraphicsScene::ItemIndexMethod itemIndexMethod(const Type profile);
+
+    // view viewport update mode of the profile
+    static QGraphicsView::ViewportUpdateMode viewportUpdateMode(const Type profile);
+
+    // view optimization flags of the profile
+    static QGraphicsView::OptimizationFlags optimizationFlags(const Type profile);
+
+    // render hints of the profile, also used by the headless rendering
+    static QPainter::RenderHints renderHints(const Type profile);
+
+    // returns true if the profile draws the SVG layers in cached raster mode
+    static bool rasterCache(const Type profile);
+
+    // profile name: "quality", "throughput" or "low-power"
+    static QString name(const Type profile);
+
+    //
+    // returns profile of the given name, ok (if given) is set to false
+    // and Quality is returned if the name is unknown
+    //
+    static Type fromName(const QString& name, bool* ok = nullptr);
+};
+
+}
+
+#endif
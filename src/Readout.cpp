@@ -0,0 +1,189 @@
+/***************************************************************************//**
+ * @file Readout.cpp
+ * @author  Marek M. Cel <marekcel@marekcel.pl>
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * This file is part of QFlightInstruments. You can redistribute and modify it
+ * under the terms of GNU General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.
+ * 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ *
+ * Further information about the GNU General Public License can also be found
+ * on the world wide web at http://www.gnu.org.
+ *
+ * ---
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include "Readout.hpp"
+
+#include <QPainter>
+
+#include <cmath>
+#include <cstring>
+
+#include "SvgItem.hpp"
+
+namespace qfi {
+
+Readout::Readout(GlyphAtlas* atlas, const char* text, QGraphicsItem* parent) :
+    QGraphicsItem(parent),
+    m_atlas(atlas)
+{
+    m_text[ 0 ] = '\0';
+    setText( text );
+}
+
+void Readout::setText(const char* text)
+{
+    if ( std::strncmp( m_text, text, m_capacity - 1 ) == 0 ) return;
+
+    std::strncpy( m_text, text, m_capacity - 1 );
+    m_text[ m_capacity - 1 ] = '\0';
+    m_length = static_cast<int>( std::strlen( m_text ) );
+
+    qreal width = 0.0;
+
+    for ( int i = 0; i < m_length; ++i ) width += m_atlas->advance( m_text[ i ] );
+
+    if ( width != m_width ) {
+        prepareGeometryChange();
+        m_width = width;
+    } else {
+        update();
+    }
+}
+
+void Readout::setNumber(const float value, const int width, const int precision,
+                        const char fill, const char* prefix, const char* suffix)
+{
+    char text[ m_capacity ];
+    int length = 0;
+
+    for ( const char* c = prefix; *c && length < m_capacity - 1; ++c ) text[ length++ ] = *c;
+
+    length += format( text + length, m_capacity - length, value, width, precision, fill );
+
+    for ( const char* c = suffix; *c && length < m_capacity - 1; ++c ) text[ length++ ] = *c;
+
+    text[ length ] = '\0';
+
+    setText( text );
+}
+
+int Readout::format(char* buffer, const int size, const float value,
+                    const int width, const int precision, const char fill)
+{
+    char digits[ 32 ];
+    int count = 0;
+
+    double scaled = std::fabs( static_cast<double>( value ) );
+
+    for ( int i = 0; i < precision; ++i ) scaled *= 10.0;
+
+    // also catches NaN
+    if ( !( scaled < 1.0e15 ) ) scaled = 0.0;
+
+    unsigned long long number = static_cast<unsigned long long>( scaled + 0.5 );
+
+    const bool negative = value < 0.0f && number > 0;
+
+    // fraction digits, point and at least one integer digit, in reverse order
+    const int minCount = precision > 0 ? precision + 2 : 1;
+
+    do {
+        digits[ count++ ] = static_cast<char>( '0' + number % 10 );
+        number /= 10;
+
+        if ( precision > 0 && count == precision ) digits[ count++ ] = '.';
+    }
+    while ( ( number > 0 || count < minCount ) && count < 30 );
+
+    const int padding = qMax( 0, width - count - ( negative ? 1 : 0 ) );
+
+    int length = 0;
+
+    auto put = [ buffer, size, &length ]( const char c )
+    {
+        if ( length < size - 1 ) buffer[ length++ ] = c;
+    };
+
+    // zeros are padded after the sign, spaces before
+    if ( fill == '0' ) {
+        if ( negative ) put( '-' );
+        for ( int i = 0; i < padding; ++i ) put( '0' );
+    } else {
+        for ( int i = 0; i < padding; ++i ) put( fill );
+        if ( negative ) put( '-' );
+    }
+
+    while ( count > 0 ) put( digits[ --count ] );
+
+    if ( size > 0 ) buffer[ length ] = '\0';
+
+    return length;
+}
+
+QRectF Readout::boundingRect() const
+{
+    return QRectF( 0.0, 0.0, m_width + 2.0 * m_margin, m_atlas->height() + 2.0 * m_margin );
+}
+
+void Readout::paint(QPainter* painter, const QStyleOptionGraphicsItem*, QWidget*)
+{
+    // glyphs are rendered at the device scale
+    const QSizeF scale = SvgItem::deviceScale( painter );
+    const qreal sx = scale.width();
+    const qreal sy = scale.height();
+
+    m_atlas->prepare( sx, sy );
+
+    if ( m_atlas->image().isNull() ) return;
+
+    qreal x = m_margin;
+
+    for ( int i = 0; i < m_length; ++i ) {
+        const int index = m_atlas->index( m_text[ i ] );
+        const qreal advance = m_atlas->advance( m_text[ i ] );
+
+        if ( index >= 0 ) {
+            painter->drawImage( QRectF( x, m_margin, advance, m_atlas->height() ),
+                                m_atlas->image(), m_atlas->source( index ) );
+        }
+
+        x += advance;
+    }
+}
+
+}
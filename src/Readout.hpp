@@ -0,0 +1,121 @@
+/***************************************************************************//**
+ * @file Readout.h
+ * @author  Marek M. Cel <marekcel@marekcel.pl>
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * This file is part of QFlightInstruments. You can redistribute and modify it
+ * under the terms of GNU General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.
+ * 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ *
+ * Further information about the GNU General Public License can also be found
+ * on the world wide web at http://www.gnu.org.
+ *
+ * ---
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef __qfi_Readout_H__
+#define __qfi_Readout_H__
+
+#include <QGraphicsItem>
+
+#include "GlyphAtlas.hpp"
+
+class QPainter;
+class QStyleOptionGraphicsItem;
+class QWidget;
+
+namespace qfi {
+
+//---------------------------------------------------
+// Class: Readout
+// Description: Single line numeric readout drawn from a glyph atlas,
+// laid out as QGraphicsTextItem with the same font would be, setting
+// text never allocates
+//---------------------------------------------------
+class Readout : public QGraphicsItem
+{
+public:
+
+    enum { Type = UserType + 2 };
+
+    // the atlas has to outlive the readout, it can be shared by readouts
+    Readout(GlyphAtlas* atlas, const char* text, QGraphicsItem* parent = nullptr);
+
+    // sets text, longer text is truncated, nothing is done if it has not changed
+    void setText(const char* text);
+
+    //
+    // sets number formatted as QString::arg(value, width, 'f', precision, fill)
+    // between the prefix and the suffix
+    //
+    void setNumber(const float value, const int width, const int precision,
+                   const char fill = ' ', const char* prefix = "",
+                   const char* suffix = "");
+
+    //
+    // formats number into the buffer as QString::arg(value, width, 'f',
+    // precision, fill) would, always in the C locale, returns text length
+    //
+    static int format(char* buffer, const int size, const float value,
+                      const int width, const int precision, const char fill = ' ');
+
+    inline const char* text() const { return m_text; }
+
+    QRectF boundingRect() const;
+
+    int type() const
+    {
+        return Type;
+    }
+
+    void paint(QPainter*, const QStyleOptionGraphicsItem*, QWidget* = nullptr);
+
+private:
+
+    static const int m_capacity{16};
+
+    GlyphAtlas* m_atlas{};
+
+    char m_text[m_capacity];
+    int m_length{};
+
+    qreal m_width{};                    ///< text advance
+
+    const qreal m_margin{4.0};          ///< QTextDocument default margin
+};
+
+}
+
+#endif
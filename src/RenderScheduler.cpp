@@ -0,0 +1,167 @@
+/***************************************************************************//**
+ * @file RenderScheduler.cpp
+ * @author  Marek M. Cel <marekcel@marekcel.pl>
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * This file is part of QFlightInstruments. You can redistribute and modify it
+ * under the terms of GNU General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.
+ * 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ *
+ * Further information about the GNU General Public License can also be found
+ * on the world wide web at http://www.gnu.org.
+ *
+ * ---
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include "RenderScheduler.hpp"
+
+#include <QGuiApplication>
+#include <QMetaObject>
+#include <QScreen>
+
+#include "Instrument.hpp"
+
+namespace qfi {
+
+RenderScheduler::RenderScheduler(QObject* parent)
+    : QObject(parent)
+{
+    m_timer.setSingleShot( true );
+    m_timer.setTimerType( Qt::PreciseTimer );
+
+    connect( &m_timer, &QTimer::timeout, this, &RenderScheduler::tick );
+
+    m_clock.start();
+
+    setFrameRate( 0.0 );
+}
+
+RenderScheduler::~RenderScheduler()
+{
+    m_timer.stop();
+}
+
+void RenderScheduler::add(Instrument* instrument)
+{
+    if ( instrument && !m_instruments.contains( instrument ) ) {
+        m_instruments.push_back( instrument );
+        requestUpdate();
+    }
+}
+
+void RenderScheduler::remove(Instrument* instrument)
+{
+    m_instruments.removeAll( instrument );
+}
+
+void RenderScheduler::setFrameRate(const double frameRate)
+{
+    m_frameRate = frameRate > 0.0 ? frameRate : 0.0;
+    m_period = static_cast<qint64>( 1.0e9 / this->frameRate() );
+}
+
+double RenderScheduler::frameRate() const
+{
+    if ( m_frameRate > 0.0 ) return m_frameRate;
+
+    const QScreen* screen = QGuiApplication::primaryScreen();
+
+    if ( screen && screen->refreshRate() > 0.0 ) return screen->refreshRate();
+
+    return 60.0;
+}
+
+void RenderScheduler::resetCounters()
+{
+    m_frames = 0;
+    m_missed = 0;
+}
+
+void RenderScheduler::requestUpdate()
+{
+    // only the first request of a frame wakes the scheduler
+    if ( m_requested.fetchAndStoreOrdered( 1 ) == 0 ) {
+        QMetaObject::invokeMethod( this, "wake", Qt::QueuedConnection );
+    }
+}
+
+void RenderScheduler::wake()
+{
+    if ( !m_timer.isActive() ) {
+        // after idling the next tick is due right away and steps by one
+        // period, as if the scheduler had been ticking all along
+        m_deadline = m_clock.nsecsElapsed();
+        m_lastTick = m_deadline - m_period;
+        m_timer.start( 0 );
+    }
+}
+
+void RenderScheduler::tick()
+{
+    const qint64 now = m_clock.nsecsElapsed();
+
+    if ( now - m_deadline >= m_period ) {
+        const qint64 missed = ( now - m_deadline ) / m_period;
+        m_missed   += missed;
+        m_deadline += missed * m_period;
+    }
+
+    // requests made from now on are served by the next tick
+    m_requested.storeRelease( 0 );
+
+    const double timeStep = 1.0e-9 * ( now - m_lastTick );
+    m_lastTick = now;
+
+    emit frame( timeStep );
+
+    bool refreshed = false;
+
+    for ( Instrument* instrument : m_instruments ) {
+        if ( instrument->update() ) refreshed = true;
+    }
+
+    m_frames++;
+    m_deadline += m_period;
+
+    // nothing changed and nothing requested, the scheduler stays idle
+    // until the next request
+    if ( refreshed || m_requested.loadAcquire() != 0 ) {
+        const qint64 remaining = m_deadline - m_clock.nsecsElapsed();
+        m_timer.start( remaining > 0 ? static_cast<int>( ( remaining + 500000 ) / 1000000 ) : 0 );
+    }
+}
+
+}
@@ -0,0 +1,151 @@
+/***************************************************************************//**
+ * @file RenderScheduler.h
+ * @author  Marek M. Cel <marekcel@marekcel.pl>
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * This file is part of QFlightInstruments. You can redistribute and modify it
+ * under the terms of GNU General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.
+ * 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ *
+ * Further information about the GNU General Public License can also be found
+ * on the world wide web at http://www.gnu.org.
+ *
+ * ---
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef __qfi_RenderScheduler_H__
+#define __qfi_RenderScheduler_H__
+
+#include <QAtomicInt>
+#include <QElapsedTimer>
+#include <QObject>
+#include <QTimer>
+#include <QVector>
+
+namespace qfi {
+
+class Instrument;
+
+//---------------------------------------------------
+// Class: RenderScheduler
+// Description: Frame-paced refresh of the registered instruments, all
+// the update requests made within a frame period are coalesced into
+// a single tick and the scheduler stops ticking while nothing changes
+//---------------------------------------------------
+class RenderScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    explicit RenderScheduler(QObject* parent = nullptr);
+    virtual ~RenderScheduler();
+
+    // registers instrument to be refreshed on every tick
+    void add(Instrument* instrument);
+
+    // unregisters instrument
+    void remove(Instrument* instrument);
+
+    //
+    // sets target frame rate [Hz], 0 (default) paces frames to the refresh
+    // rate of the primary screen
+    //
+    void setFrameRate(const double frameRate);
+
+    // returns effective target frame rate [Hz]
+    double frameRate() const;
+
+    // number of ticks since the last counters reset
+    inline quint64 frames() const { return m_frames; }
+
+    //
+    // number of frame deadlines missed since the last counters reset,
+    // a tick later than its deadline by n whole frame periods counts
+    // as n missed deadlines
+    //
+    inline quint64 missed() const { return m_missed; }
+
+    // returns true if the scheduler stopped ticking as nothing changed
+    inline bool isIdle() const { return !m_timer.isActive(); }
+
+    // resets frames and missed deadlines counters
+    void resetCounters();
+
+public slots:
+
+    //
+    // requests a tick, can be called from any thread (e.g. after publishing
+    // state), requests made before the next tick are coalesced into it
+    //
+    void requestUpdate();
+
+signals:
+
+    //
+    // emitted at the beginning of each tick before the instruments are
+    // refreshed, it is the place to set the instruments state
+    // timeStep [s] time elapsed since the previous tick, idle time is
+    // never included: the first tick after idling steps by one period
+    //
+    void frame(double timeStep);
+
+private slots:
+
+    void wake();
+    void tick();
+
+private:
+
+    QVector<Instrument*> m_instruments;
+
+    QTimer m_timer;
+    QElapsedTimer m_clock;
+
+    QAtomicInt m_requested;
+
+    double m_frameRate{};               ///< [Hz] 0 means screen refresh rate
+
+    qint64 m_period{};                  ///< [ns]
+    qint64 m_deadline{};                ///< [ns]
+    qint64 m_lastTick{};                ///< [ns]
+
+    quint64 m_frames{};
+    quint64 m_missed{};
+};
+
+}
+
+#endif
@@ -0,0 +1,226 @@
+/***************************************************************************//**
+ * @file SpriteCache.cpp
+ * @author  Marek M. Cel <marekcel@marekcel.pl>
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * This file is part of QFlightInstruments. You can redistribute and modify it
+ * under the terms of GNU General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.
+ * 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ *
+ * Further information about the GNU General Public License can also be found
+ * on the world wide web at http://www.gnu.org.
+ *
+ * ---
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include "SpriteCache.hpp"
+
+#include <QMutexLocker>
+#include <QPainter>
+#include <QSvgRenderer>
+#include <QTransform>
+
+#include <cmath>
+
+namespace qfi {
+
+SpriteCache::Sprite SpriteCache::sprite(QSvgRenderer* renderer, const QString& fileName,
+                                        const QRectF& bounds, const qreal angle,
+                                        const qreal scaleX, const qreal scaleY)
+{
+    SpriteCache* cache = instance();
+
+    Key key;
+    key.fileName = fileName;
+    key.width    = qRound( bounds.width()  * scaleX );
+    key.height   = qRound( bounds.height() * scaleY );
+
+    qreal quantum = 0.0;
+
+    {
+        QMutexLocker locker( &cache->m_mutex );
+
+        quantum = cache->m_quantum;
+
+        // full turn wraps around so that -180 and 180 deg share the sprite
+        const int steps = qMax( 1, qRound( 360.0 / quantum ) );
+        key.step = ( qRound( angle / quantum ) % steps + steps ) % steps;
+
+        const Sprite* sprite = cache->m_sprites.object( key );
+
+        if ( sprite ) {
+            cache->m_hits++;
+            return *sprite;
+        }
+
+        cache->m_misses++;
+    }
+
+    // rendered outside of the lock, renderers are not shared between threads
+    QTransform transform;
+    transform.scale( scaleX, scaleY );
+    transform.rotate( key.step * quantum );
+
+    const QRectF rect = transform.mapRect( bounds );
+
+    Sprite* sprite = new Sprite();
+    sprite->offset = rect.topLeft();
+    sprite->angle  = key.step * quantum;
+
+    const QSize size( static_cast<int>( std::ceil( rect.width() ) ),
+                      static_cast<int>( std::ceil( rect.height() ) ) );
+
+    if ( !size.isEmpty() ) {
+        sprite->image = QImage( size, QImage::Format_ARGB32_Premultiplied );
+        sprite->image.fill( Qt::transparent );
+
+        QPainter painter( &sprite->image );
+        painter.setRenderHints( QPainter::Antialiasing | QPainter::SmoothPixmapTransform );
+        painter.setTransform( transform * QTransform::fromTranslate( -rect.left(), -rect.top() ) );
+        renderer->render( &painter, bounds );
+    }
+
+    const Sprite result = *sprite;
+
+    QMutexLocker locker( &cache->m_mutex );
+
+    // sprites rendered for a former quantum are dropped, too large ones are deleted by insert()
+    if ( quantum == cache->m_quantum ) {
+        cache->m_sprites.insert( key, sprite, qMax( 1, sprite->image.bytesPerLine() * sprite->image.height() ) );
+    } else {
+        delete sprite;
+    }
+
+    return result;
+}
+
+void SpriteCache::setQuantum(const qreal quantum)
+{
+    SpriteCache* cache = instance();
+    QMutexLocker locker( &cache->m_mutex );
+
+    if ( quantum <= 0.0 || quantum == cache->m_quantum ) return;
+
+    cache->m_quantum = quantum;
+    cache->m_sprites.clear();
+}
+
+qreal SpriteCache::quantum()
+{
+    SpriteCache* cache = instance();
+    QMutexLocker locker( &cache->m_mutex );
+    return cache->m_quantum;
+}
+
+void SpriteCache::setBudget(const int budget)
+{
+    SpriteCache* cache = instance();
+    QMutexLocker locker( &cache->m_mutex );
+    cache->m_sprites.setMaxCost( budget );
+}
+
+int SpriteCache::budget()
+{
+    SpriteCache* cache = instance();
+    QMutexLocker locker( &cache->m_mutex );
+    return cache->m_sprites.maxCost();
+}
+
+void SpriteCache::clear()
+{
+    SpriteCache* cache = instance();
+    QMutexLocker locker( &cache->m_mutex );
+    cache->m_sprites.clear();
+}
+
+int SpriteCache::hits()
+{
+    SpriteCache* cache = instance();
+    QMutexLocker locker( &cache->m_mutex );
+    return cache->m_hits;
+}
+
+int SpriteCache::misses()
+{
+    SpriteCache* cache = instance();
+    QMutexLocker locker( &cache->m_mutex );
+    return cache->m_misses;
+}
+
+double SpriteCache::hitRate()
+{
+    SpriteCache* cache = instance();
+    QMutexLocker locker( &cache->m_mutex );
+
+    const int requests = cache->m_hits + cache->m_misses;
+
+    return requests > 0 ? static_cast<double>( cache->m_hits ) / requests : 0.0;
+}
+
+int SpriteCache::size()
+{
+    SpriteCache* cache = instance();
+    QMutexLocker locker( &cache->m_mutex );
+    return cache->m_sprites.size();
+}
+
+int SpriteCache::memory()
+{
+    SpriteCache* cache = instance();
+    QMutexLocker locker( &cache->m_mutex );
+    return cache->m_sprites.totalCost();
+}
+
+void SpriteCache::resetCounters()
+{
+    SpriteCache* cache = instance();
+    QMutexLocker locker( &cache->m_mutex );
+
+    cache->m_hits   = 0;
+    cache->m_misses = 0;
+}
+
+SpriteCache* SpriteCache::instance()
+{
+    static SpriteCache cache;
+    return &cache;
+}
+
+SpriteCache::SpriteCache() :
+    m_sprites(32 * 1024 * 1024)
+{}
+
+}
@@ -0,0 +1,158 @@
+/***************************************************************************//**
+ * @file SpriteCache.h
+ * @author  Marek M. Cel <marekcel@marekcel.pl>
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * This file is part of QFlightInstruments. You can redistribute and modify it
+ * under the terms of GNU General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.
+ * 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ *
+ * Further information about the GNU General Public License can also be found
+ * on the world wide web at http://www.gnu.org.
+ *
+ * ---
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef __qfi_SpriteCache_H__
+#define __qfi_SpriteCache_H__
+
+#include <QCache>
+#include <QHash>
+#include <QImage>
+#include <QMutex>
+#include <QPointF>
+#include <QRectF>
+#include <QString>
+
+class QSvgRenderer;
+
+namespace qfi {
+
+//---------------------------------------------------
+// Class: SpriteCache
+// Description: Process-wide cache of pre-rendered rotated SVG layers,
+// rotation angles are quantized so that a steadily moving needle or dial
+// is blitted from a sprite instead of being rasterized every frame
+//---------------------------------------------------
+class SpriteCache
+{
+public:
+
+    struct Sprite
+    {
+        QImage image;                   ///< premultiplied rotated layer
+        QPointF offset;                 ///< [px] sprite top left corner relative to the layer origin
+        qreal angle{};                  ///< [deg] rotation of the sprite (the quantized angle)
+    };
+
+    //
+    // returns sprite of the layer rotated by the angle [deg] rounded to
+    // the quantum and scaled by the device scale (applied after rotation),
+    // missing sprite is rendered with the renderer of the calling thread
+    //
+    static Sprite sprite(QSvgRenderer* renderer, const QString& fileName,
+                         const QRectF& bounds, const qreal angle,
+                         const qreal scaleX, const qreal scaleY);
+
+    // sets angular quantum [deg] (0.25 by default), clears the cache
+    static void setQuantum(const qreal quantum);
+
+    static qreal quantum();
+
+    // sets memory budget [bytes] (32 MiB by default), least recently used sprites are evicted
+    static void setBudget(const int budget);
+
+    static int budget();
+
+    // deletes all the sprites
+    static void clear();
+
+    // number of requests served by an already rendered sprite
+    static int hits();
+
+    // number of requests which required rendering a sprite
+    static int misses();
+
+    // ratio of hits to all the requests
+    static double hitRate();
+
+    // number of sprites held by the cache
+    static int size();
+
+    // memory held by the sprites [bytes]
+    static int memory();
+
+    // resets hits and misses counters
+    static void resetCounters();
+
+private:
+
+    struct Key
+    {
+        QString fileName;
+        int width{};                    ///< [px] unrotated layer size
+        int height{};                   ///< [px] unrotated layer size
+        int step{};                     ///< angle in quanta
+
+        inline bool operator==(const Key& key) const
+        {
+            return step == key.step && width == key.width && height == key.height
+                && fileName == key.fileName;
+        }
+
+        friend inline uint qHash(const Key& key, uint seed = 0)
+        {
+            return qHash( key.fileName, seed ) ^ ( key.step * 31 + key.width * 17 + key.height );
+        }
+    };
+
+    static SpriteCache* instance();
+
+    SpriteCache();
+    ~SpriteCache() = default;
+
+    QCache<Key, Sprite> m_sprites;
+
+    QMutex m_mutex;
+
+    qreal m_quantum{0.25};
+
+    int m_hits{};
+    int m_misses{};
+};
+
+}
+
+#endif
@@ -0,0 +1,195 @@
+/***************************************************************************//**
+ * @file SvgItem.cpp
+ * @author  Marek M. Cel <marekcel@marekcel.pl>
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * This file is part of QFlightInstruments. You can redistribute and modify it
+ * under the terms of GNU General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.
+ * 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ *
+ * Further information about the GNU General Public License can also be found
+ * on the world wide web at http://www.gnu.org.
+ *
+ * ---
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include "SvgItem.hpp"
+
+#include "SpriteCache.hpp"
+#include "SvgRegistry.hpp"
+
+#include <QGraphicsScene>
+#include <QPainter>
+#include <QSvgRenderer>
+
+#include <cmath>
+
+#ifndef M_PI
+#   define M_PI 3.14159265358979323846
+#endif
+
+namespace qfi {
+
+void SvgItem::setRasterCache(QGraphicsScene* scene, const bool rasterCache)
+{
+    if ( !scene ) return;
+
+    for ( QGraphicsItem* item : scene->items() ) {
+        SvgItem* svgItem = qgraphicsitem_cast<SvgItem*>( item );
+
+        if ( svgItem ) svgItem->setRasterCache( rasterCache );
+    }
+}
+
+QSizeF SvgItem::deviceScale(const QPainter* painter)
+{
+    const QTransform& t = painter->worldTransform();
+    const qreal dpr = painter->device() ? painter->device()->devicePixelRatioF() : 1.0;
+
+    // t is rotation R followed by scaling S, the rows of S * R are scaled unit vectors
+    return QSizeF( dpr * std::sqrt( t.m11() * t.m11() + t.m21() * t.m21() ),
+                   dpr * std::sqrt( t.m12() * t.m12() + t.m22() * t.m22() ) );
+}
+
+SvgItem::SvgItem(const QString& fileName, QGraphicsItem* parent) :
+    QGraphicsSvgItem(parent),
+    m_fileName(fileName)
+{
+    setSharedRenderer( SvgRegistry::acquire( m_fileName ) );
+}
+
+SvgItem::~SvgItem()
+{
+    SvgRegistry::release( m_fileName );
+}
+
+void SvgItem::setRasterCache(const bool rasterCache)
+{
+    if ( m_rasterCache == rasterCache ) return;
+
+    m_rasterCache = rasterCache;
+    m_raster = QImage();
+
+    update();
+}
+
+void SvgItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
+{
+    if ( !m_rasterCache ) {
+        QGraphicsSvgItem::paint( painter, option, widget );
+        return;
+    }
+
+    const QTransform& t = painter->worldTransform();
+
+    // rotated layers are blitted from pre-rotated sprites, provided that
+    // the transformation is a rotation followed by scaling (no shear)
+    if ( t.m12() != 0.0 || t.m21() != 0.0 ) {
+        const qreal dot = t.m11() * t.m12() + t.m21() * t.m22();
+        const qreal det = t.m11() * t.m22() - t.m12() * t.m21();
+
+        if ( std::fabs( dot ) < 1.0e-6 * std::fabs( det ) && det > 0.0 ) {
+            paintSprite( painter );
+            return;
+        }
+    }
+
+    // the device scale does not depend on the rotation, so the raster is
+    // only invalidated when the scale or the device changes
+    const QSizeF scale = deviceScale( painter );
+
+    const QRectF bounds = boundingRect();
+    const QSize size( qRound( bounds.width() * scale.width() ), qRound( bounds.height() * scale.height() ) );
+
+    if ( size.isEmpty() ) return;
+
+    if ( m_raster.size() != size ) updateRaster( size );
+
+    const bool smooth = painter->testRenderHint( QPainter::SmoothPixmapTransform );
+
+    painter->setRenderHint( QPainter::SmoothPixmapTransform, true );
+    painter->drawImage( bounds, m_raster );
+    painter->setRenderHint( QPainter::SmoothPixmapTransform, smooth );
+}
+
+void SvgItem::paintSprite(QPainter* painter)
+{
+    const QTransform t = painter->worldTransform();
+    const qreal dpr = painter->device() ? painter->device()->devicePixelRatioF() : 1.0;
+
+    const QSizeF scale = deviceScale( painter );
+    const qreal sx = scale.width();
+    const qreal sy = scale.height();
+
+    const qreal angle = 180.0 * std::atan2( -t.m21(), t.m11() ) / M_PI;
+
+    const SpriteCache::Sprite sprite = SpriteCache::sprite( renderer(), m_fileName, boundingRect(),
+                                                            angle, sx, sy );
+
+    if ( sprite.image.isNull() ) return;
+
+    //
+    // sprite is rotated about the layer origin by the quantized angle, it is
+    // placed so that the pivot (e.g. needle hub) is at its exact position
+    // and only the rest of the layer is off by the quantization
+    //
+    QTransform rotation;
+    rotation.scale( sx, sy );
+    rotation.rotate( sprite.angle );
+
+    const QPointF pivot = transformOriginPoint();
+    const QPointF origin = dpr * t.map( pivot ) - rotation.map( pivot );
+
+    // sprite is aligned to the device pixels so that it is a plain blit
+    const qreal x = std::floor( origin.x() + sprite.offset.x() + 0.5 ) / dpr;
+    const qreal y = std::floor( origin.y() + sprite.offset.y() + 0.5 ) / dpr;
+
+    painter->setWorldTransform( QTransform() );
+    painter->drawImage( QRectF( x, y, sprite.image.width() / dpr, sprite.image.height() / dpr ), sprite.image );
+    painter->setWorldTransform( t );
+}
+
+void SvgItem::updateRaster(const QSize& size)
+{
+    m_raster = QImage( size, QImage::Format_ARGB32_Premultiplied );
+    m_raster.fill( Qt::transparent );
+
+    QPainter painter( &m_raster );
+    painter.setRenderHints( QPainter::Antialiasing | QPainter::SmoothPixmapTransform );
+    renderer()->render( &painter, QRectF( 0.0, 0.0, size.width(), size.height() ) );
+}
+
+}
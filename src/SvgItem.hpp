@@ -0,0 +1,120 @@
+/***************************************************************************//**
+ * @file SvgItem.h
+ * @author  Marek M. Cel <marekcel@marekcel.pl>
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * This file is part of QFlightInstruments. You can redistribute and modify it
+ * under the terms of GNU General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.
+ * 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ *
+ * Further information about the GNU General Public License can also be found
+ * on the world wide web at http://www.gnu.org.
+ *
+ * ---
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef __qfi_SvgItem_H__
+#define __qfi_SvgItem_H__
+
+#include <QGraphicsSvgItem>
+#include <QImage>
+
+class QGraphicsScene;
+class QPainter;
+class QStyleOptionGraphicsItem;
+class QWidget;
+
+namespace qfi {
+
+//---------------------------------------------------
+// Class: SvgItem
+// Description: SVG layer item with optional cached raster mode
+//---------------------------------------------------
+class SvgItem : public QGraphicsSvgItem
+{
+    Q_OBJECT
+
+public:
+
+    enum { Type = UserType + 1 };
+
+    explicit SvgItem(const QString& fileName, QGraphicsItem* parent = nullptr);
+    virtual ~SvgItem();
+
+    // sets cached raster mode of every SVG layer in the scene
+    static void setRasterCache(QGraphicsScene*, const bool);
+
+    //
+    // returns device pixels per item unit of the painter world transform
+    // and device pixel ratio, the transform is expected to be rotated then
+    // scaled as QGraphicsItem combines rotation() with transform(), so the
+    // result does not depend on the rotation, for an item scaled then
+    // rotated it holds for the uniform scaling only
+    //
+    static QSizeF deviceScale(const QPainter* painter);
+
+    //
+    // cached raster mode, layer is rasterized once per device size
+    // (widget size and device pixel ratio) and blitted afterwards,
+    // rotated layer is blitted from the SpriteCache sprite of its angle
+    //
+    void setRasterCache(const bool);
+
+    inline bool rasterCache() const
+    {
+        return m_rasterCache;
+    }
+
+    int type() const
+    {
+        return Type;
+    }
+
+    void paint(QPainter*, const QStyleOptionGraphicsItem*, QWidget* = nullptr);
+
+private:
+    void paintSprite(QPainter* painter);
+    void updateRaster(const QSize& size);
+
+    QString m_fileName;             ///< SVG file (registry key)
+
+    QImage m_raster;                ///< premultiplied layer raster
+
+    bool m_rasterCache{};
+};
+
+}
+
+#endif
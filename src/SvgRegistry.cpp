@@ -0,0 +1,147 @@
+/***************************************************************************//**
+ * @file SvgRegistry.cpp
+ * @author  Marek M. Cel <marekcel@marekcel.pl>
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * This file is part of QFlightInstruments. You can redistribute and modify it
+ * under the terms of GNU General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.
+ * 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ *
+ * Further information about the GNU General Public License can also be found
+ * on the world wide web at http://www.gnu.org.
+ *
+ * ---
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include "SvgRegistry.hpp"
+
+#include <QMutexLocker>
+#include <QSvgRenderer>
+#include <QThread>
+
+namespace qfi {
+
+QSvgRenderer* SvgRegistry::acquire(const QString& fileName)
+{
+    SvgRegistry* registry = instance();
+    QMutexLocker locker( &registry->m_mutex );
+
+    Entry& entry = registry->m_entries[ Key( QThread::currentThread(), fileName ) ];
+
+    if ( entry.renderer ) {
+        registry->m_hits++;
+    } else {
+        registry->m_misses++;
+        entry.renderer = new QSvgRenderer( fileName );
+    }
+
+    entry.refs++;
+
+    return entry.renderer;
+}
+
+void SvgRegistry::release(const QString& fileName)
+{
+    SvgRegistry* registry = instance();
+    QMutexLocker locker( &registry->m_mutex );
+
+    QHash<Key, Entry>::iterator it = registry->m_entries.find( Key( QThread::currentThread(), fileName ) );
+
+    // unreferenced renderers are kept until purge() so that reinitiating
+    // a widget does not parse its files again
+    if ( it != registry->m_entries.end() && it->refs > 0 ) it->refs--;
+}
+
+void SvgRegistry::purge()
+{
+    SvgRegistry* registry = instance();
+    QMutexLocker locker( &registry->m_mutex );
+
+    QHash<Key, Entry>::iterator it = registry->m_entries.begin();
+
+    while ( it != registry->m_entries.end() ) {
+        if ( it->refs == 0 ) {
+            delete it->renderer;
+            it = registry->m_entries.erase( it );
+        } else {
+            ++it;
+        }
+    }
+}
+
+int SvgRegistry::hits()
+{
+    SvgRegistry* registry = instance();
+    QMutexLocker locker( &registry->m_mutex );
+    return registry->m_hits;
+}
+
+int SvgRegistry::misses()
+{
+    SvgRegistry* registry = instance();
+    QMutexLocker locker( &registry->m_mutex );
+    return registry->m_misses;
+}
+
+int SvgRegistry::size()
+{
+    SvgRegistry* registry = instance();
+    QMutexLocker locker( &registry->m_mutex );
+    return registry->m_entries.size();
+}
+
+void SvgRegistry::resetCounters()
+{
+    SvgRegistry* registry = instance();
+    QMutexLocker locker( &registry->m_mutex );
+
+    registry->m_hits   = 0;
+    registry->m_misses = 0;
+}
+
+SvgRegistry* SvgRegistry::instance()
+{
+    static SvgRegistry registry;
+    return &registry;
+}
+
+SvgRegistry::~SvgRegistry()
+{
+    for ( const Entry& entry : m_entries ) delete entry.renderer;
+    m_entries.clear();
+}
+
+}
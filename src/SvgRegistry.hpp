@@ -0,0 +1,120 @@
+/***************************************************************************//**
+ * @file SvgRegistry.h
+ * @author  Marek M. Cel <marekcel@marekcel.pl>
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * This file is part of QFlightInstruments. You can redistribute and modify it
+ * under the terms of GNU General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.
+ * 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ *
+ * Further information about the GNU General Public License can also be found
+ * on the world wide web at http://www.gnu.org.
+ *
+ * ---
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef __qfi_SvgRegistry_H__
+#define __qfi_SvgRegistry_H__
+
+#include <QHash>
+#include <QMutex>
+#include <QPair>
+#include <QString>
+
+class QSvgRenderer;
+class QThread;
+
+namespace qfi {
+
+//---------------------------------------------------
+// Class: SvgRegistry
+// Description: Process-wide registry of shared SVG renderers
+//---------------------------------------------------
+class SvgRegistry
+{
+public:
+
+    //
+    // returns shared renderer of the given SVG file and increments its
+    // reference count, the file is parsed only on the first request,
+    // QSvgRenderer is not reentrant so renderers are shared only between
+    // the items of the calling thread
+    //
+    static QSvgRenderer* acquire(const QString& fileName);
+
+    // decrements reference count of the calling thread renderer of the given SVG file
+    static void release(const QString& fileName);
+
+    // deletes renderers which are no longer referenced
+    static void purge();
+
+    // number of requests served by an already parsed renderer
+    static int hits();
+
+    // number of requests which required parsing the file
+    static int misses();
+
+    // number of renderers held by the registry
+    static int size();
+
+    // resets hits and misses counters
+    static void resetCounters();
+
+private:
+
+    struct Entry
+    {
+        QSvgRenderer* renderer{};
+        int refs{};
+    };
+
+    typedef QPair<QThread*, QString> Key;
+
+    static SvgRegistry* instance();
+
+    SvgRegistry() = default;
+    ~SvgRegistry();
+
+    QHash<Key, Entry> m_entries;
+
+    QMutex m_mutex;
+
+    int m_hits{};
+    int m_misses{};
+};
+
+}
+
+#endif
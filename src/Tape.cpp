@@ -0,0 +1,239 @@
+/***************************************************************************//**
+ * @file Tape.cpp
+ * @author  Marek M. Cel <marekcel@marekcel.pl>
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * This file is part of QFlightInstruments. You can redistribute and modify it
+ * under the terms of GNU General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.
+ * 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ *
+ * Further information about the GNU General Public License can also be found
+ * on the world wide web at http://www.gnu.org.
+ *
+ * ---
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include "Tape.hpp"
+
+#include <QFontMetricsF>
+#include <QPainter>
+
+#include <cmath>
+#include <limits>
+
+#include "Readout.hpp"
+#include "SvgItem.hpp"
+
+namespace qfi {
+
+Tape::Tape(const QRectF& window, const float referenceY, const float pixPerUnit,
+           QGraphicsItem* parent) :
+    QGraphicsItem(parent),
+    m_window(window),
+    m_referenceY(referenceY),
+    m_pixPerUnit(pixPerUnit),
+    m_min(std::numeric_limits<float>::lowest()),
+    m_max(std::numeric_limits<float>::max())
+{}
+
+void Tape::setTicks(const float step, const QRectF& tick, const QColor& color)
+{
+    m_ticksStep  = step;
+    m_tick       = tick;
+    m_ticksColor = color;
+
+    invalidate();
+}
+
+void Tape::setLabels(const float step, const float x, const int width,
+                     const QFont& font, const QColor& color)
+{
+    m_labelsStep  = step;
+    m_labelsX     = x;
+    m_labelsWidth = width;
+    m_labelsFont  = font;
+    m_labelsColor = color;
+
+    const QFontMetricsF metrics( m_labelsFont );
+
+#   if QT_VERSION >= QT_VERSION_CHECK(5, 11, 0)
+    m_labelsAdvance = metrics.horizontalAdvance( QString( m_labelsWidth, QChar( '9' ) ) );
+#   else
+    m_labelsAdvance = metrics.width( QString( m_labelsWidth, QChar( '9' ) ) );
+#   endif
+
+    m_labelsAscent = metrics.ascent();
+    m_labelsHeight = metrics.height();
+
+    // visible intervals and one spare at each end, so that scrolling
+    // by less than an interval does not render anything
+    const float height = m_labelsStep * m_pixPerUnit;
+
+    m_tilesCount = height > 0.0f ? static_cast<int>( std::ceil( m_window.height() / height ) ) + 2 : 0;
+    m_tilesCount = qMin( m_tilesCount, m_maxTiles );
+
+    invalidate();
+}
+
+void Tape::setRange(const float min, const float max)
+{
+    m_min = min;
+    m_max = max;
+
+    invalidate();
+}
+
+void Tape::setValue(const float value)
+{
+    if ( value == m_value ) return;
+
+    m_value = value;
+    update();
+}
+
+QRectF Tape::boundingRect() const
+{
+    return m_window;
+}
+
+void Tape::paint(QPainter* painter, const QStyleOptionGraphicsItem*, QWidget*)
+{
+    // tiles are rendered at the device scale
+    const QSizeF scale = SvgItem::deviceScale( painter );
+    const qreal sx = scale.width();
+    const qreal sy = scale.height();
+
+    if ( sx != m_scaleX || sy != m_scaleY ) {
+        m_scaleX = sx;
+        m_scaleY = sy;
+
+        invalidate();
+    }
+
+    const double height = m_labelsStep * m_pixPerUnit;
+
+    if ( m_tilesCount == 0 || m_scaleX <= 0.0 || m_scaleY <= 0.0 ) return;
+
+    // values at the window edges
+    const double top    = m_value + ( m_referenceY - m_window.top()    ) / m_pixPerUnit;
+    const double bottom = m_value + ( m_referenceY - m_window.bottom() ) / m_pixPerUnit;
+
+    // interval k spans values from (k - 0.5) to (k + 0.5) labels steps
+    const qint64 first = static_cast<qint64>( std::floor( bottom / m_labelsStep + 0.5 ) );
+    const qint64 last  = static_cast<qint64>( std::floor( top    / m_labelsStep + 0.5 ) );
+
+    for ( qint64 k = first; k <= last; ++k ) {
+        // tiles hold also the parts of the neighbouring intervals items
+        if ( ( k + 1 ) * m_labelsStep < m_min || ( k - 1 ) * m_labelsStep > m_max ) continue;
+
+        Tile* tile = &m_tiles[ ( k % m_tilesCount + m_tilesCount ) % m_tilesCount ];
+
+        if ( !tile->valid || tile->interval != k ) renderTile( tile, k );
+
+        const double tileTop = m_referenceY - m_pixPerUnit * ( ( k + 0.5 ) * m_labelsStep - m_value );
+
+        const double y0 = qMax( tileTop, m_window.top() );
+        const double y1 = qMin( tileTop + height, m_window.bottom() );
+
+        if ( y1 <= y0 ) continue;
+
+        painter->drawImage( QRectF( m_window.left(), y0, m_window.width(), y1 - y0 ), tile->image,
+                            QRectF( 0.0, ( y0 - tileTop ) * m_scaleY,
+                                    m_window.width() * m_scaleX, ( y1 - y0 ) * m_scaleY ) );
+    }
+}
+
+void Tape::invalidate()
+{
+    for ( Tile& tile : m_tiles ) tile.valid = false;
+
+    update();
+}
+
+void Tape::renderTile(Tile* tile, const qint64 interval)
+{
+    const QSize size( static_cast<int>( std::ceil( m_window.width() * m_scaleX ) ),
+                      static_cast<int>( std::ceil( m_labelsStep * m_pixPerUnit * m_scaleY ) ) );
+
+    if ( tile->image.size() != size ) {
+        tile->image = QImage( size, QImage::Format_ARGB32_Premultiplied );
+    }
+
+    tile->image.fill( Qt::transparent );
+    tile->interval = interval;
+    tile->valid    = true;
+
+    QPainter painter( &tile->image );
+    painter.setRenderHints( QPainter::Antialiasing | QPainter::TextAntialiasing );
+    painter.scale( m_scaleX, m_scaleY );
+    painter.translate( -m_window.left(), 0.0 );
+
+    // value at the tile top edge
+    const double topValue = ( interval + 0.5 ) * m_labelsStep;
+
+    // items of the neighbouring intervals may reach into the tile too
+    const qint64 ticksPerLabel = static_cast<qint64>( std::floor( m_labelsStep / m_ticksStep + 0.5 ) );
+
+    for ( qint64 i = ( interval - 1 ) * ticksPerLabel; i <= ( interval + 1 ) * ticksPerLabel; ++i ) {
+        const double value = i * static_cast<double>( m_ticksStep );
+
+        if ( value < m_min || value > m_max ) continue;
+
+        const double y = m_pixPerUnit * ( topValue - value );
+
+        painter.fillRect( m_tick.translated( 0.0, y ), m_ticksColor );
+    }
+
+    painter.setFont( m_labelsFont );
+    painter.setPen( m_labelsColor );
+
+    for ( qint64 i = interval - 1; i <= interval + 1; ++i ) {
+        const double value = i * static_cast<double>( m_labelsStep );
+
+        if ( value < m_min || value > m_max ) continue;
+
+        char text[ 32 ];
+        Readout::format( text, sizeof(text), static_cast<float>( value ), m_labelsWidth, 0 );
+
+        // same layout as centered readout
+        const double x = m_labelsX - m_labelsAdvance / 2.0;
+        const double y = m_pixPerUnit * ( topValue - value ) - m_labelsHeight / 2.0 + m_labelsAscent;
+
+        painter.drawText( QPointF( x, y ), QString::fromLatin1( text ) );
+    }
+}
+
+}
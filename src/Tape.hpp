@@ -0,0 +1,160 @@
+/***************************************************************************//**
+ * @file Tape.h
+ * @author  Marek M. Cel <marekcel@marekcel.pl>
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * This file is part of QFlightInstruments. You can redistribute and modify it
+ * under the terms of GNU General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.
+ * 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ *
+ * Further information about the GNU General Public License can also be found
+ * on the world wide web at http://www.gnu.org.
+ *
+ * ---
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef __qfi_Tape_H__
+#define __qfi_Tape_H__
+
+#include <QColor>
+#include <QFont>
+#include <QGraphicsItem>
+#include <QImage>
+
+class QPainter;
+class QStyleOptionGraphicsItem;
+class QWidget;
+
+namespace qfi {
+
+//---------------------------------------------------
+// Class: Tape
+// Description: Endless vertical scale tape (e.g. airspeed, altitude),
+// only the visible window is drawn from cached tiles, each tile holds
+// ticks and label of one labels interval and is rendered once per
+// device scale, tiles are kept in a ring buffer indexed by interval
+// number so that the drawing cost does not depend on the value
+//---------------------------------------------------
+class Tape : public QGraphicsItem
+{
+public:
+
+    enum { Type = UserType + 3 };
+
+    //
+    // window [item units] visible part of the tape
+    // referenceY [item units] y coordinate of the current value
+    // pixPerUnit [item units] length of the value unit
+    //
+    Tape(const QRectF& window, const float referenceY, const float pixPerUnit,
+         QGraphicsItem* parent = nullptr);
+
+    //
+    // sets ticks drawn every step [units], tick is the tick rectangle
+    // with y relative to the tick value position [item units]
+    //
+    void setTicks(const float step, const QRectF& tick, const QColor& color);
+
+    //
+    // sets labels drawn every step [units], it has to be a multiple of
+    // the ticks step, labels are centered at x [item units] and laid out
+    // as readouts of the given number of characters would be
+    //
+    void setLabels(const float step, const float x, const int width,
+                   const QFont& font, const QColor& color);
+
+    // sets range of the values ticks and labels are drawn for
+    void setRange(const float min, const float max);
+
+    // sets current value
+    void setValue(const float value);
+
+    QRectF boundingRect() const;
+
+    int type() const
+    {
+        return Type;
+    }
+
+    void paint(QPainter*, const QStyleOptionGraphicsItem*, QWidget* = nullptr);
+
+private:
+
+    struct Tile
+    {
+        QImage image;
+        qint64 interval{};
+        bool valid{};
+    };
+
+    void invalidate();
+    void renderTile(Tile* tile, const qint64 interval);
+
+    static const int m_maxTiles{16};
+
+    Tile m_tiles[m_maxTiles];           ///< ring buffer indexed by interval number
+    int m_tilesCount{};
+
+    QRectF m_window;
+    QRectF m_tick;
+
+    QFont  m_labelsFont;
+    QColor m_labelsColor;
+    QColor m_ticksColor;
+
+    float m_referenceY{};
+    float m_pixPerUnit{};
+
+    float m_ticksStep{1.0f};
+    float m_labelsStep{1.0f};
+    float m_labelsX{};
+    int m_labelsWidth{};
+
+    qreal m_labelsAdvance{};            ///< advance of the widest label
+    qreal m_labelsAscent{};
+    qreal m_labelsHeight{};
+
+    float m_min{};
+    float m_max{};
+
+    float m_value{};
+
+    qreal m_scaleX{};                   ///< device scale of the tiles
+    qreal m_scaleY{};                   ///< device scale of the tiles
+};
+
+}
+
+#endif
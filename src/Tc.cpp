@@ -48,115 +48,193 @@
 
 #include "Tc.hpp"
 
-#include <QGraphicsSvgItem>
+#include "SvgItem.hpp"
 
 namespace qfi {
 
 Tc::Tc(QWidget* parent) : QGraphicsView(parent)
 {
-    m_scene = new QGraphicsScene(this);
-    setScene( m_scene );
-    m_scene->clear();
-    init();
+    m_renderer = new Renderer();
+    setScene( m_renderer->scene() );
+    Profile::apply( this, m_renderer->profile() );
+    m_renderer->resize( width(), height() );
+    centerOn( width() / 2.0f , height() / 2.0f );
 }
 
 Tc::~Tc()
 {
-    if (m_scene) {
-        m_scene->clear();
-        delete m_scene;
-        m_scene = nullptr;
+    if ( m_renderer ) {
+        delete m_renderer;
+        m_renderer = nullptr;
     }
-
-    reset();
 }
 
 void Tc::reinit()
 {
-    if (m_scene) {
-        m_scene->clear();
-        init();
-    }
+    m_renderer->reinit();
+    centerOn( width() / 2.0f , height() / 2.0f );
 }
 
 void Tc::update()
 {
-    updateView();
+    m_renderer->update();
+}
+
+void Tc::setRasterCache(const bool rasterCache)
+{
+    m_renderer->setRasterCache( rasterCache );
+}
+
+void Tc::setProfile(const Profile::Type profile)
+{
+    m_renderer->setProfile( profile );
+    Profile::apply( this, profile );
+}
+
+void Tc::resizeEvent(QResizeEvent* event)
+{
+    QGraphicsView::resizeEvent( event );
+    m_renderer->resize( width(), height() );
+    centerOn( width() / 2.0f , height() / 2.0f );
+}
+
+void Tc::paintEvent(QPaintEvent* event)
+{
+    Timings::Scope scope( &m_renderer->timings(), Timings::Paint );
+    QGraphicsView::paintEvent( event );
+}
+
+Tc::Renderer::Renderer()
+{
+    m_width  = m_originalWidth;
+    m_height = m_originalHeight;
+
+    reinit();
 }
 
-void Tc::setTurnRate(const float turnRate)
+Tc::Renderer::~Renderer()
 {
+    if ( m_scene ) m_scene->clear();
+
+    reset();
+}
+
+void Tc::Renderer::setTurnRate(const float turnRate)
+{
+    Timings::Scope scope( &m_timings, Timings::Update );
+
+    const float turnRate_prev = m_turnRate;
+
     m_turnRate = turnRate;
 
     if ( m_turnRate < -6.0f ) m_turnRate = -6.0f;
     if ( m_turnRate >  6.0f ) m_turnRate =  6.0f;
+
+    if ( m_turnRate != turnRate_prev ) m_dirty |= DirtyTurnRate;
 }
 
-void Tc::setSlipSkid(const float slipSkid)
+void Tc::Renderer::setSlipSkid(const float slipSkid)
 {
+    Timings::Scope scope( &m_timings, Timings::Update );
+
+    const float slipSkid_prev = m_slipSkid;
+
     m_slipSkid = slipSkid;
 
     if ( m_slipSkid < -15.0f ) m_slipSkid = -15.0f;
     if ( m_slipSkid >  15.0f ) m_slipSkid =  15.0f;
+
+    if ( m_slipSkid != slipSkid_prev ) m_dirty |= DirtySlipSkid;
 }
 
-void Tc::resizeEvent(QResizeEvent *event)
+void Tc::Renderer::setState(const TcState& state)
 {
-    QGraphicsView::resizeEvent( event );
-    reinit();
+    Timings::Scope scope( &m_timings, Timings::Update );
+
+    setTurnRate( state.turnRate );
+    setSlipSkid( state.slipSkid );
 }
 
-void Tc::init()
+void Tc::Renderer::publish(const TcState& state)
 {
-    m_scaleX = static_cast<float>(width())  / static_cast<float>(m_originalWidth);
-    m_scaleY = static_cast<float>(height()) / static_cast<float>(m_originalHeight);
+    m_published.publish( state );
+}
+
+void Tc::Renderer::init()
+{
+    m_scaleX = static_cast<float>(m_width)  / static_cast<float>(m_originalWidth);
+    m_scaleY = static_cast<float>(m_height) / static_cast<float>(m_originalHeight);
 
     reset();
 
-    m_itemBack = new QGraphicsSvgItem( ":/qfi/images/tc/tc_back.svg" );
+    m_itemBack = new SvgItem( ":/qfi/images/tc/tc_back.svg" );
     m_itemBack->setCacheMode( QGraphicsItem::NoCache );
     m_itemBack->setZValue( m_backZ );
     m_itemBack->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
     m_scene->addItem( m_itemBack );
 
-    m_itemBall = new QGraphicsSvgItem( ":/qfi/images/tc/tc_ball.svg" );
+    m_itemBall = new SvgItem( ":/qfi/images/tc/tc_ball.svg" );
     m_itemBall->setCacheMode( QGraphicsItem::NoCache );
     m_itemBall->setZValue( m_ballZ );
     m_itemBall->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
     m_itemBall->setTransformOriginPoint( m_originalBallCtr );
     m_scene->addItem( m_itemBall );
 
-    m_itemFace_1 = new QGraphicsSvgItem( ":/qfi/images/tc/tc_face_1.svg" );
+    m_itemFace_1 = new SvgItem( ":/qfi/images/tc/tc_face_1.svg" );
     m_itemFace_1->setCacheMode( QGraphicsItem::NoCache );
     m_itemFace_1->setZValue( m_face1Z );
     m_itemFace_1->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
     m_scene->addItem( m_itemFace_1 );
 
-    m_itemFace_2 = new QGraphicsSvgItem( ":/qfi/images/tc/tc_face_2.svg" );
+    m_itemFace_2 = new SvgItem( ":/qfi/images/tc/tc_face_2.svg" );
     m_itemFace_2->setCacheMode( QGraphicsItem::NoCache );
     m_itemFace_2->setZValue( m_face2Z );
     m_itemFace_2->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
     m_scene->addItem( m_itemFace_2 );
 
-    m_itemMark = new QGraphicsSvgItem( ":/qfi/images/tc/tc_mark.svg" );
+    m_itemMark = new SvgItem( ":/qfi/images/tc/tc_mark.svg" );
     m_itemMark->setCacheMode( QGraphicsItem::NoCache );
     m_itemMark->setZValue( m_markZ );
     m_itemMark->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
     m_itemMark->setTransformOriginPoint( m_originalMarkCtr );
     m_scene->addItem( m_itemMark );
 
-    m_itemCase = new QGraphicsSvgItem( ":/qfi/images/tc/tc_case.svg" );
+    m_itemCase = new SvgItem( ":/qfi/images/tc/tc_case.svg" );
     m_itemCase->setCacheMode( QGraphicsItem::NoCache );
     m_itemCase->setZValue( m_caseZ );
     m_itemCase->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
     m_scene->addItem( m_itemCase );
 
-    centerOn( width() / 2.0f , height() / 2.0f );
+    m_compositor.setPolicy( m_itemBack,   Compositor::Static );
+    m_compositor.setPolicy( m_itemFace_1, Compositor::Static );
+    m_compositor.setPolicy( m_itemFace_2, Compositor::Static );
+    m_compositor.setPolicy( m_itemCase,   Compositor::Static );
 
-    updateView();
+    SvgItem::setRasterCache( m_scene, m_rasterCache );
+
+    invalidate();
+    refresh();
+}
+
+void Tc::Renderer::rescale()
+{
+    m_scaleX = static_cast<float>(m_width)  / static_cast<float>(m_originalWidth);
+    m_scaleY = static_cast<float>(m_height) / static_cast<float>(m_originalHeight);
+
+    const QTransform scale = QTransform::fromScale( m_scaleX, m_scaleY );
+
+    m_itemBack->setTransform( scale );
+    m_itemBall->setTransform( scale );
+    m_itemFace_1->setTransform( scale );
+    m_itemFace_2->setTransform( scale );
+    m_itemMark->setTransform( scale );
+    m_itemCase->setTransform( scale );
+
+    invalidate();
+    refresh();
 }
 
-void Tc::reset()
+void Tc::Renderer::reset()
 {
     m_itemCase = nullptr;
 
@@ -164,16 +242,26 @@ void Tc::reset()
     m_slipSkid = 0.0f;
 }
 
-void Tc::updateView()
+void Tc::Renderer::fetchPublished()
 {
-    m_scaleX = static_cast<float>(width())  / static_cast<float>(m_originalWidth);
-    m_scaleY = static_cast<float>(height()) / static_cast<float>(m_originalHeight);
+    TcState state;
 
-    m_itemBall->setRotation( -m_slipSkid );
+    if ( m_published.fetch( &state ) ) setState( state );
+}
+
+void Tc::Renderer::updateView()
+{
+    m_scaleX = static_cast<float>(m_width)  / static_cast<float>(m_originalWidth);
+    m_scaleY = static_cast<float>(m_height) / static_cast<float>(m_originalHeight);
 
-    const float angle = ( m_turnRate / 3.0f ) * 20.0f;
-    m_itemMark->setRotation( angle );
-    m_scene->update();
+    if ( m_dirty & DirtySlipSkid ) {
+        m_itemBall->setRotation( -m_slipSkid );
+    }
+
+    if ( m_dirty & DirtyTurnRate ) {
+        const float angle = ( m_turnRate / 3.0f ) * 20.0f;
+        m_itemMark->setRotation( angle );
+    }
 }
 
 }
@@ -50,6 +50,9 @@
 
 #include <QGraphicsView>
 
+#include "Instrument.hpp"
+#include "TripleBuffer.hpp"
+
 class QWidget;
 class QResizeEvent;
 class QGraphicsScene;
@@ -57,6 +60,16 @@ class QGraphicsSvgItem;
 
 namespace qfi {
 
+//---------------------------------------------------
+// Struct: TcState
+// Description: Turn Coordinator state snapshot
+//---------------------------------------------------
+struct TcState
+{
+    float turnRate{};                   ///< [deg/s]
+    float slipSkid{};                   ///< ball angle [deg]
+};
+
 //---------------------------------------------------
 // Class: Tc
 // Description: Turn Coordinator
@@ -66,6 +79,76 @@ class Tc : public QGraphicsView
     Q_OBJECT
 
 public:
+
+    //---------------------------------------------------
+    // Class: Tc::Renderer
+    // Description: Turn Coordinator headless renderer
+    //---------------------------------------------------
+    class Renderer : public Instrument
+    {
+    public:
+        Renderer();
+        virtual ~Renderer();
+
+        // turn rate [deg/s]
+        void setTurnRate(const float);
+
+        // slip/skid ball angle [deg]
+        void setSlipSkid(const float);
+
+        // sets all the values at once
+        void setState(const TcState& state);
+
+        //
+        // publishes state to be applied by the next update(), can be called
+        // from any single producer thread, never blocks nor allocates
+        //
+        void publish(const TcState& state);
+
+    protected:
+        void init();
+        void rescale();
+        void updateView();
+        void fetchPublished();
+
+    private:
+        enum
+        {
+            DirtyTurnRate = 0x0001,
+            DirtySlipSkid = 0x0002
+        };
+
+        void reset();
+
+        QGraphicsSvgItem* m_itemBack{};
+        QGraphicsSvgItem* m_itemBall{};
+        QGraphicsSvgItem* m_itemFace_1{};
+        QGraphicsSvgItem* m_itemFace_2{};
+        QGraphicsSvgItem* m_itemMark{};
+        QGraphicsSvgItem* m_itemCase{};
+
+        float m_turnRate{};
+        float m_slipSkid{};
+
+        TripleBuffer<TcState> m_published;
+
+        float m_scaleX{1.0f};
+        float m_scaleY{1.0f};
+
+        const int m_originalHeight{240};
+        const int m_originalWidth{240};
+
+        QPointF m_originalMarkCtr{120.0f, 120.0f};
+        QPointF m_originalBallCtr{120.0f, -36.0f};
+
+        const int m_backZ{-70};
+        const int m_ballZ{-60};
+        const int m_face1Z{-50};
+        const int m_face2Z{-40};
+        const int m_markZ{-30};
+        const int m_caseZ{10};
+    };
+
     Tc(QWidget* parent = nullptr);
     virtual ~Tc();
 
@@ -75,47 +158,48 @@ public:
     // refreshes (redraws) widget
     void update();
 
-    // turn rate [deg/s]
-    void setTurnRate(const float);
-
-    // slip/skid ball angle [deg]
-    void setSlipSkid(const float);
+    // enables/disables cached raster mode of the SVG layers
+    void setRasterCache(const bool);
 
-protected:
-    void resizeEvent(QResizeEvent*);
-
-private:
-    void init();
-    void reset();
-    void updateView();
+    // sets performance profile of the widget and its renderer
+    void setProfile(const Profile::Type profile);
 
-    QGraphicsScene* m_scene{};
+    // headless renderer of the widget, e.g. to be registered in RenderScheduler
+    inline Renderer* renderer() const { return m_renderer; }
 
-    QGraphicsSvgItem* m_itemBack{};
-    QGraphicsSvgItem* m_itemBall{};
-    QGraphicsSvgItem* m_itemFace_1{};
-    QGraphicsSvgItem* m_itemFace_2{};
-    QGraphicsSvgItem* m_itemMark{};
-    QGraphicsSvgItem* m_itemCase{};
+    // sets all the values at once
+    inline void setState(const TcState& state)
+    {
+        m_renderer->setState( state );
+    }
 
-    float m_turnRate{};
-    float m_slipSkid{};
+    //
+    // publishes state to be applied by the next update(), can be called
+    // from any single producer thread, never blocks nor allocates
+    //
+    inline void publish(const TcState& state)
+    {
+        m_renderer->publish( state );
+    }
 
-    float m_scaleX{1.0f};
-    float m_scaleY{1.0f};
+    // turn rate [deg/s]
+    inline void setTurnRate(const float turnRate)
+    {
+        m_renderer->setTurnRate( turnRate );
+    }
 
-    const int m_originalHeight{240};
-    const int m_originalWidth{240};
+    // slip/skid ball angle [deg]
+    inline void setSlipSkid(const float slipSkid)
+    {
+        m_renderer->setSlipSkid( slipSkid );
+    }
 
-    QPointF m_originalMarkCtr{120.0f, 120.0f};
-    QPointF m_originalBallCtr{120.0f, -36.0f};
+protected:
+    void paintEvent(QPaintEvent*);
+    void resizeEvent(QResizeEvent*);
 
-    const int m_backZ{-70};
-    const int m_ballZ{-60};
-    const int m_face1Z{-50};
-    const int m_face2Z{-40};
-    const int m_markZ{-30};
-    const int m_caseZ{10};
+private:
+    Renderer* m_renderer{};
 };
 
 }
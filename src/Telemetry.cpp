@@ -0,0 +1,196 @@
+/***************************************************************************//**
+ * @file Telemetry.cpp
+ * @author  Marek M. Cel <marekcel@marekcel.pl>
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * This file is part of QFlightInstruments. You can redistribute and modify it
+ * under the terms of GNU General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.
+ * 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ *
+ * Further information about the GNU General Public License can also be found
+ * on the world wide web at http://www.gnu.org.
+ *
+ * ---
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include "Telemetry.hpp"
+
+#include <cstring>
+
+#include "Adi.hpp"
+#include "Alt.hpp"
+#include "Asi.hpp"
+#include "Hsi.hpp"
+#include "Nav.hpp"
+#include "Pfd.hpp"
+#include "Tc.hpp"
+#include "Vsi.hpp"
+
+namespace qfi {
+
+AdiState TelemetrySample::adi() const
+{
+    AdiState state;
+
+    state.roll  = roll;
+    state.pitch = pitch;
+
+    return state;
+}
+
+AltState TelemetrySample::alt() const
+{
+    AltState state;
+
+    state.altitude = altitude;
+    state.pressure = pressure;
+
+    return state;
+}
+
+AsiState TelemetrySample::asi() const
+{
+    AsiState state;
+
+    state.airspeed = airspeed;
+
+    return state;
+}
+
+HsiState TelemetrySample::hsi() const
+{
+    HsiState state;
+
+    state.heading = heading;
+
+    return state;
+}
+
+NavState TelemetrySample::nav() const
+{
+    NavState state;
+
+    state.heading    = heading;
+    state.headingBug = headingBug;
+    state.course     = course;
+    state.bearing    = bearing;
+    state.deviation  = devH;
+    state.distance   = distance;
+
+    return state;
+}
+
+PfdState TelemetrySample::pfd() const
+{
+    PfdState state;
+
+    state.roll          = roll;
+    state.pitch         = pitch;
+    state.angleOfAttack = alpha;
+    state.sideslipAngle = beta;
+    state.slipSkid      = slipSkid;
+    state.turnRate      = turnRate / 6.0f;
+    state.barH          = devH;
+    state.barV          = devV;
+    state.dotH          = devH;
+    state.dotV          = devV;
+    state.altitude      = altitude;
+    state.pressure      = pressure;
+    state.pressureUnit  = Pfd::IN;
+    state.airspeed      = airspeed;
+    state.machNo        = mach;
+    state.heading       = heading;
+    state.climbRate     = climbRate / 100.0f;
+
+    return state;
+}
+
+TcState TelemetrySample::tc() const
+{
+    TcState state;
+
+    state.turnRate = turnRate;
+    state.slipSkid = slipSkid * 15.0f;
+
+    return state;
+}
+
+VsiState TelemetrySample::vsi() const
+{
+    VsiState state;
+
+    state.climbRate = climbRate;
+
+    return state;
+}
+
+const char* const TelemetryHeader::Magic = "QFIT";
+
+TelemetryHeader TelemetryHeader::current()
+{
+    TelemetryHeader header;
+
+    std::memcpy( header.magic, Magic, sizeof(header.magic) );
+    header.version    = Version;
+    header.recordSize = sizeof(TelemetrySample);
+    header.flags      = 0;
+
+    return header;
+}
+
+bool TelemetryHeader::isValid() const
+{
+    // version 1 recordings are version 2 ones without the index
+    return std::memcmp( magic, Magic, sizeof(magic) ) == 0
+        && version >= 1 && version <= Version
+        && recordSize == sizeof(TelemetrySample);
+}
+
+const char* const TelemetryTrailer::Magic = "QFIX";
+
+bool TelemetryTrailer::isValid(const qint64 fileSize) const
+{
+    const qint64 samplesBegin = static_cast<qint64>( sizeof(TelemetryHeader) );
+
+    return std::memcmp( magic, Magic, sizeof(magic) ) == 0
+        && stride > 0
+        && indexOffset >= samplesBegin
+        && indexSize >= 0
+        && indexOffset + indexSize * static_cast<qint64>( sizeof(TelemetryIndexEntry) )
+           + static_cast<qint64>( sizeof(TelemetryTrailer) ) == fileSize;
+}
+
+}
@@ -0,0 +1,167 @@
+/***************************************************************************//**
+ * @file Telemetry.h
+ * @author  Marek M. Cel <marekcel@marekcel.pl>
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * This file is part of QFlightInstruments. You can redistribute and modify it
+ * under the terms of GNU General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.
+ * 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ *
+ * Further information about the GNU General Public License can also be found
+ * on the world wide web at http://www.gnu.org.
+ *
+ * ---
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef __qfi_Telemetry_H__
+#define __qfi_Telemetry_H__
+
+#include <QtGlobal>
+
+namespace qfi {
+
+struct AdiState;
+struct AltState;
+struct AsiState;
+struct HsiState;
+struct NavState;
+struct PfdState;
+struct TcState;
+struct VsiState;
+
+//---------------------------------------------------
+// Struct: TelemetrySample
+// Description: Timestamped state of all the instruments, a fixed size
+// plain record stored as is in the telemetry recordings, the values are
+// in the units of the example application and are converted to the
+// instruments states the same way
+//---------------------------------------------------
+struct TelemetrySample
+{
+    qint64 time{};                      ///< [ns] since the beginning of the recording
+
+    float roll{};                       ///< [deg]
+    float pitch{};                      ///< [deg]
+    float heading{};                    ///< [deg]
+    float alpha{};                      ///< [deg] angle of attack
+    float beta{};                       ///< [deg] sideslip angle
+    float slipSkid{};                   ///< normalized (range from -1.0 to 1.0)
+    float turnRate{};                   ///< [deg/s]
+    float devH{};                       ///< normalized (range from -1.0 to 1.0)
+    float devV{};                       ///< normalized (range from -1.0 to 1.0)
+    float airspeed{};                   ///< [kts]
+    float mach{};                       ///< Mach number
+    float altitude{};                   ///< [ft]
+    float pressure{29.92f};             ///< [inHg]
+    float climbRate{};                  ///< [ft/min]
+    float headingBug{};                 ///< [deg]
+    float course{};                     ///< [deg]
+    float bearing{};                    ///< [deg]
+    float distance{};                   ///< [NM]
+
+    AdiState adi() const;
+    AltState alt() const;
+    AsiState asi() const;
+    HsiState hsi() const;
+    NavState nav() const;
+    PfdState pfd() const;
+    TcState  tc()  const;
+    VsiState vsi() const;
+};
+
+//---------------------------------------------------
+// Struct: TelemetryHeader
+// Description: Header of the telemetry recording file, the file layout is
+//
+//   header | samples | index entries | trailer
+//
+// samples are TelemetrySample records in time order (or compressed blocks
+// of them, see TelemetryArchive), index holds time of every stride-th
+// sample and the trailer locates the index, recordings without the trailer
+// (e.g. interrupted) are valid and have no index, everything is in the host
+// byte order
+//---------------------------------------------------
+struct TelemetryHeader
+{
+    char magic[4];                      ///< "QFIT"
+    quint32 version;                    ///< format version
+    quint32 recordSize;                 ///< sizeof(TelemetrySample)
+    quint32 flags;
+
+    enum Flags
+    {
+        Compressed = 0x1                ///< samples are stored as TelemetryArchive blocks
+    };
+
+    static const char* const Magic;
+    static const quint32 Version{2};
+
+    // header of the current format
+    static TelemetryHeader current();
+
+    // returns true if the header is the one of a supported format
+    bool isValid() const;
+};
+
+//---------------------------------------------------
+// Struct: TelemetryIndexEntry
+// Description: Sparse time index entry of the telemetry recording
+//---------------------------------------------------
+struct TelemetryIndexEntry
+{
+    qint64 time;                        ///< [ns] time of the sample
+    qint64 sample;                      ///< sample index
+};
+
+//---------------------------------------------------
+// Struct: TelemetryTrailer
+// Description: Trailer of the indexed telemetry recording file
+//---------------------------------------------------
+struct TelemetryTrailer
+{
+    qint64 indexOffset;                 ///< [B] index position in the file
+    qint64 indexSize;                   ///< number of index entries
+    quint32 stride;                     ///< number of samples per index entry
+    char magic[4];                      ///< "QFIX"
+
+    static const char* const Magic;
+
+    // returns true if the trailer is consistent with the file of the given size
+    bool isValid(const qint64 fileSize) const;
+};
+
+}
+
+#endif
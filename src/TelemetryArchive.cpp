@@ -0,0 +1,435 @@
+/***************************************************************************//**
+ * @file TelemetryArchive.cpp
+ * @author  Marek M. Cel <marekcel@marekcel.pl>
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * This file is part of QFlightInstruments. You can redistribute and modify it
+ * under the terms of GNU General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.
+ * 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ *
+ * Further information about the GNU General Public License can also be found
+ * on the world wide web at http://www.gnu.org.
+ *
+ * ---
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include "TelemetryArchive.hpp"
+
+#include <QElapsedTimer>
+
+#include <algorithm>
+#include <cstring>
+
+namespace qfi {
+
+float TelemetrySample::* const TelemetryArchive::channels[ Channels ] =
+{
+    &TelemetrySample::roll,
+    &TelemetrySample::pitch,
+    &TelemetrySample::heading,
+    &TelemetrySample::alpha,
+    &TelemetrySample::beta,
+    &TelemetrySample::slipSkid,
+    &TelemetrySample::turnRate,
+    &TelemetrySample::devH,
+    &TelemetrySample::devV,
+    &TelemetrySample::airspeed,
+    &TelemetrySample::mach,
+    &TelemetrySample::altitude,
+    &TelemetrySample::pressure,
+    &TelemetrySample::climbRate,
+    &TelemetrySample::headingBug,
+    &TelemetrySample::course,
+    &TelemetrySample::bearing,
+    &TelemetrySample::distance
+};
+
+TelemetryArchive::Writer::Writer()
+{
+    for ( int i = 0; i < Streams; ++i ) m_writers[ i ] = Gorilla::BitWriter( &m_streams[ i ] );
+}
+
+TelemetryArchive::Writer::~Writer()
+{
+    close();
+}
+
+bool TelemetryArchive::Writer::open(const QString& fileName)
+{
+    close();
+
+    m_file.setFileName( fileName );
+
+    if ( !m_file.open( QFile::WriteOnly | QFile::Truncate ) ) return false;
+
+    TelemetryHeader header = TelemetryHeader::current();
+    header.flags |= TelemetryHeader::Compressed;
+
+    if ( m_file.write( reinterpret_cast<const char*>( &header ), sizeof(header) ) != sizeof(header) ) {
+        m_file.close();
+        return false;
+    }
+
+    for ( int i = 0; i < Streams; ++i ) {
+        m_writers[ i ].reset();
+        m_streams[ i ].reserve( static_cast<size_t>( m_blockSamples ) * 4 + Gorilla::BitWriter::Padding );
+    }
+
+    m_timeEncoder.reset();
+    for ( Gorilla::ValueEncoder& encoder : m_valueEncoders ) encoder.reset();
+
+    m_index.clear();
+
+    m_samples    = 0;
+    m_bytes      = sizeof(header);
+    m_blockCount = 0;
+
+    return true;
+}
+
+void TelemetryArchive::Writer::close()
+{
+    if ( !m_file.isOpen() ) return;
+
+    TelemetryTrailer trailer;
+
+    const bool indexed = writeBlock();
+
+    trailer.indexOffset = m_bytes;
+    trailer.indexSize   = m_index.size();
+    trailer.stride      = static_cast<quint32>( m_blockSamples );
+    std::memcpy( trailer.magic, TelemetryTrailer::Magic, sizeof(trailer.magic) );
+
+    const qint64 indexBytes = m_index.size() * static_cast<qint64>( sizeof(BlockEntry) );
+
+    // archive without the index is still valid, blocks are then walked through
+    if ( indexed
+         && m_file.write( reinterpret_cast<const char*>( m_index.constData() ), indexBytes ) == indexBytes
+         && m_file.write( reinterpret_cast<const char*>( &trailer ), sizeof(trailer) ) == sizeof(trailer) )
+    {
+        m_bytes += indexBytes + static_cast<qint64>( sizeof(trailer) );
+    } else {
+        m_file.resize( trailer.indexOffset );
+    }
+
+    m_file.close();
+}
+
+bool TelemetryArchive::Writer::write(const TelemetrySample& sample)
+{
+    if ( !m_file.isOpen() ) return false;
+
+    if ( m_blockCount == 0 ) m_blockTime = sample.time;
+
+    m_timeEncoder.encode( sample.time, &m_writers[ 0 ] );
+
+    for ( int i = 0; i < Channels; ++i ) {
+        m_valueEncoders[ i ].encode( sample.*channels[ i ], &m_writers[ i + 1 ] );
+    }
+
+    m_blockCount++;
+    m_samples++;
+
+    return m_blockCount < m_blockSamples || writeBlock();
+}
+
+void TelemetryArchive::Writer::setBlockSamples(const int samples)
+{
+    m_blockSamples = samples > 0 ? samples : 1;
+}
+
+double TelemetryArchive::Writer::compressionRatio() const
+{
+    return m_bytes > 0 ? static_cast<double>( m_samples * sizeof(TelemetrySample) ) / m_bytes : 0.0;
+}
+
+bool TelemetryArchive::Writer::writeBlock()
+{
+    if ( m_blockCount == 0 ) return true;
+
+    Block block;
+    block.samples = static_cast<quint32>( m_blockCount );
+
+    for ( int i = 0; i < Streams; ++i ) {
+        m_writers[ i ].finish();
+        block.sizes[ i ] = static_cast<quint32>( m_streams[ i ].size() );
+    }
+
+    BlockEntry entry;
+    entry.time   = m_blockTime;
+    entry.offset = m_bytes;
+
+    bool result = m_file.write( reinterpret_cast<const char*>( &block ), sizeof(block) ) == sizeof(block);
+    m_bytes += sizeof(block);
+
+    for ( int i = 0; i < Streams; ++i ) {
+        const qint64 size = static_cast<qint64>( m_streams[ i ].size() );
+
+        result = result && m_file.write( reinterpret_cast<const char*>( m_streams[ i ].data() ), size ) == size;
+        m_bytes += size;
+
+        m_writers[ i ].reset();
+    }
+
+    m_index.push_back( entry );
+
+    m_timeEncoder.reset();
+    for ( Gorilla::ValueEncoder& encoder : m_valueEncoders ) encoder.reset();
+
+    m_blockCount = 0;
+
+    return result;
+}
+
+bool TelemetryArchive::Reader::open(const uchar* data, const qint64 size)
+{
+    close();
+
+    const qint64 begin = static_cast<qint64>( sizeof(TelemetryHeader) );
+
+    const TelemetryHeader* header = reinterpret_cast<const TelemetryHeader*>( data );
+
+    if ( size < begin || !header->isValid() || !( header->flags & TelemetryHeader::Compressed ) ) {
+        m_errorString = "not a compressed telemetry recording";
+        return false;
+    }
+
+    m_data = data;
+    m_size = size;
+
+    qint64 end = size;
+
+    if ( size >= begin + static_cast<qint64>( sizeof(TelemetryTrailer) ) ) {
+        const TelemetryTrailer* trailer = reinterpret_cast<const TelemetryTrailer*>( data + size - sizeof(TelemetryTrailer) );
+
+        if ( trailer->isValid( size ) && trailer->indexSize > 0 ) {
+            m_index  = reinterpret_cast<const BlockEntry*>( data + trailer->indexOffset );
+            m_blocks = trailer->indexSize;
+            m_stride = trailer->stride;
+            m_count  = ( m_blocks - 1 ) * m_stride + block( m_blocks - 1 )->samples;
+
+            end = trailer->indexOffset;
+        }
+    }
+
+    if ( !m_index ) {
+        // not indexed (e.g. interrupted) archive, complete blocks are counted
+        qint64 offset = begin;
+
+        while ( offset + static_cast<qint64>( sizeof(Block) ) <= end ) {
+            const Block* current = reinterpret_cast<const Block*>( data + offset );
+
+            qint64 bytes = sizeof(Block);
+            for ( const quint32 streamSize : current->sizes ) bytes += streamSize;
+
+            if ( offset + bytes > end || current->samples == 0 ) break;
+
+            if ( m_blocks == 0 ) m_stride = current->samples;
+
+            m_blocks++;
+            m_count += current->samples;
+
+            offset += bytes;
+        }
+    }
+
+    if ( m_count == 0 ) {
+        m_errorString = "no samples";
+        close();
+        return false;
+    }
+
+    // time of the last sample
+    const Block* last = block( m_blocks - 1 );
+
+    Gorilla::BitReader reader;
+    reader.reset( reinterpret_cast<const uchar*>( last + 1 ) );
+
+    Gorilla::TimeDecoder decoder;
+
+    for ( quint32 i = 0; i < last->samples; ++i ) m_lastTime = decoder.decode( &reader );
+
+    seek( 0 );
+
+    return true;
+}
+
+void TelemetryArchive::Reader::close()
+{
+    m_data  = nullptr;
+    m_size  = 0;
+    m_index = nullptr;
+
+    m_blocks = 0;
+    m_stride = 0;
+    m_count  = 0;
+
+    m_lastTime  = 0;
+    m_position  = 0;
+    m_blockLeft = 0;
+
+    m_walkIndex  = 0;
+    m_walkOffset = sizeof(TelemetryHeader);
+}
+
+void TelemetryArchive::Reader::seek(const qint64 sample)
+{
+    if ( sample >= m_count ) {
+        m_position  = m_count;
+        m_blockLeft = 0;
+        return;
+    }
+
+    const qint64 target = qMax( Q_INT64_C(0), sample );
+
+    loadBlock( target / m_stride );
+
+    TelemetrySample skipped;
+    while ( m_position < target ) decode( &skipped );
+}
+
+qint64 TelemetryArchive::Reader::find(const qint64 time) const
+{
+    qint64 index = 0;
+
+    if ( m_index ) {
+        const BlockEntry* entry = std::upper_bound( m_index, m_index + m_blocks, time,
+            []( const qint64 t, const BlockEntry& e ) { return t < e.time; } );
+
+        index = qMax( Q_INT64_C(0), static_cast<qint64>( entry - m_index ) - 1 );
+    } else {
+        // first timestamp of a block is stored as is
+        while ( index + 1 < m_blocks
+                && static_cast<qint64>( qFromBigEndian<quint64>( block( index + 1 ) + 1 ) ) <= time )
+        {
+            index++;
+        }
+    }
+
+    // only the timestamps stream of the block is decoded
+    const Block* current = block( index );
+
+    Gorilla::BitReader reader;
+    reader.reset( reinterpret_cast<const uchar*>( current + 1 ) );
+
+    Gorilla::TimeDecoder decoder;
+
+    qint64 sample = index * m_stride;
+
+    for ( quint32 i = 0; i < current->samples; ++i ) {
+        if ( decoder.decode( &reader ) > time ) break;
+        sample = index * m_stride + i;
+    }
+
+    return sample;
+}
+
+int TelemetryArchive::Reader::read(TelemetrySample* samples, const int count)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    int decoded = 0;
+
+    while ( decoded < count && m_position < m_count ) {
+        if ( m_blockLeft == 0 ) loadBlock( m_position / m_stride );
+
+        decode( &samples[ decoded ] );
+        decoded++;
+    }
+
+    m_decoded    += decoded;
+    m_decodeTime += timer.nsecsElapsed();
+
+    return decoded;
+}
+
+double TelemetryArchive::Reader::compressionRatio() const
+{
+    return m_size > 0 ? static_cast<double>( m_count * sizeof(TelemetrySample) ) / m_size : 0.0;
+}
+
+double TelemetryArchive::Reader::throughput() const
+{
+    return m_decodeTime > 0 ? 1.0e9 * m_decoded / m_decodeTime : 0.0;
+}
+
+void TelemetryArchive::Reader::resetCounters()
+{
+    m_decoded    = 0;
+    m_decodeTime = 0;
+}
+
+const TelemetryArchive::Block* TelemetryArchive::Reader::block(const qint64 index) const
+{
+    if ( m_index ) return reinterpret_cast<const Block*>( m_data + m_index[ index ].offset );
+
+    // blocks of not indexed archive are walked through from the last visited one
+    if ( index < m_walkIndex ) {
+        m_walkIndex  = 0;
+        m_walkOffset = sizeof(TelemetryHeader);
+    }
+
+    while ( m_walkIndex < index ) {
+        const Block* current = reinterpret_cast<const Block*>( m_data + m_walkOffset );
+
+        m_walkOffset += sizeof(Block);
+        for ( const quint32 streamSize : current->sizes ) m_walkOffset += streamSize;
+
+        m_walkIndex++;
+    }
+
+    return reinterpret_cast<const Block*>( m_data + m_walkOffset );
+}
+
+void TelemetryArchive::Reader::loadBlock(const qint64 index)
+{
+    const Block* current = block( index );
+    const uchar* stream = reinterpret_cast<const uchar*>( current + 1 );
+
+    for ( int i = 0; i < Streams; ++i ) {
+        m_readers[ i ].reset( stream );
+        stream += current->sizes[ i ];
+    }
+
+    m_timeDecoder.reset();
+    for ( Gorilla::ValueDecoder& decoder : m_valueDecoders ) decoder.reset();
+
+    m_position  = index * m_stride;
+    m_blockLeft = current->samples;
+}
+
+}
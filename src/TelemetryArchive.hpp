@@ -0,0 +1,277 @@
+/***************************************************************************//**
+ * @file TelemetryArchive.h
+ * @author  Marek M. Cel <marekcel@marekcel.pl>
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * This file is part of QFlightInstruments. You can redistribute and modify it
+ * under the terms of GNU General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.
+ * 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ *
+ * Further information about the GNU General Public License can also be found
+ * on the world wide web at http://www.gnu.org.
+ *
+ * ---
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef __qfi_TelemetryArchive_H__
+#define __qfi_TelemetryArchive_H__
+
+#include <QFile>
+#include <QString>
+#include <QVector>
+
+#include <vector>
+
+#include "Gorilla.hpp"
+#include "Telemetry.hpp"
+
+namespace qfi {
+
+//---------------------------------------------------
+// Class: TelemetryArchive
+// Description: Columnar compressed telemetry recording, samples are
+// stored in blocks and every block holds one Gorilla compressed stream
+// per channel (timestamps and each of the sample values), the file is
+//
+//   header | blocks | block index | trailer
+//
+// where the header is flagged TelemetryHeader::Compressed and the index
+// holds time and offset of every block (see TelemetryHeader)
+//---------------------------------------------------
+class TelemetryArchive
+{
+public:
+
+    enum
+    {
+        Channels = 18,                  ///< number of the sample values
+        Streams  = Channels + 1         ///< values and timestamps
+    };
+
+    // block header, followed by the streams, timestamps first
+    struct Block
+    {
+        quint32 samples;                ///< number of samples
+        quint32 sizes[ Streams ];       ///< [B] stream sizes (including padding)
+    };
+
+    // block index entry
+    struct BlockEntry
+    {
+        qint64 time;                    ///< [ns] time of the first sample of the block
+        qint64 offset;                  ///< [B] block position in the file
+    };
+
+    // sample values in the streams order
+    static float TelemetrySample::* const channels[ Channels ];
+
+    //---------------------------------------------------
+    // Class: TelemetryArchive::Writer
+    // Description: Compresses samples into the archive file block by block
+    //---------------------------------------------------
+    class Writer
+    {
+    public:
+
+        Writer();
+        ~Writer();
+
+        // creates (truncates) archive file, returns false on error
+        bool open(const QString& fileName);
+
+        // writes the last block, block index and trailer and closes archive file
+        void close();
+
+        inline bool isOpen() const { return m_file.isOpen(); }
+
+        //
+        // compresses sample, timestamps have to be non-decreasing, returns
+        // false on error
+        //
+        bool write(const TelemetrySample& sample);
+
+        //
+        // sets number of samples per block (default 4096), to be set before
+        // opening the archive
+        //
+        void setBlockSamples(const int samples);
+
+        inline int blockSamples() const { return m_blockSamples; }
+
+        // number of written samples
+        inline qint64 samples() const { return m_samples; }
+
+        // size of the samples as plain records divided by size of the written file
+        double compressionRatio() const;
+
+        inline QString errorString() const { return m_file.errorString(); }
+
+    private:
+
+        bool writeBlock();
+
+        QFile m_file;
+
+        std::vector<uchar> m_streams[ Streams ];
+
+        Gorilla::BitWriter m_writers[ Streams ];
+
+        Gorilla::TimeEncoder m_timeEncoder;
+        Gorilla::ValueEncoder m_valueEncoders[ Channels ];
+
+        QVector<BlockEntry> m_index;
+
+        qint64 m_samples{};
+        qint64 m_bytes{};               ///< [B] written file size
+
+        qint64 m_blockTime{};           ///< [ns] time of the first sample of the current block
+
+        int m_blockSamples{4096};
+        int m_blockCount{};             ///< number of samples in the current block
+    };
+
+    //---------------------------------------------------
+    // Class: TelemetryArchive::Reader
+    // Description: Streaming decompression of the archive held in memory
+    // (e.g. memory mapped file), never allocates
+    //---------------------------------------------------
+    class Reader
+    {
+    public:
+
+        //
+        // opens archive of the whole file contents, data has to stay valid
+        // until the reader is closed or reopened, returns false on error
+        //
+        bool open(const uchar* data, const qint64 size);
+
+        void close();
+
+        inline bool isOpen() const { return m_data != nullptr; }
+
+        // returns true if the archive has block index
+        inline bool isIndexed() const { return m_index != nullptr; }
+
+        // number of samples
+        inline qint64 count() const { return m_count; }
+
+        // time of the last sample [ns]
+        inline qint64 lastTime() const { return m_lastTime; }
+
+        // index of the sample to be decoded next
+        inline qint64 position() const { return m_position; }
+
+        // moves to the given sample, next() decodes it
+        void seek(const qint64 sample);
+
+        //
+        // returns index of the latest sample not later than the given time,
+        // 0 if all are later, O(log n) using the block index
+        //
+        qint64 find(const qint64 time) const;
+
+        // decodes next sample, returns false at the end
+        inline bool next(TelemetrySample* sample) { return read( sample, 1 ) == 1; }
+
+        // decodes up to the given number of samples, returns number of decoded samples
+        int read(TelemetrySample* samples, const int count);
+
+        // size of the samples as plain records divided by size of the file
+        double compressionRatio() const;
+
+        // number of decoded samples
+        inline qint64 decoded() const { return m_decoded; }
+
+        // time spent decoding [ns]
+        inline qint64 decodeTime() const { return m_decodeTime; }
+
+        // decoded samples per second
+        double throughput() const;
+
+        // resets decoded samples and decode time counters
+        void resetCounters();
+
+        inline QString errorString() const { return m_errorString; }
+
+    private:
+
+        // returns header of the given block
+        const Block* block(const qint64 index) const;
+
+        void loadBlock(const qint64 index);
+
+        inline void decode(TelemetrySample* sample)
+        {
+            sample->time = m_timeDecoder.decode( &m_readers[ 0 ] );
+
+            for ( int i = 0; i < Channels; ++i ) {
+                sample->*channels[ i ] = m_valueDecoders[ i ].decode( &m_readers[ i + 1 ] );
+            }
+
+            m_blockLeft--;
+            m_position++;
+        }
+
+        const uchar* m_data{};
+        qint64 m_size{};
+
+        const BlockEntry* m_index{};    ///< block index, null if not indexed
+        qint64 m_blocks{};
+        qint64 m_stride{};              ///< samples per block
+
+        mutable qint64 m_walkIndex{};   ///< last visited block of not indexed archive
+        mutable qint64 m_walkOffset{};  ///< [B] its position
+
+        qint64 m_count{};
+        qint64 m_lastTime{};
+
+        qint64 m_position{};            ///< next sample
+        qint64 m_blockLeft{};           ///< samples left in the current block
+
+        Gorilla::BitReader m_readers[ Streams ];
+
+        Gorilla::TimeDecoder m_timeDecoder;
+        Gorilla::ValueDecoder m_valueDecoders[ Channels ];
+
+        qint64 m_decoded{};
+        qint64 m_decodeTime{};          ///< [ns]
+
+        QString m_errorString;
+    };
+};
+
+}
+
+#endif
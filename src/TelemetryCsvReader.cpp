@@ -0,0 +1,437 @@
+/***************************************************************************//**
+ * @file TelemetryCsvReader.cpp
+ * @author  Marek M. Cel <marekcel@marekcel.pl>
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * This file is part of QFlightInstruments. You can redistribute and modify it
+ * under the terms of GNU General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.
+ * 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ *
+ * Further information about the GNU General Public License can also be found
+ * on the world wide web at http://www.gnu.org.
+ *
+ * ---
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include "TelemetryCsvReader.hpp"
+
+#include <QElapsedTimer>
+#include <QList>
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace qfi {
+
+TelemetryCsvReader::TelemetryCsvReader()
+{
+    static const struct
+    {
+        const char* name;
+        float TelemetrySample::* member;
+    }
+    channels[] =
+    {
+        { "roll"        , &TelemetrySample::roll       },
+        { "pitch"       , &TelemetrySample::pitch      },
+        { "heading"     , &TelemetrySample::heading    },
+        { "alpha"       , &TelemetrySample::alpha      },
+        { "beta"        , &TelemetrySample::beta       },
+        { "slip_skid"   , &TelemetrySample::slipSkid   },
+        { "turn_rate"   , &TelemetrySample::turnRate   },
+        { "dev_h"       , &TelemetrySample::devH       },
+        { "dev_v"       , &TelemetrySample::devV       },
+        { "airspeed"    , &TelemetrySample::airspeed   },
+        { "mach"        , &TelemetrySample::mach       },
+        { "altitude"    , &TelemetrySample::altitude   },
+        { "pressure"    , &TelemetrySample::pressure   },
+        { "climb_rate"  , &TelemetrySample::climbRate  },
+        { "heading_bug" , &TelemetrySample::headingBug },
+        { "course"      , &TelemetrySample::course     },
+        { "bearing"     , &TelemetrySample::bearing    },
+        { "distance"    , &TelemetrySample::distance   }
+    };
+
+    for ( const auto& channel : channels ) m_channels.insert( channel.name, channel.member );
+}
+
+TelemetryCsvReader::~TelemetryCsvReader()
+{
+    close();
+}
+
+bool TelemetryCsvReader::open(const QString& fileName)
+{
+    close();
+
+    const bool opened = fileName == "-" ? m_file.open( stdin, QFile::ReadOnly )
+                                        : ( m_file.setFileName( fileName ), m_file.open( QFile::ReadOnly ) );
+
+    if ( !opened ) {
+        m_errorString = m_file.errorString();
+        return false;
+    }
+
+    const qint64 size = m_file.isSequential() ? 0 : m_file.size();
+
+    if ( size > 0 ) m_map = m_file.map( 0, size );
+
+    if ( m_map ) {
+        m_pos = reinterpret_cast<const char*>( m_map );
+        m_end = m_pos + size;
+    } else {
+        attach( &m_file );
+    }
+
+    return readHeader();
+}
+
+bool TelemetryCsvReader::open(QIODevice* device)
+{
+    close();
+
+    attach( device );
+
+    return readHeader();
+}
+
+void TelemetryCsvReader::close()
+{
+    if ( m_map ) {
+        m_file.unmap( m_map );
+        m_map = nullptr;
+    }
+
+    if ( m_file.isOpen() ) m_file.close();
+
+    m_device = nullptr;
+
+    m_pos   = nullptr;
+    m_end   = nullptr;
+    m_atEnd = false;
+
+    m_columns.clear();
+
+    m_timeColumn    = -1;
+    m_lastColumn    = -1;
+    m_mappedColumns = 0;
+}
+
+void TelemetryCsvReader::setChannel(const QByteArray& name, float TelemetrySample::* member)
+{
+    m_channels.insert( name.trimmed().toLower(), member );
+}
+
+void TelemetryCsvReader::setTimeColumn(const QByteArray& name, const double unit)
+{
+    m_timeName = name.trimmed().toLower();
+    m_timeUnit = unit;
+}
+
+void TelemetryCsvReader::setPeriod(const double period)
+{
+    m_period = period > 0.0 ? period : 0.0;
+}
+
+int TelemetryCsvReader::read(TelemetrySample* samples, const int count)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    int read = 0;
+
+    const char* begin = nullptr;
+    const char* end   = nullptr;
+
+    while ( read < count && nextLine( &begin, &end ) ) {
+        if ( begin == end ) continue;
+
+        if ( m_timeColumn < 0 ) m_sample.time = std::llround( 1.0e9 * m_period * m_samples );
+
+        parseLine( begin, end );
+
+        samples[ read++ ] = m_sample;
+        m_samples++;
+    }
+
+    m_parseTime += timer.nsecsElapsed();
+
+    return read;
+}
+
+double TelemetryCsvReader::throughput() const
+{
+    return m_parseTime > 0 ? 1.0e9 * m_bytes / m_parseTime : 0.0;
+}
+
+double TelemetryCsvReader::parseNumber(const char* begin, const char* end, const char** next)
+{
+    static const double powers[] =
+    {
+        1.0e0,  1.0e1,  1.0e2,  1.0e3,  1.0e4,  1.0e5,  1.0e6,  1.0e7,
+        1.0e8,  1.0e9,  1.0e10, 1.0e11, 1.0e12, 1.0e13, 1.0e14, 1.0e15,
+        1.0e16, 1.0e17, 1.0e18, 1.0e19, 1.0e20, 1.0e21, 1.0e22
+    };
+
+    const int maxPower = sizeof(powers) / sizeof(powers[0]) - 1;
+
+    const char* p = begin;
+
+    while ( p < end && ( *p == ' ' || *p == '\t' ) ) p++;
+
+    bool negative = false;
+
+    if ( p < end && ( *p == '-' || *p == '+' ) ) negative = *p++ == '-';
+
+    // digits beyond 18 do not fit the mantissa and only scale it
+    const quint64 limit = Q_UINT64_C(100000000000000000);
+
+    quint64 mantissa = 0;
+    int exponent = 0;
+    int digits   = 0;
+
+    for ( ; p < end && static_cast<unsigned>( *p - '0' ) < 10; ++p, ++digits ) {
+        if ( mantissa < limit ) {
+            mantissa = 10 * mantissa + static_cast<unsigned>( *p - '0' );
+        } else {
+            exponent++;
+        }
+    }
+
+    if ( p < end && *p == '.' ) {
+        for ( ++p; p < end && static_cast<unsigned>( *p - '0' ) < 10; ++p, ++digits ) {
+            if ( mantissa < limit ) {
+                mantissa = 10 * mantissa + static_cast<unsigned>( *p - '0' );
+                exponent--;
+            }
+        }
+    }
+
+    if ( digits == 0 ) {
+        *next = begin;
+        return 0.0;
+    }
+
+    if ( p < end && ( *p == 'e' || *p == 'E' ) ) {
+        const char* e = p + 1;
+
+        bool negativeExponent = false;
+
+        if ( e < end && ( *e == '-' || *e == '+' ) ) negativeExponent = *e++ == '-';
+
+        // "1e" or "1e-" is the number 1 followed by text
+        if ( e < end && static_cast<unsigned>( *e - '0' ) < 10 ) {
+            int value = 0;
+
+            for ( ; e < end && static_cast<unsigned>( *e - '0' ) < 10; ++e ) {
+                if ( value < 10000 ) value = 10 * value + ( *e - '0' );
+            }
+
+            exponent += negativeExponent ? -value : value;
+            p = e;
+        }
+    }
+
+    *next = p;
+
+    double value = static_cast<double>( mantissa );
+
+    // exact powers of ten give correctly rounded results of up to 15 digits
+    if ( exponent < 0 ) {
+        value = -exponent <= maxPower ? value / powers[ -exponent ] : value * std::pow( 10.0, exponent );
+    } else if ( exponent > 0 ) {
+        value = exponent <= maxPower ? value * powers[ exponent ] : value * std::pow( 10.0, exponent );
+    }
+
+    return negative ? -value : value;
+}
+
+bool TelemetryCsvReader::nextLine(const char** begin, const char** end)
+{
+    if ( !m_pos ) return false;
+
+    const char* newline = static_cast<const char*>( std::memchr( m_pos, '\n', m_end - m_pos ) );
+
+    // device data are read until the line is complete
+    while ( !newline && m_device && !m_atEnd ) {
+        const qint64 scanned = m_end - m_pos;
+
+        fill();
+
+        newline = static_cast<const char*>( std::memchr( m_pos + scanned, '\n', m_end - m_pos - scanned ) );
+    }
+
+    if ( !newline ) {
+        // the last line may have no line ending
+        if ( m_pos == m_end ) return false;
+        newline = m_end;
+    }
+
+    *begin = m_pos;
+    *end   = newline;
+
+    if ( *end > *begin && *( *end - 1 ) == '\r' ) ( *end )--;
+
+    m_pos = newline < m_end ? newline + 1 : m_end;
+
+    m_bytes += m_pos - *begin;
+    m_lines++;
+
+    return true;
+}
+
+void TelemetryCsvReader::attach(QIODevice* device)
+{
+    if ( m_buffer.empty() ) m_buffer.resize( BufferSize );
+
+    m_device = device;
+
+    m_pos = m_buffer.data();
+    m_end = m_buffer.data();
+}
+
+void TelemetryCsvReader::fill()
+{
+    const size_t left = static_cast<size_t>( m_end - m_pos );
+
+    std::memmove( m_buffer.data(), m_pos, left );
+
+    // the buffer grows only for lines longer than the buffer
+    if ( left == m_buffer.size() ) m_buffer.resize( 2 * m_buffer.size() );
+
+    const qint64 size = m_device->read( m_buffer.data() + left, static_cast<qint64>( m_buffer.size() - left ) );
+
+    if ( size <= 0 ) m_atEnd = true;
+
+    m_pos = m_buffer.data();
+    m_end = m_buffer.data() + left + qMax( size, Q_INT64_C(0) );
+}
+
+bool TelemetryCsvReader::readHeader()
+{
+    m_sample = TelemetrySample();
+
+    m_samples   = 0;
+    m_lines     = 0;
+    m_bytes     = 0;
+    m_errors    = 0;
+    m_parseTime = 0;
+
+    const char* begin = nullptr;
+    const char* end   = nullptr;
+
+    if ( !nextLine( &begin, &end ) ) {
+        m_errorString = "no header";
+        close();
+        return false;
+    }
+
+    // UTF-8 byte order mark
+    if ( end - begin >= 3 && std::memcmp( begin, "\xEF\xBB\xBF", 3 ) == 0 ) begin += 3;
+
+    // header is parsed once, its names may allocate
+    const QList<QByteArray> names = QByteArray( begin, static_cast<int>( end - begin ) ).split( ',' );
+
+    for ( const QByteArray& field : names ) {
+        QByteArray name = field.trimmed().toLower();
+
+        if ( name.size() >= 2 && name.startsWith( '"' ) && name.endsWith( '"' ) ) {
+            name = name.mid( 1, name.size() - 2 ).trimmed();
+        }
+
+        float TelemetrySample::* member = m_channels.value( name, nullptr );
+
+        if ( name == m_timeName ) {
+            m_timeColumn = m_columns.size();
+            member = nullptr;
+        }
+
+        if ( member || m_timeColumn == m_columns.size() ) {
+            m_lastColumn = m_columns.size();
+            m_mappedColumns++;
+        }
+
+        m_columns.append( member );
+    }
+
+    if ( m_mappedColumns == 0 ) {
+        m_errorString = "no known columns";
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+void TelemetryCsvReader::parseLine(const char* begin, const char* end)
+{
+    const char* field = begin;
+
+    // columns following the last mapped one are not even split
+    for ( int i = 0; i <= m_lastColumn && field <= end; ++i ) {
+        float TelemetrySample::* member = m_columns[ i ];
+
+        const char* next = field;
+
+        if ( member || i == m_timeColumn ) {
+            // numbers are parsed up to the separator, so the field is scanned once
+            const double value = parseNumber( field, end, &next );
+            const bool number = next != field;
+
+            while ( next < end && ( *next == ' ' || *next == '\t' ) ) next++;
+
+            // empty fields keep the previous value, text (e.g. "n/a") is an error
+            if ( next < end && *next != ',' ) {
+                m_errors++;
+            } else if ( number ) {
+                if ( member ) {
+                    m_sample.*member = static_cast<float>( value );
+                } else {
+                    m_sample.time = std::llround( value * m_timeUnit );
+                }
+            }
+        }
+
+        const char* comma = static_cast<const char*>( std::memchr( next, ',', end - next ) );
+
+        if ( !comma ) break;
+
+        field = comma + 1;
+    }
+}
+
+}
@@ -0,0 +1,217 @@
+/***************************************************************************//**
+ * @file TelemetryCsvReader.h
+ * @author  Marek M. Cel <marekcel@marekcel.pl>
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * This file is part of QFlightInstruments. You can redistribute and modify it
+ * under the terms of GNU General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.
+ * 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ *
+ * Further information about the GNU General Public License can also be found
+ * on the world wide web at http://www.gnu.org.
+ *
+ * ---
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef __qfi_TelemetryCsvReader_H__
+#define __qfi_TelemetryCsvReader_H__
+
+#include <QByteArray>
+#include <QFile>
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+#include <vector>
+
+#include "Telemetry.hpp"
+
+class QIODevice;
+
+namespace qfi {
+
+//---------------------------------------------------
+// Class: TelemetryCsvReader
+// Description: Streaming reader of comma separated telemetry logs, the
+// first line holds column names which are mapped to the sample values,
+// e.g.
+//
+//   time,roll,pitch,heading,airspeed,altitude
+//   0.00,1.5,2.0,270.0,120.0,1500.0
+//
+// Known columns (units as in the example application):
+//   time [s], roll, pitch, heading, alpha, beta [deg], slip_skid
+//   [-1.0 to 1.0], turn_rate [deg/s], dev_h, dev_v [-1.0 to 1.0],
+//   airspeed [kts], mach, altitude [ft], pressure [inHg], climb_rate
+//   [ft/min], heading_bug, course, bearing [deg], distance [NM]
+// other columns are skipped, values missing in a line are kept from the
+// previous one.
+//
+// Files are memory mapped, pipes and standard input are read in chunks
+// into a buffer allocated once. Numbers are parsed without the C locale
+// functions and reading never allocates per line.
+//---------------------------------------------------
+class TelemetryCsvReader
+{
+public:
+
+    TelemetryCsvReader();
+    ~TelemetryCsvReader();
+
+    //
+    // opens file and reads its header, "-" reads the standard input,
+    // files which cannot be mapped (e.g. named pipes) are read in chunks,
+    // returns false on error
+    //
+    bool open(const QString& fileName);
+
+    //
+    // reads header of the open device, e.g. a pipe or a process output,
+    // the device is read in chunks until it returns no more data and has
+    // to stay open until the reader is closed, returns false on error
+    //
+    bool open(QIODevice* device);
+
+    void close();
+
+    inline bool isOpen() const { return m_pos != nullptr; }
+
+    //
+    // maps column of the given name (case insensitive) to the sample value,
+    // e.g. for column names of legacy logs, to be set before opening
+    //
+    void setChannel(const QByteArray& name, float TelemetrySample::* member);
+
+    //
+    // sets name (case insensitive) of the time column and its unit in
+    // nanoseconds (default "time" in seconds), to be set before opening
+    //
+    void setTimeColumn(const QByteArray& name, const double unit = 1.0e9);
+
+    //
+    // sets period [s] of the samples stamped when the log has no time
+    // column (default 0.01 s)
+    //
+    void setPeriod(const double period);
+
+    // number of the columns mapped to the sample values and time
+    inline int mappedColumns() const { return m_mappedColumns; }
+
+    // reads next sample, returns false at the end
+    inline bool next(TelemetrySample* sample) { return read( sample, 1 ) == 1; }
+
+    // reads up to the given number of samples, returns number of read samples
+    int read(TelemetrySample* samples, const int count);
+
+    // number of read lines (including the header)
+    inline qint64 lines() const { return m_lines; }
+
+    // number of read bytes
+    inline qint64 bytes() const { return m_bytes; }
+
+    // number of fields which are not numbers
+    inline qint64 errors() const { return m_errors; }
+
+    // time spent parsing [ns]
+    inline qint64 parseTime() const { return m_parseTime; }
+
+    // parsed bytes per second
+    double throughput() const;
+
+    inline QString errorString() const { return m_errorString; }
+
+    //
+    // parses decimal number (e.g. "-12.5", "1e-3") of the text, leading
+    // spaces are skipped, sets next to the first not parsed character,
+    // returns 0.0 and sets next to begin if there is no number
+    //
+    static double parseNumber(const char* begin, const char* end, const char** next);
+
+private:
+
+    enum { BufferSize = 1 << 20 };      ///< [B] initial read buffer size
+
+    // returns next line without its line ending, false at the end
+    bool nextLine(const char** begin, const char** end);
+
+    // sets the device to be read into the buffer
+    void attach(QIODevice* device);
+
+    // reads more data of the device, keeping the unread part
+    void fill();
+
+    bool readHeader();
+
+    void parseLine(const char* begin, const char* end);
+
+    QFile m_file;
+
+    QIODevice* m_device{};              ///< read device, null if mapped
+
+    uchar* m_map{};
+
+    std::vector<char> m_buffer;
+
+    const char* m_pos{};                ///< next unread character
+    const char* m_end{};                ///< end of the read data
+
+    bool m_atEnd{};                     ///< device returns no more data
+
+    QHash<QByteArray, float TelemetrySample::*> m_channels;
+
+    QVector<float TelemetrySample::*> m_columns;   ///< value of every column, null if skipped
+
+    QByteArray m_timeName{"time"};
+    double m_timeUnit{1.0e9};           ///< [ns] time column unit
+    double m_period{0.01};              ///< [s]
+
+    int m_timeColumn{-1};               ///< -1 if none
+    int m_lastColumn{-1};               ///< last mapped column
+    int m_mappedColumns{};
+
+    TelemetrySample m_sample;           ///< last read sample
+
+    qint64 m_samples{};
+    qint64 m_lines{};
+    qint64 m_bytes{};
+    qint64 m_errors{};
+    qint64 m_parseTime{};               ///< [ns]
+
+    QString m_errorString;
+};
+
+}
+
+#endif
@@ -0,0 +1,164 @@
+/***************************************************************************//**
+ * @file TelemetryRecorder.cpp
+ * @author  Marek M. Cel <marekcel@marekcel.pl>
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * This file is part of QFlightInstruments. You can redistribute and modify it
+ * under the terms of GNU General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.
+ * 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ *
+ * Further information about the GNU General Public License can also be found
+ * on the world wide web at http://www.gnu.org.
+ *
+ * ---
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include "TelemetryRecorder.hpp"
+
+#include <cstring>
+
+namespace qfi {
+
+TelemetryRecorder::~TelemetryRecorder()
+{
+    close();
+}
+
+bool TelemetryRecorder::open(const QString& fileName)
+{
+    close();
+
+    m_samples = 0;
+
+    if ( m_compressed ) {
+        // every compressed block has its index entry
+        m_archive.setBlockSamples( m_indexStride );
+
+        if ( !m_archive.open( fileName ) ) return false;
+
+        m_clock.start();
+
+        return true;
+    }
+
+    m_file.setFileName( fileName );
+
+    if ( !m_file.open( QFile::WriteOnly | QFile::Truncate ) ) return false;
+
+    const TelemetryHeader header = TelemetryHeader::current();
+
+    if ( m_file.write( reinterpret_cast<const char*>( &header ), sizeof(header) ) != sizeof(header) ) {
+        m_file.close();
+        return false;
+    }
+
+    m_index.clear();
+    m_clock.start();
+
+    return true;
+}
+
+void TelemetryRecorder::close()
+{
+    m_archive.close();
+
+    if ( !m_file.isOpen() ) return;
+
+    TelemetryTrailer trailer;
+
+    trailer.indexOffset = m_file.pos();
+    trailer.indexSize   = m_index.size();
+    trailer.stride      = static_cast<quint32>( m_indexStride );
+    std::memcpy( trailer.magic, TelemetryTrailer::Magic, sizeof(trailer.magic) );
+
+    const qint64 indexBytes = m_index.size() * static_cast<qint64>( sizeof(TelemetryIndexEntry) );
+
+    const bool indexed =
+            m_file.write( reinterpret_cast<const char*>( m_index.constData() ), indexBytes ) == indexBytes
+         && m_file.write( reinterpret_cast<const char*>( &trailer ), sizeof(trailer) ) == sizeof(trailer);
+
+    // recording without the index is still valid, it is just not indexed
+    if ( !indexed ) m_file.resize( trailer.indexOffset );
+
+    m_file.close();
+    m_index.clear();
+}
+
+bool TelemetryRecorder::record(const TelemetrySample& sample)
+{
+    TelemetrySample stamped = sample;
+    stamped.time = m_clock.nsecsElapsed();
+
+    return write( stamped );
+}
+
+bool TelemetryRecorder::write(const TelemetrySample& sample)
+{
+    if ( m_archive.isOpen() ) {
+        if ( !m_archive.write( sample ) ) return false;
+
+        m_samples++;
+
+        return true;
+    }
+
+    if ( !m_file.isOpen() ) return false;
+
+    // QFile buffers small writes itself
+    if ( m_file.write( reinterpret_cast<const char*>( &sample ), sizeof(sample) ) != sizeof(sample) ) {
+        return false;
+    }
+
+    if ( m_samples % m_indexStride == 0 ) {
+        TelemetryIndexEntry entry;
+
+        entry.time   = sample.time;
+        entry.sample = m_samples;
+
+        m_index.push_back( entry );
+    }
+
+    m_samples++;
+
+    return true;
+}
+
+void TelemetryRecorder::setIndexStride(const int stride)
+{
+    m_indexStride = stride > 0 ? stride : 1;
+}
+
+}
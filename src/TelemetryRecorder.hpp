@@ -0,0 +1,143 @@
+/***************************************************************************//**
+ * @file TelemetryRecorder.h
+ * @author  Marek M. Cel <marekcel@marekcel.pl>
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * This file is part of QFlightInstruments. You can redistribute and modify it
+ * under the terms of GNU General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.
+ * 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ *
+ * Further information about the GNU General Public License can also be found
+ * on the world wide web at http://www.gnu.org.
+ *
+ * ---
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef __qfi_TelemetryRecorder_H__
+#define __qfi_TelemetryRecorder_H__
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QString>
+#include <QVector>
+
+#include "Telemetry.hpp"
+#include "TelemetryArchive.hpp"
+
+namespace qfi {
+
+//---------------------------------------------------
+// Class: TelemetryRecorder
+// Description: Records timestamped instruments states of a live session
+// into a telemetry recording file to be replayed by TelemetryReplay
+//---------------------------------------------------
+class TelemetryRecorder
+{
+public:
+
+    TelemetryRecorder() = default;
+    ~TelemetryRecorder();
+
+    //
+    // creates (truncates) recording file and starts recording clock,
+    // returns false on error
+    //
+    bool open(const QString& fileName);
+
+    // writes time index, flushes and closes recording file
+    void close();
+
+    inline bool isOpen() const { return m_file.isOpen() || m_archive.isOpen(); }
+
+    //
+    // records sample stamped with the time elapsed since the recording
+    // has been opened, samples are buffered and never allocate
+    //
+    bool record(const TelemetrySample& sample);
+
+    //
+    // records sample with its own timestamp, e.g. when converting other
+    // recordings, timestamps have to be non-decreasing
+    //
+    bool write(const TelemetrySample& sample);
+
+    // number of recorded samples
+    inline qint64 samples() const { return m_samples; }
+
+    //
+    // sets number of samples per time index entry (default 1024), which
+    // is also the number of samples per block of compressed recording, to
+    // be set before opening the recording
+    //
+    void setIndexStride(const int stride);
+
+    inline int indexStride() const { return m_indexStride; }
+
+    //
+    // enables compressed recording (see TelemetryArchive), usually several
+    // times smaller, to be set before opening the recording
+    //
+    inline void setCompressed(const bool compressed) { m_compressed = compressed; }
+
+    inline bool isCompressed() const { return m_compressed; }
+
+    // compressed recording encoder, e.g. for its compression ratio
+    inline const TelemetryArchive::Writer& archive() const { return m_archive; }
+
+    inline QString errorString() const
+    {
+        return m_compressed ? m_archive.errorString() : m_file.errorString();
+    }
+
+private:
+
+    QFile m_file;
+
+    TelemetryArchive::Writer m_archive;
+
+    QElapsedTimer m_clock;
+
+    QVector<TelemetryIndexEntry> m_index;
+
+    qint64 m_samples{};
+
+    int m_indexStride{1024};
+
+    bool m_compressed{};
+};
+
+}
+
+#endif
@@ -0,0 +1,245 @@
+/***************************************************************************//**
+ * @file TelemetryReplay.cpp
+ * @author  Marek M. Cel <marekcel@marekcel.pl>
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * This file is part of QFlightInstruments. You can redistribute and modify it
+ * under the terms of GNU General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.
+ * 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ *
+ * Further information about the GNU General Public License can also be found
+ * on the world wide web at http://www.gnu.org.
+ *
+ * ---
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include "TelemetryReplay.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace qfi {
+
+TelemetryReplay::~TelemetryReplay()
+{
+    close();
+}
+
+bool TelemetryReplay::open(const QString& fileName)
+{
+    close();
+
+    m_file.setFileName( fileName );
+
+    if ( !m_file.open( QFile::ReadOnly ) ) {
+        m_errorString = m_file.errorString();
+        return false;
+    }
+
+    const qint64 size = m_file.size();
+
+    if ( size < static_cast<qint64>( sizeof(TelemetryHeader) + sizeof(TelemetrySample) ) ) {
+        m_errorString = "no samples";
+        m_file.close();
+        return false;
+    }
+
+    m_map = m_file.map( 0, size );
+
+    if ( !m_map ) {
+        m_errorString = m_file.errorString();
+        m_file.close();
+        return false;
+    }
+
+    if ( !reinterpret_cast<const TelemetryHeader*>( m_map )->isValid() ) {
+        m_errorString = "not a telemetry recording of the current format";
+        close();
+        return false;
+    }
+
+    if ( reinterpret_cast<const TelemetryHeader*>( m_map )->flags & TelemetryHeader::Compressed ) {
+        if ( !m_archive.open( m_map, size ) ) {
+            m_errorString = m_archive.errorString();
+            close();
+            return false;
+        }
+
+        m_count   = m_archive.count();
+        m_endTime = m_archive.lastTime();
+    } else {
+        const qint64 samplesBegin = sizeof(TelemetryHeader);
+
+        qint64 samplesEnd = size;
+
+        if ( size >= samplesBegin + static_cast<qint64>( sizeof(TelemetryTrailer) ) ) {
+            const TelemetryTrailer* trailer =
+                    reinterpret_cast<const TelemetryTrailer*>( m_map + size - sizeof(TelemetryTrailer) );
+
+            if ( trailer->isValid( size )
+                 && ( trailer->indexOffset - samplesBegin ) % static_cast<qint64>( sizeof(TelemetrySample) ) == 0 )
+            {
+                m_timeIndex     = reinterpret_cast<const TelemetryIndexEntry*>( m_map + trailer->indexOffset );
+                m_timeIndexSize = trailer->indexSize;
+                samplesEnd      = trailer->indexOffset;
+            }
+        }
+
+        // a trailing partial record (e.g. of an interrupted recording) is ignored
+        m_samples = reinterpret_cast<const TelemetrySample*>( m_map + samplesBegin );
+        m_count   = ( samplesEnd - samplesBegin ) / static_cast<qint64>( sizeof(TelemetrySample) );
+
+        if ( m_count == 0 ) {
+            m_errorString = "no samples";
+            close();
+            return false;
+        }
+
+        m_endTime = m_samples[ m_count - 1 ].time;
+    }
+
+    load( 0 );
+
+    m_startTime = current().time;
+    m_time      = m_startTime;
+
+    return true;
+}
+
+void TelemetryReplay::close()
+{
+    if ( m_map ) {
+        m_file.unmap( m_map );
+        m_map = nullptr;
+    }
+
+    if ( m_file.isOpen() ) m_file.close();
+
+    m_archive.close();
+
+    m_samples = nullptr;
+    m_count   = 0;
+
+    m_startTime = 0;
+    m_endTime   = 0;
+
+    m_timeIndex     = nullptr;
+    m_timeIndexSize = 0;
+    m_index   = 0;
+    m_time    = 0;
+}
+
+void TelemetryReplay::setSpeed(const double speed)
+{
+    m_speed = speed > 0.0 ? speed : 0.0;
+}
+
+const TelemetrySample& TelemetryReplay::advance(const double timeStep)
+{
+    if ( !m_paused ) {
+        m_time += static_cast<qint64>( std::llround( 1.0e9 * timeStep * m_speed ) );
+
+        // samples are in time order, a frame usually moves by a few of them
+        while ( m_index + 1 < m_count && nextTime() <= m_time ) forward();
+    }
+
+    return current();
+}
+
+const TelemetrySample& TelemetryReplay::step(const qint64 samples)
+{
+    load( qBound( Q_INT64_C(0), m_index + samples, m_count - 1 ) );
+
+    m_time = current().time;
+
+    m_paused = true;
+
+    return current();
+}
+
+const TelemetrySample& TelemetryReplay::seek(const qint64 time)
+{
+    m_time = qMax( time, m_startTime );
+
+    // block index of compressed recording narrows the search down to a single block
+    if ( !m_samples ) {
+        load( m_archive.find( time ) );
+        return current();
+    }
+
+    qint64 first = 0;
+    qint64 last  = m_count;
+
+    // index narrows the search down to a single stride of samples
+    if ( m_timeIndex ) {
+        const TelemetryIndexEntry* entry = std::upper_bound( m_timeIndex, m_timeIndex + m_timeIndexSize, time,
+            []( const qint64 t, const TelemetryIndexEntry& e ) { return t < e.time; } );
+
+        if ( entry != m_timeIndex ) first = ( entry - 1 )->sample;
+        if ( entry != m_timeIndex + m_timeIndexSize ) last = entry->sample;
+
+        first = qBound( Q_INT64_C(0), first, m_count - 1 );
+        last  = qBound( first + 1, last, m_count );
+    }
+
+    const TelemetrySample* sample = std::upper_bound( m_samples + first, m_samples + last, time,
+        []( const qint64 t, const TelemetrySample& s ) { return t < s.time; } );
+
+    m_index = qMax( Q_INT64_C(0), static_cast<qint64>( sample - m_samples ) - 1 );
+
+    return current();
+}
+
+void TelemetryReplay::rewind()
+{
+    load( 0 );
+
+    m_time = m_startTime;
+}
+
+void TelemetryReplay::load(const qint64 index)
+{
+    m_index = index;
+
+    if ( m_samples || m_count == 0 ) return;
+
+    m_archive.seek( index );
+    m_archive.next( &m_current );
+
+    if ( index + 1 < m_count ) m_archive.next( &m_next );
+}
+
+}
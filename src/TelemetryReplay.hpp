@@ -0,0 +1,208 @@
+/***************************************************************************//**
+ * @file TelemetryReplay.h
+ * @author  Marek M. Cel <marekcel@marekcel.pl>
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * This file is part of QFlightInstruments. You can redistribute and modify it
+ * under the terms of GNU General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.
+ * 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ *
+ * Further information about the GNU General Public License can also be found
+ * on the world wide web at http://www.gnu.org.
+ *
+ * ---
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef __qfi_TelemetryReplay_H__
+#define __qfi_TelemetryReplay_H__
+
+#include <QFile>
+#include <QString>
+
+#include "Telemetry.hpp"
+#include "TelemetryArchive.hpp"
+
+namespace qfi {
+
+//---------------------------------------------------
+// Class: TelemetryReplay
+// Description: Replays telemetry recording at real time, N times faster
+// or slower, or frame by frame, the recording file is memory mapped and
+// the samples are read in place without any parsing nor copying, opening
+// does not depend on the file size and replay never allocates, compressed
+// recordings (see TelemetryArchive) are decoded on the fly sample by sample
+//---------------------------------------------------
+class TelemetryReplay
+{
+public:
+
+    TelemetryReplay() = default;
+    ~TelemetryReplay();
+
+    // maps recording file, returns false on error
+    bool open(const QString& fileName);
+
+    // unmaps and closes recording file
+    void close();
+
+    inline bool isOpen() const { return m_map != nullptr; }
+
+    // returns true if the recording is compressed
+    inline bool isCompressed() const { return m_archive.isOpen(); }
+
+    // number of samples
+    inline qint64 count() const { return m_count; }
+
+    // time of the first sample [ns]
+    inline qint64 startTime() const { return m_startTime; }
+
+    // recording duration [ns]
+    inline qint64 duration() const { return m_endTime - m_startTime; }
+
+    //
+    // sample of the given index, index has to be in range from 0 to count() - 1,
+    // not compressed recordings only
+    //
+    inline const TelemetrySample& sample(const qint64 index) const { return m_samples[ index ]; }
+
+    // current sample, the latest one not later than the replay time
+    inline const TelemetrySample& current() const
+    {
+        return m_samples ? m_samples[ m_index ] : m_current;
+    }
+
+    // current sample index
+    inline qint64 index() const { return m_index; }
+
+    // replay time [ns], in the recording time base
+    inline qint64 time() const { return m_time; }
+
+    // returns true if the last sample has been reached
+    inline bool atEnd() const { return m_index + 1 >= m_count; }
+
+    // sets replay speed, 1.0 (default) is real time
+    void setSpeed(const double speed);
+
+    inline double speed() const { return m_speed; }
+
+    // pauses/resumes replay
+    inline void setPaused(const bool paused) { m_paused = paused; }
+
+    inline bool isPaused() const { return m_paused; }
+
+    //
+    // advances replay time by the given time step [s] multiplied by
+    // the replay speed unless paused, returns current sample, e.g. to be
+    // called on every RenderScheduler::frame()
+    //
+    const TelemetrySample& advance(const double timeStep);
+
+    //
+    // moves by the given number of samples (negative moves back) and
+    // pauses replay, returns current sample
+    //
+    const TelemetrySample& step(const qint64 samples = 1);
+
+    //
+    // moves to the latest sample not later than the given time [ns] (in
+    // the recording time base), O(log n) using the recording time index,
+    // replay state (speed, pause) is kept, returns current sample
+    //
+    const TelemetrySample& seek(const qint64 time);
+
+    // returns true if the recording has time index
+    inline bool isIndexed() const { return m_timeIndex != nullptr || m_archive.isIndexed(); }
+
+    // moves back to the first sample
+    void rewind();
+
+    // compressed recording decoder, e.g. for its compression ratio and throughput
+    inline const TelemetryArchive::Reader& archive() const { return m_archive; }
+
+    inline QString errorString() const { return m_errorString; }
+
+private:
+
+    // moves to the given sample
+    void load(const qint64 index);
+
+    // time of the sample following the current one
+    inline qint64 nextTime() const
+    {
+        return m_samples ? m_samples[ m_index + 1 ].time : m_next.time;
+    }
+
+    // moves to the following sample
+    inline void forward()
+    {
+        m_index++;
+
+        if ( !m_samples ) {
+            m_current = m_next;
+            if ( m_index + 1 < m_count ) m_archive.next( &m_next );
+        }
+    }
+
+    QFile m_file;
+
+    uchar* m_map{};
+
+    const TelemetrySample* m_samples{};     ///< samples of not compressed recording
+
+    TelemetryArchive::Reader m_archive;     ///< compressed recording decoder
+
+    TelemetrySample m_current;              ///< current decoded sample
+    TelemetrySample m_next;                 ///< following decoded sample
+
+    const TelemetryIndexEntry* m_timeIndex{};
+
+    qint64 m_timeIndexSize{};
+
+    qint64 m_count{};
+    qint64 m_startTime{};               ///< [ns]
+    qint64 m_endTime{};                 ///< [ns]
+    qint64 m_index{};
+    qint64 m_time{};                    ///< [ns]
+
+    double m_speed{1.0};
+
+    bool m_paused{};
+
+    QString m_errorString;
+};
+
+}
+
+#endif
@@ -0,0 +1,266 @@
+/***************************************************************************//**
+ * @file TelemetryRing.cpp
+ * @author  Marek M. Cel <marekcel@marekcel.pl>
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * This file is part of QFlightInstruments. You can redistribute and modify it
+ * under the terms of GNU General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.
+ * 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ *
+ * Further information about the GNU General Public License can also be found
+ * on the world wide web at http://www.gnu.org.
+ *
+ * ---
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include "TelemetryRing.hpp"
+
+#include <QFile>
+
+#include <cstring>
+
+#ifdef Q_OS_UNIX
+#   include <cerrno>
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+namespace qfi {
+
+const char* const TelemetryRing::Header::Magic = "QFIR";
+
+bool TelemetryRing::Header::isValid() const
+{
+    return std::memcmp( magic, Magic, sizeof(magic) ) == 0
+        && version == Version
+        && recordSize == sizeof(TelemetrySample)
+        && capacity > 0 && ( capacity & ( capacity - 1 ) ) == 0;
+}
+
+namespace {
+
+std::size_t mappingSize(const quint32 capacity)
+{
+    return sizeof(TelemetryRing::Header) + capacity * sizeof(TelemetryRing::Slot);
+}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TelemetryRing::Writer::~Writer()
+{
+    close();
+}
+
+bool TelemetryRing::Writer::open(const QString& name, const int capacity)
+{
+    close();
+
+#ifdef Q_OS_UNIX
+    quint32 count = 2;
+    while ( static_cast<int>( count ) < capacity && count < 0x40000000u ) count <<= 1;
+
+    const std::size_t size = mappingSize( count );
+    const QByteArray path = QFile::encodeName( name );
+
+    int fd = ::shm_open( path.constData(), O_RDWR | O_CREAT, 0644 );
+
+    struct stat info;
+
+    if ( fd >= 0 && ::fstat( fd, &info ) == 0
+         && info.st_size != 0 && static_cast<std::size_t>( info.st_size ) != size )
+    {
+        // object of another capacity is replaced, its readers keep the old mapping until reopened
+        ::close( fd );
+        ::shm_unlink( path.constData() );
+        fd = ::shm_open( path.constData(), O_RDWR | O_CREAT | O_EXCL, 0644 );
+    }
+
+    if ( fd < 0 || ::ftruncate( fd, static_cast<off_t>( size ) ) != 0 ) {
+        m_errorString = std::strerror( errno );
+        if ( fd >= 0 ) ::close( fd );
+        return false;
+    }
+
+    void* map = ::mmap( nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+
+    // mapping stays valid after the descriptor is closed
+    ::close( fd );
+
+    if ( map == MAP_FAILED ) {
+        m_errorString = std::strerror( errno );
+        return false;
+    }
+
+    m_header = static_cast<Header*>( map );
+    m_slots  = reinterpret_cast<Slot*>( static_cast<char*>( map ) + sizeof(Header) );
+    m_size   = size;
+    m_mask   = count - 1;
+
+    if ( m_header->isValid() && m_header->capacity == count ) {
+        // restarted producer continues the sequence, so that readers keep following it
+        m_head = m_header->head.load( std::memory_order_relaxed );
+    } else {
+        std::memset( map, 0, size );
+
+        m_header->version    = Header::Version;
+        m_header->recordSize = sizeof(TelemetrySample);
+        m_header->capacity   = count;
+
+        // magic is written last, readers reject the object until it is initialized
+        std::atomic_thread_fence( std::memory_order_release );
+        std::memcpy( m_header->magic, Header::Magic, sizeof(m_header->magic) );
+
+        m_head = 0;
+    }
+
+    return true;
+#else
+    Q_UNUSED( name )
+    Q_UNUSED( capacity )
+
+    m_errorString = "shared memory is not supported on this platform";
+    return false;
+#endif
+}
+
+void TelemetryRing::Writer::close()
+{
+#ifdef Q_OS_UNIX
+    if ( m_header ) ::munmap( m_header, m_size );
+#endif
+
+    m_header = nullptr;
+    m_slots  = nullptr;
+    m_size   = 0;
+    m_mask   = 0;
+    m_head   = 0;
+}
+
+bool TelemetryRing::Writer::unlink(const QString& name)
+{
+#ifdef Q_OS_UNIX
+    return ::shm_unlink( QFile::encodeName( name ).constData() ) == 0;
+#else
+    Q_UNUSED( name )
+    return false;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TelemetryRing::Reader::~Reader()
+{
+    close();
+}
+
+bool TelemetryRing::Reader::open(const QString& name)
+{
+    close();
+
+#ifdef Q_OS_UNIX
+    const int fd = ::shm_open( QFile::encodeName( name ).constData(), O_RDONLY, 0 );
+
+    if ( fd < 0 ) {
+        m_errorString = std::strerror( errno );
+        return false;
+    }
+
+    struct stat info;
+
+    if ( ::fstat( fd, &info ) != 0 || static_cast<std::size_t>( info.st_size ) < sizeof(Header) ) {
+        m_errorString = "not a telemetry ring";
+        ::close( fd );
+        return false;
+    }
+
+    const std::size_t size = static_cast<std::size_t>( info.st_size );
+
+    void* map = ::mmap( nullptr, size, PROT_READ, MAP_SHARED, fd, 0 );
+
+    ::close( fd );
+
+    if ( map == MAP_FAILED ) {
+        m_errorString = std::strerror( errno );
+        return false;
+    }
+
+    const Header* header = static_cast<const Header*>( map );
+
+    if ( !header->isValid() || mappingSize( header->capacity ) != size ) {
+        m_errorString = "not a telemetry ring of the current format";
+        ::munmap( map, size );
+        return false;
+    }
+
+    std::atomic_thread_fence( std::memory_order_acquire );
+
+    m_header = header;
+    m_slots  = reinterpret_cast<const Slot*>( static_cast<const char*>( map ) + sizeof(Header) );
+    m_size   = size;
+    m_mask   = header->capacity - 1;
+    m_lost   = 0;
+
+    // the latest sample is the first one read
+    const quint64 head = m_header->head.load( std::memory_order_acquire );
+    m_tail = head > 0 ? head - 1 : 0;
+
+    return true;
+#else
+    Q_UNUSED( name )
+
+    m_errorString = "shared memory is not supported on this platform";
+    return false;
+#endif
+}
+
+void TelemetryRing::Reader::close()
+{
+#ifdef Q_OS_UNIX
+    if ( m_header ) ::munmap( const_cast<Header*>( m_header ), m_size );
+#endif
+
+    m_header = nullptr;
+    m_slots  = nullptr;
+    m_size   = 0;
+    m_mask   = 0;
+    m_tail   = 0;
+}
+
+}
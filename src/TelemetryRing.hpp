@@ -0,0 +1,296 @@
+/***************************************************************************//**
+ * @file TelemetryRing.h
+ * @author  Marek M. Cel <marekcel@marekcel.pl>
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * This file is part of QFlightInstruments. You can redistribute and modify it
+ * under the terms of GNU General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.
+ * 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ *
+ * Further information about the GNU General Public License can also be found
+ * on the world wide web at http://www.gnu.org.
+ *
+ * ---
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef __qfi_TelemetryRing_H__
+#define __qfi_TelemetryRing_H__
+
+#include <QString>
+
+#include <atomic>
+#include <cstddef>
+
+#include "Telemetry.hpp"
+
+// the ring is shared between processes, so the atomics must not be emulated with locks
+static_assert( ATOMIC_LLONG_LOCK_FREE == 2, "64-bit atomics are not lock-free" );
+
+namespace qfi {
+
+//---------------------------------------------------
+// Class: TelemetryRing
+// Description: Single producer ring of telemetry samples in POSIX shared
+// memory, e.g. published by a simulator process at its own rate and polled
+// by the instruments at frame time, the shared object is
+//
+//   header | slots
+//
+// every slot is guarded by its own sequence number (a seqlock), so the
+// producer never waits for the readers and a reader lagging behind by the
+// whole ring detects the overwritten samples instead of reading torn ones,
+// writing and reading are plain memory accesses without any system calls,
+// both processes have to be built for the same architecture
+//---------------------------------------------------
+class TelemetryRing
+{
+public:
+
+    enum
+    {
+        DefaultCapacity = 1024          ///< default number of slots
+    };
+
+    // shared object header
+    struct Header
+    {
+        char magic[4];                  ///< "QFIR"
+        quint32 version;                ///< format version
+        quint32 recordSize;             ///< sizeof(TelemetrySample)
+        quint32 capacity;               ///< number of slots (power of 2)
+
+        alignas(64) std::atomic<quint64> head; ///< number of written samples
+
+        static const char* const Magic;
+        static const quint32 Version{1};
+
+        // returns true if the header is the one of a supported format
+        bool isValid() const;
+    };
+
+    // slot, a cache line multiple so that neighbouring slots do not share lines
+    struct alignas(64) Slot
+    {
+        std::atomic<quint64> sequence;  ///< 2n+1 while writing sample n, 2n+2 once written
+        TelemetrySample sample;
+    };
+
+    //---------------------------------------------------
+    // Class: TelemetryRing::Writer
+    // Description: Publishes samples into the ring, a single writer at
+    // a time per shared object
+    //---------------------------------------------------
+    class Writer
+    {
+    public:
+
+        Writer() = default;
+        ~Writer();
+
+        Writer(const Writer&) = delete;
+        Writer& operator=(const Writer&) = delete;
+
+        //
+        // creates shared memory object of the given name (e.g. "/qfi") with
+        // the given number of slots (rounded up to a power of 2), an existing
+        // object of the same capacity is reused and written on after the
+        // samples of the previous producer, returns false on error
+        //
+        bool open(const QString& name, const int capacity = DefaultCapacity);
+
+        //
+        // unmaps the shared object, which persists (readers keep the last
+        // samples) until it is unlinked
+        //
+        void close();
+
+        inline bool isOpen() const { return m_header != nullptr; }
+
+        //
+        // publishes sample, overwriting the oldest one, never blocks, to be
+        // called from the producer thread only
+        //
+        inline void write(const TelemetrySample& sample)
+        {
+            Slot& slot = m_slots[ m_head & m_mask ];
+
+            // odd sequence marks the slot as being written before its sample changes
+            slot.sequence.store( 2 * m_head + 1, std::memory_order_relaxed );
+            std::atomic_thread_fence( std::memory_order_release );
+
+            slot.sample = sample;
+
+            slot.sequence.store( 2 * m_head + 2, std::memory_order_release );
+
+            m_header->head.store( ++m_head, std::memory_order_release );
+        }
+
+        // number of samples written into the shared object (by all its producers)
+        inline quint64 samples() const { return m_head; }
+
+        inline int capacity() const { return static_cast<int>( m_mask + 1 ); }
+
+        inline QString errorString() const { return m_errorString; }
+
+        // removes shared memory object of the given name, returns false on error
+        static bool unlink(const QString& name);
+
+    private:
+
+        Header* m_header{};
+        Slot* m_slots{};
+
+        std::size_t m_size{};           ///< [B] size of the mapping
+
+        quint64 m_mask{};               ///< capacity - 1
+        quint64 m_head{};               ///< index of the next sample
+
+        QString m_errorString;
+    };
+
+    //---------------------------------------------------
+    // Class: TelemetryRing::Reader
+    // Description: Reads samples from the ring mapped read only, any number
+    // of readers (each on its own thread) can follow a single writer
+    //---------------------------------------------------
+    class Reader
+    {
+    public:
+
+        Reader() = default;
+        ~Reader();
+
+        Reader(const Reader&) = delete;
+        Reader& operator=(const Reader&) = delete;
+
+        //
+        // maps shared memory object created by the writer, reading starts
+        // with the latest sample, returns false on error
+        //
+        bool open(const QString& name);
+
+        void close();
+
+        inline bool isOpen() const { return m_header != nullptr; }
+
+        //
+        // copies the latest sample and returns true if any sample has been
+        // written since the previous call, older unread samples are skipped,
+        // meant to be polled at frame time
+        //
+        inline bool read(TelemetrySample* sample)
+        {
+            for ( ;; ) {
+                const quint64 head = m_header->head.load( std::memory_order_acquire );
+
+                if ( head == m_tail ) return false;
+
+                if ( copy( head - 1, sample ) ) {
+                    m_tail = head;
+                    return true;
+                }
+
+                // overwritten while copied, the producer is a whole ring ahead
+            }
+        }
+
+        //
+        // copies the next sample in order and returns true, returns false if
+        // there is no unread sample, samples overwritten before being read
+        // are skipped and counted as lost
+        //
+        inline bool next(TelemetrySample* sample)
+        {
+            for ( ;; ) {
+                const quint64 head = m_header->head.load( std::memory_order_acquire );
+
+                if ( m_tail >= head ) return false;
+
+                if ( head - m_tail > m_mask + 1 ) {
+                    m_lost += head - ( m_mask + 1 ) - m_tail;
+                    m_tail  = head - ( m_mask + 1 );
+                }
+
+                if ( copy( m_tail++, sample ) ) return true;
+
+                m_lost++;
+            }
+        }
+
+        // number of samples skipped by next() as overwritten
+        inline quint64 lost() const { return m_lost; }
+
+        inline int capacity() const { return static_cast<int>( m_mask + 1 ); }
+
+        inline QString errorString() const { return m_errorString; }
+
+    private:
+
+        // copies sample of the given index, returns false if it has been (or is being) overwritten
+        inline bool copy(const quint64 index, TelemetrySample* sample) const
+        {
+            const Slot& slot = m_slots[ index & m_mask ];
+            const quint64 sequence = 2 * index + 2;
+
+            if ( slot.sequence.load( std::memory_order_acquire ) != sequence ) return false;
+
+            const TelemetrySample copied = slot.sample;
+
+            // sample is valid only if the sequence has not changed while copying it
+            std::atomic_thread_fence( std::memory_order_acquire );
+
+            if ( slot.sequence.load( std::memory_order_relaxed ) != sequence ) return false;
+
+            *sample = copied;
+
+            return true;
+        }
+
+        const Header* m_header{};
+        const Slot* m_slots{};
+
+        std::size_t m_size{};           ///< [B] size of the mapping
+
+        quint64 m_mask{};               ///< capacity - 1
+        quint64 m_tail{};               ///< index of the next unread sample
+        quint64 m_lost{};               ///< number of overwritten unread samples
+
+        QString m_errorString;
+    };
+};
+
+}
+
+#endif
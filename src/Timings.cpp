@@ -0,0 +1,156 @@
+/***************************************************************************//**
+ * @file Timings.cpp
+ * @author  Marek M. Cel <marekcel@marekcel.pl>
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * This file is part of QFlightInstruments. You can redistribute and modify it
+ * under the terms of GNU General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.
+ * 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ *
+ * Further information about the GNU General Public License can also be found
+ * on the world wide web at http://www.gnu.org.
+ *
+ * ---
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include "Timings.hpp"
+
+#include <algorithm>
+
+namespace qfi {
+
+const char* Timings::name(const Phase phase)
+{
+    switch ( phase )
+    {
+    case Init:      return "init";
+    case Update:    return "update";
+    case Transform: return "transform";
+    case Paint:     return "paint";
+    default:        return "";
+    }
+}
+
+void Timings::record(const Phase phase, const qint64 duration)
+{
+    Samples& samples = m_samples[ phase ];
+
+    samples.window[ samples.next ] = duration;
+    samples.next = ( samples.next + 1 ) % m_windowSize;
+
+    samples.count++;
+    samples.total += duration;
+    samples.last   = duration;
+}
+
+void Timings::countFrame(const bool refreshed)
+{
+    m_frames++;
+    if ( refreshed ) m_refreshed++;
+}
+
+Timings::Summary Timings::summary(const Phase phase) const
+{
+    const Samples& samples = m_samples[ phase ];
+
+    Summary summary;
+
+    summary.count = samples.count;
+    summary.total = samples.total;
+    summary.last  = samples.last;
+
+    const int size = static_cast<int>( std::min( samples.count, static_cast<quint64>( m_windowSize ) ) );
+
+    if ( size > 0 ) {
+        // percentiles are computed on query so that recording stays cheap
+        qint64 sorted[ m_windowSize ];
+        std::copy( samples.window, samples.window + size, sorted );
+
+        // nearest rank
+        const int i50 = ( 50 * size + 99 ) / 100 - 1;
+        const int i99 = ( 99 * size + 99 ) / 100 - 1;
+
+        std::nth_element( sorted, sorted + i50, sorted + size );
+        summary.p50 = sorted[ i50 ];
+
+        std::nth_element( sorted + i50, sorted + i99, sorted + size );
+        summary.p99 = sorted[ i99 ];
+
+        summary.max = *std::max_element( sorted + i99, sorted + size );
+    }
+
+    return summary;
+}
+
+void Timings::reset()
+{
+    for ( Samples& samples : m_samples ) {
+        samples.next  = 0;
+        samples.count = 0;
+        samples.total = 0;
+        samples.last  = 0;
+    }
+
+    m_frames    = 0;
+    m_refreshed = 0;
+}
+
+QJsonObject Timings::toJson() const
+{
+    QJsonObject json;
+
+    json.insert( "frames"    , static_cast<double>( m_frames    ) );
+    json.insert( "refreshed" , static_cast<double>( m_refreshed ) );
+
+    for ( int i = 0; i < PhaseCount; ++i ) {
+        const Summary s = summary( static_cast<Phase>( i ) );
+
+        QJsonObject phase;
+
+        phase.insert( "count" , static_cast<double>( s.count ) );
+        phase.insert( "total" , static_cast<double>( s.total ) );
+        phase.insert( "last"  , static_cast<double>( s.last  ) );
+        phase.insert( "p50"   , static_cast<double>( s.p50   ) );
+        phase.insert( "p99"   , static_cast<double>( s.p99   ) );
+        phase.insert( "max"   , static_cast<double>( s.max   ) );
+
+        json.insert( name( static_cast<Phase>( i ) ), phase );
+    }
+
+    return json;
+}
+
+}
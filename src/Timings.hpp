@@ -0,0 +1,167 @@
+/***************************************************************************//**
+ * @file Timings.h
+ * @author  Marek M. Cel <marekcel@marekcel.pl>
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * This file is part of QFlightInstruments. You can redistribute and modify it
+ * under the terms of GNU General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.
+ * 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ *
+ * Further information about the GNU General Public License can also be found
+ * on the world wide web at http://www.gnu.org.
+ *
+ * ---
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef __qfi_Timings_H__
+#define __qfi_Timings_H__
+
+#include <QElapsedTimer>
+#include <QJsonObject>
+
+namespace qfi {
+
+//---------------------------------------------------
+// Class: Timings
+// Description: Rolling statistics of the instrument render phases
+// durations, not thread-safe, it is meant to be used by the thread
+// owning the instrument
+//---------------------------------------------------
+class Timings
+{
+public:
+
+    // render phases
+    enum Phase
+    {
+        Init = 0,                       ///< creating or rescaling scene items
+        Update,                         ///< applying new state
+        Transform,                      ///< placing items according to state
+        Paint,                          ///< painting scene
+        PhaseCount
+    };
+
+    // durations statistics of a phase, durations are given in [ns]
+    struct Summary
+    {
+        quint64 count{};                ///< number of samples since reset
+        qint64 total{};                 ///< sum of the durations since reset
+        qint64 last{};                  ///< the most recent duration
+        qint64 p50{};                   ///< median of the rolling window
+        qint64 p99{};                   ///< 99th percentile of the rolling window
+        qint64 max{};                   ///< maximum of the rolling window
+    };
+
+    //---------------------------------------------------
+    // Class: Scope
+    // Description: Records duration of its own lifetime, a scope nested
+    // in another scope of the same phase records nothing so that e.g.
+    // setters called by setState() are not counted twice
+    //---------------------------------------------------
+    class Scope
+    {
+    public:
+
+        inline Scope(Timings* timings, const Phase phase)
+            : m_timings(timings), m_phase(phase)
+        {
+            if ( m_timings->m_depth[m_phase]++ == 0 ) m_timer.start();
+        }
+
+        inline ~Scope()
+        {
+            if ( --m_timings->m_depth[m_phase] == 0 )
+                m_timings->record( m_phase, m_timer.nsecsElapsed() );
+        }
+
+    private:
+
+        Timings* m_timings{};
+        Phase m_phase{};
+        QElapsedTimer m_timer;
+    };
+
+    // number of the most recent samples percentiles are computed of
+    static const int m_windowSize{1024};
+
+    // returns phase name as used in JSON
+    static const char* name(const Phase phase);
+
+    // records phase duration [ns]
+    void record(const Phase phase, const qint64 duration);
+
+    // counts update() call, refreshed if anything was redrawn
+    void countFrame(const bool refreshed);
+
+    // returns durations statistics of the given phase
+    Summary summary(const Phase phase) const;
+
+    // number of update() calls since reset
+    inline quint64 frames() const { return m_frames; }
+
+    // number of update() calls which redrawn anything since reset
+    inline quint64 refreshed() const { return m_refreshed; }
+
+    // resets all the statistics
+    void reset();
+
+    //
+    // returns all the statistics as JSON object, e.g.
+    // {"frames":120,"refreshed":118,"paint":{"count":118,"p50":81200,...},...}
+    //
+    QJsonObject toJson() const;
+
+private:
+
+    struct Samples
+    {
+        qint64 window[m_windowSize];    ///< [ns] ring buffer of the recent durations
+        int next{};                     ///< next ring buffer index
+        quint64 count{};
+        qint64 total{};                 ///< [ns]
+        qint64 last{};                  ///< [ns]
+    };
+
+    Samples m_samples[PhaseCount];
+
+    int m_depth[PhaseCount]{};          ///< number of the open scopes of a phase
+
+    quint64 m_frames{};
+    quint64 m_refreshed{};
+};
+
+}
+
+#endif
@@ -0,0 +1,120 @@
+/***************************************************************************//**
+ * @file TripleBuffer.h
+ * @author  Marek M. Cel <marekcel@marekcel.pl>
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * This file is part of QFlightInstruments. You can redistribute and modify it
+ * under the terms of GNU General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.
+ * 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ *
+ * Further information about the GNU General Public License can also be found
+ * on the world wide web at http://www.gnu.org.
+ *
+ * ---
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef __qfi_TripleBuffer_H__
+#define __qfi_TripleBuffer_H__
+
+#include <atomic>
+
+namespace qfi {
+
+//---------------------------------------------------
+// Class: TripleBuffer
+// Description: Lock-free single producer single consumer handoff of
+// the latest value, the producer never waits for the consumer and
+// the consumer always gets a complete (not torn) value
+//---------------------------------------------------
+template <typename T>
+class TripleBuffer
+{
+public:
+
+    TripleBuffer() = default;
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    //
+    // stores value as the latest one, overwriting a value not fetched yet,
+    // to be called from the producer thread only
+    //
+    void publish(const T& value)
+    {
+        m_slots[ m_back ] = value;
+
+        // written slot becomes the middle one and the former middle one
+        // is reused for the next value
+        const int middle = m_middle.exchange( m_back | Fresh, std::memory_order_acq_rel );
+        m_back = middle & Index;
+    }
+
+    //
+    // copies the latest value and returns true if any value has been
+    // published since the previous call, to be called from the consumer
+    // thread only
+    //
+    bool fetch(T* value)
+    {
+        if ( !( m_middle.load( std::memory_order_acquire ) & Fresh ) ) return false;
+
+        const int middle = m_middle.exchange( m_front, std::memory_order_acq_rel );
+        m_front = middle & Index;
+
+        *value = m_slots[ m_front ];
+
+        return true;
+    }
+
+private:
+
+    enum
+    {
+        Index = 0x3,                    ///< slot index mask
+        Fresh = 0x4                     ///< middle slot holds unfetched value
+    };
+
+    T m_slots[ 3 ];
+
+    std::atomic<int> m_middle{1};       ///< shared slot index and Fresh flag
+
+    int m_back{0};                      ///< slot written by the producer
+    int m_front{2};                     ///< slot read by the consumer
+};
+
+}
+
+#endif
@@ -48,88 +48,154 @@
 
 #include "Vsi.hpp"
 
-#include <QGraphicsSvgItem>
+#include "SvgItem.hpp"
 
 namespace qfi {
 
 Vsi::Vsi(QWidget* parent) : QGraphicsView(parent)
 {
-    m_scene = new QGraphicsScene(this);
-    setScene(m_scene);
-    m_scene->clear();
-    init();
+    m_renderer = new Renderer();
+    setScene( m_renderer->scene() );
+    Profile::apply( this, m_renderer->profile() );
+    m_renderer->resize( width(), height() );
+    centerOn( width() / 2.0f , height() / 2.0f );
 }
 
 Vsi::~Vsi()
 {
-    if (m_scene) {
-        m_scene->clear();
-        delete m_scene;
-        m_scene = nullptr;
+    if ( m_renderer ) {
+        delete m_renderer;
+        m_renderer = nullptr;
     }
-
-    reset();
 }
 
 void Vsi::reinit()
 {
-    if (m_scene) {
-        m_scene->clear();
-        init();
-    }
+    m_renderer->reinit();
+    centerOn( width() / 2.0f , height() / 2.0f );
 }
 
 void Vsi::update()
 {
-    updateView();
+    m_renderer->update();
 }
 
-void Vsi::setClimbRate(const float climbRate)
+void Vsi::setRasterCache(const bool rasterCache)
 {
-    m_climbRate = climbRate;
+    m_renderer->setRasterCache( rasterCache );
+}
 
-    if ( m_climbRate < -2000.0f ) m_climbRate = -2000.0f;
-    if ( m_climbRate >  2000.0f ) m_climbRate =  2000.0f;
+void Vsi::setProfile(const Profile::Type profile)
+{
+    m_renderer->setProfile( profile );
+    Profile::apply( this, profile );
 }
 
 void Vsi::resizeEvent(QResizeEvent* event)
 {
     QGraphicsView::resizeEvent( event );
+    m_renderer->resize( width(), height() );
+    centerOn( width() / 2.0f , height() / 2.0f );
+}
+
+void Vsi::paintEvent(QPaintEvent* event)
+{
+    Timings::Scope scope( &m_renderer->timings(), Timings::Paint );
+    QGraphicsView::paintEvent( event );
+}
+
+Vsi::Renderer::Renderer()
+{
+    m_width  = m_originalWidth;
+    m_height = m_originalHeight;
+
     reinit();
 }
 
-void Vsi::init()
+Vsi::Renderer::~Renderer()
+{
+    if ( m_scene ) m_scene->clear();
+
+    reset();
+}
+
+void Vsi::Renderer::setClimbRate(const float climbRate)
+{
+    Timings::Scope scope( &m_timings, Timings::Update );
+
+    const float climbRate_prev = m_climbRate;
+
+    m_climbRate = climbRate;
+
+    if ( m_climbRate < -2000.0f ) m_climbRate = -2000.0f;
+    if ( m_climbRate >  2000.0f ) m_climbRate =  2000.0f;
+
+    if ( m_climbRate != climbRate_prev ) invalidate();
+}
+
+void Vsi::Renderer::setState(const VsiState& state)
+{
+    Timings::Scope scope( &m_timings, Timings::Update );
+
+    setClimbRate( state.climbRate );
+}
+
+void Vsi::Renderer::publish(const VsiState& state)
+{
+    m_published.publish( state );
+}
+
+void Vsi::Renderer::init()
 {
-    m_scaleX = static_cast<float>(width())  / static_cast<float>(m_originalWidth);
-    m_scaleY = static_cast<float>(height()) / static_cast<float>(m_originalHeight);
+    m_scaleX = static_cast<float>(m_width)  / static_cast<float>(m_originalWidth);
+    m_scaleY = static_cast<float>(m_height) / static_cast<float>(m_originalHeight);
 
     reset();
 
-    m_itemFace = new QGraphicsSvgItem( ":/qfi/images/vsi/vsi_face.svg" );
+    m_itemFace = new SvgItem( ":/qfi/images/vsi/vsi_face.svg" );
     m_itemFace->setCacheMode( QGraphicsItem::NoCache );
     m_itemFace->setZValue( m_faceZ );
     m_itemFace->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
     m_scene->addItem( m_itemFace );
 
-    m_itemHand = new QGraphicsSvgItem( ":/qfi/images/vsi/vsi_hand.svg" );
+    m_itemHand = new SvgItem( ":/qfi/images/vsi/vsi_hand.svg" );
     m_itemHand->setCacheMode( QGraphicsItem::NoCache );
     m_itemHand->setZValue( m_handZ );
     m_itemHand->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
     m_itemHand->setTransformOriginPoint( m_originalVsiCtr );
     m_scene->addItem( m_itemHand );
 
-    m_itemCase = new QGraphicsSvgItem( ":/qfi/images/vsi/vsi_case.svg" );
+    m_itemCase = new SvgItem( ":/qfi/images/vsi/vsi_case.svg" );
     m_itemCase->setCacheMode( QGraphicsItem::NoCache );
     m_itemCase->setZValue( m_caseZ );
     m_itemCase->setTransform( QTransform::fromScale( m_scaleX, m_scaleY ), true );
     m_scene->addItem( m_itemCase );
 
-    centerOn( width() / 2.0f , height() / 2.0f );
+    m_compositor.setPolicy( m_itemFace, Compositor::Static );
+    m_compositor.setPolicy( m_itemCase, Compositor::Static );
 
-    updateView();
+    SvgItem::setRasterCache( m_scene, m_rasterCache );
+
+    invalidate();
+    refresh();
 }
 
-void Vsi::reset()
+void Vsi::Renderer::rescale()
+{
+    m_scaleX = static_cast<float>(m_width)  / static_cast<float>(m_originalWidth);
+    m_scaleY = static_cast<float>(m_height) / static_cast<float>(m_originalHeight);
+
+    const QTransform scale = QTransform::fromScale( m_scaleX, m_scaleY );
+
+    m_itemFace->setTransform( scale );
+    m_itemHand->setTransform( scale );
+    m_itemCase->setTransform( scale );
+
+    invalidate();
+    refresh();
+}
+
+void Vsi::Renderer::reset()
 {
     m_itemFace = nullptr;
     m_itemHand = nullptr;
@@ -138,10 +204,16 @@ void Vsi::reset()
     m_climbRate = 0.0f;
 }
 
-void Vsi::updateView()
+void Vsi::Renderer::fetchPublished()
+{
+    VsiState state;
+
+    if ( m_published.fetch( &state ) ) setState( state );
+}
+
+void Vsi::Renderer::updateView()
 {
     m_itemHand->setRotation(m_climbRate * 0.086f);
-    m_scene->update();
 }
 
 }
@@ -50,6 +50,9 @@
 
 #include <QGraphicsView>
 
+#include "Instrument.hpp"
+#include "TripleBuffer.hpp"
+
 class QWidget;
 class QResizeEvent;
 class QGraphicsScene;
@@ -57,6 +60,15 @@ class QGraphicsSvgItem;
 
 namespace qfi {
 
+//---------------------------------------------------
+// Struct: VsiState
+// Description: Vertical Speed Indicator state snapshot
+//---------------------------------------------------
+struct VsiState
+{
+    float climbRate{};                  ///< [ft/min]
+};
+
 //---------------------------------------------------
 // Class: Vsi
 // Description: Vertical Speed Indicator widget
@@ -66,6 +78,59 @@ class Vsi : public QGraphicsView
     Q_OBJECT
 
 public:
+
+    //---------------------------------------------------
+    // Class: Vsi::Renderer
+    // Description: Vertical Speed Indicator headless renderer
+    //---------------------------------------------------
+    class Renderer : public Instrument
+    {
+    public:
+        Renderer();
+        virtual ~Renderer();
+
+        // climb rate [ft/min]
+        void setClimbRate(const float);
+
+        // sets all the values at once
+        void setState(const VsiState& state);
+
+        //
+        // publishes state to be applied by the next update(), can be called
+        // from any single producer thread, never blocks nor allocates
+        //
+        void publish(const VsiState& state);
+
+    protected:
+        void init();
+        void rescale();
+        void updateView();
+        void fetchPublished();
+
+    private:
+        void reset();
+
+        QGraphicsSvgItem* m_itemFace{};
+        QGraphicsSvgItem* m_itemHand{};
+        QGraphicsSvgItem* m_itemCase{};
+
+        float m_climbRate{};
+
+        TripleBuffer<VsiState> m_published;
+
+        float m_scaleX{1.0f};
+        float m_scaleY{1.0f};
+
+        const int m_originalHeight{240};
+        const int m_originalWidth{240};
+
+        QPointF m_originalVsiCtr{120.0f, 120.0f};
+
+        const int m_faceZ{-20};
+        const int m_handZ{-10};
+        const int m_caseZ{10};
+    };
+
     Vsi(QWidget* parent = nullptr);
     virtual ~Vsi();
 
@@ -75,36 +140,42 @@ public:
     // refreshes (redraws) widget
     void update();
 
-    // climb rate [ft/min]
-    void setClimbRate(const float);
+    // enables/disables cached raster mode of the SVG layers
+    void setRasterCache(const bool);
 
-protected:
-    void resizeEvent(QResizeEvent*);
+    // sets performance profile of the widget and its renderer
+    void setProfile(const Profile::Type profile);
 
-private:
-    void init();
-    void reset();
-    void updateView();
-
-    QGraphicsScene* m_scene{};
+    // headless renderer of the widget, e.g. to be registered in RenderScheduler
+    inline Renderer* renderer() const { return m_renderer; }
 
-    QGraphicsSvgItem* m_itemFace{};
-    QGraphicsSvgItem* m_itemHand{};
-    QGraphicsSvgItem* m_itemCase{};
+    // sets all the values at once
+    inline void setState(const VsiState& state)
+    {
+        m_renderer->setState( state );
+    }
 
-    float m_climbRate{};
+    //
+    // publishes state to be applied by the next update(), can be called
+    // from any single producer thread, never blocks nor allocates
+    //
+    inline void publish(const VsiState& state)
+    {
+        m_renderer->publish( state );
+    }
 
-    float m_scaleX{1.0f};
-    float m_scaleY{1.0f};
-
-    const int m_originalHeight{240};
-    const int m_originalWidth{240};
+    // climb rate [ft/min]
+    inline void setClimbRate(const float climbRate)
+    {
+        m_renderer->setClimbRate( climbRate );
+    }
 
-    QPointF m_originalVsiCtr{120.0f, 120.0f};
+protected:
+    void paintEvent(QPaintEvent*);
+    void resizeEvent(QResizeEvent*);
 
-    const int m_faceZ{-20};
-    const int m_handZ{-10};
-    const int m_caseZ{10};
+private:
+    Renderer* m_renderer{};
 };
 
 }
@@ -0,0 +1,153 @@
+/***************************************************************************//**
+ * @file bench/Benchmark.cpp
+ * @author  Marek M. Cel <marekcel@marekcel.pl>
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * This file is part of QFlightInstruments. You can redistribute and modify it
+ * under the terms of GNU General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.
+ * 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ *
+ * Further information about the GNU General Public License can also be found
+ * on the world wide web at http://www.gnu.org.
+ *
+ * ---
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include "Benchmark.hpp"
+
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonObject>
+
+#include <algorithm>
+#include <cstdio>
+
+Benchmark::Benchmark(const int minTime, const QString& filter)
+    : m_filter(filter)
+    , m_minTime(1000000LL * minTime)
+{}
+
+void Benchmark::run(const QString& name, const Iteration& iteration)
+{
+    if ( !m_filter.isEmpty() && !name.contains( m_filter ) ) return;
+
+    // warm-up, e.g. first parse of the SVG files
+    iteration();
+
+    std::vector<qint64> samples;
+
+    qint64 total = 0;
+
+    while ( static_cast<int>( samples.size() ) < m_maxIterations
+            && ( total < m_minTime || static_cast<int>( samples.size() ) < m_minIterations ) )
+    {
+        const qint64 duration = iteration();
+
+        samples.push_back( duration );
+        total += duration;
+    }
+
+    std::sort( samples.begin(), samples.end() );
+
+    const int size = static_cast<int>( samples.size() );
+
+    Result result;
+
+    result.name       = name;
+    result.iterations = size;
+    result.min        = samples.front();
+    result.median     = samples[ size / 2 ];
+    result.p99        = samples[ ( 99 * size + 99 ) / 100 - 1 ];
+
+    m_results.push_back( result );
+
+    std::printf( "%-32s %8d %12.1f %12.1f %12.1f\n", qPrintable( name ), size,
+                 result.min / 1.0e3, result.median / 1.0e3, result.p99 / 1.0e3 );
+    std::fflush( stdout );
+}
+
+QJsonDocument Benchmark::toJson() const
+{
+    QJsonArray cases;
+
+    for ( const Result& result : m_results ) {
+        QJsonObject object;
+
+        object.insert( "name"       , result.name );
+        object.insert( "iterations" , result.iterations );
+        object.insert( "min"        , static_cast<double>( result.min    ) );
+        object.insert( "median"     , static_cast<double>( result.median ) );
+        object.insert( "p99"        , static_cast<double>( result.p99    ) );
+
+        cases.append( object );
+    }
+
+    QJsonObject root;
+
+    root.insert( "unit"  , QString( "ns" ) );
+    root.insert( "cases" , cases );
+
+    return QJsonDocument( root );
+}
+
+int Benchmark::compare(const QJsonDocument& baseline, const double tolerance) const
+{
+    QHash<QString, double> medians;
+
+    for ( const QJsonValue& value : baseline.object().value( "cases" ).toArray() ) {
+        const QJsonObject object = value.toObject();
+        medians.insert( object.value( "name" ).toString(), object.value( "median" ).toDouble() );
+    }
+
+    int regressions = 0;
+
+    std::printf( "\n%-32s %12s %12s %8s\n", "case", "base [us]", "now [us]", "change" );
+
+    for ( const Result& result : m_results ) {
+        if ( !medians.contains( result.name ) ) continue;
+
+        const double base   = medians.value( result.name );
+        const double change = base > 0.0 ? 100.0 * ( result.median - base ) / base : 0.0;
+        const bool regressed = change > tolerance;
+
+        if ( regressed ) regressions++;
+
+        std::printf( "%-32s %12.1f %12.1f %+7.1f%%%s\n", qPrintable( result.name ),
+                     base / 1.0e3, result.median / 1.0e3, change, regressed ? " REGRESSION" : "" );
+    }
+
+    return regressions;
+}
@@ -0,0 +1,114 @@
+/***************************************************************************//**
+ * @file bench/Benchmark.h
+ * @author  Marek M. Cel <marekcel@marekcel.pl>
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * This file is part of QFlightInstruments. You can redistribute and modify it
+ * under the terms of GNU General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.
+ * 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ *
+ * Further information about the GNU General Public License can also be found
+ * on the world wide web at http://www.gnu.org.
+ *
+ * ---
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef __BENCHMARK_H__
+#define __BENCHMARK_H__
+
+#include <QJsonDocument>
+#include <QString>
+
+#include <functional>
+#include <vector>
+
+//---------------------------------------------------
+// Class: Benchmark
+// Description: Runs benchmark cases repeatedly, collects per iteration
+// durations and compares results with a baseline
+//---------------------------------------------------
+class Benchmark
+{
+public:
+
+    // durations statistics of a case [ns]
+    struct Result
+    {
+        QString name;
+
+        int iterations{};
+
+        qint64 min{};
+        qint64 median{};
+        qint64 p99{};
+    };
+
+    // runs single iteration and returns its measured duration [ns]
+    typedef std::function<qint64()> Iteration;
+
+    //
+    // minTime [ms] minimum time spent on each case
+    // filter only cases which names contain it are run
+    //
+    Benchmark(const int minTime, const QString& filter);
+
+    // runs case unless it is filtered out
+    void run(const QString& name, const Iteration& iteration);
+
+    inline const std::vector<Result>& results() const { return m_results; }
+
+    // returns results as JSON document
+    QJsonDocument toJson() const;
+
+    //
+    // compares median durations with the baseline and prints report,
+    // returns number of cases slower than the baseline by more than
+    // the given tolerance [%]
+    //
+    int compare(const QJsonDocument& baseline, const double tolerance) const;
+
+private:
+
+    std::vector<Result> m_results;
+
+    QString m_filter;
+
+    qint64 m_minTime{};                 ///< [ns]
+
+    const int m_minIterations{5};
+    const int m_maxIterations{100000};
+};
+
+#endif
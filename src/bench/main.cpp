@@ -0,0 +1,621 @@
+/***************************************************************************//**
+ * @file bench/main.cpp
+ * @author  Marek M. Cel <marekcel@marekcel.pl>
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * This file is part of QFlightInstruments. You can redistribute and modify it
+ * under the terms of GNU General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.
+ * 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ *
+ * Further information about the GNU General Public License can also be found
+ * on the world wide web at http://www.gnu.org.
+ *
+ * ---
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QImage>
+#include <QTemporaryFile>
+#include <QVector>
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+#include <Adi.hpp>
+#include <Alt.hpp>
+#include <Asi.hpp>
+#include <Hsi.hpp>
+#include <Mavlink.hpp>
+#include <Nav.hpp>
+#include <Pfd.hpp>
+#include <Profile.hpp>
+#include <SvgRegistry.hpp>
+#include <Tc.hpp>
+#include <TelemetryArchive.hpp>
+#include <TelemetryCsvReader.hpp>
+#include <TelemetryRecorder.hpp>
+#include <TelemetryReplay.hpp>
+#include <TelemetryRing.hpp>
+#include <Vsi.hpp>
+
+#include "Benchmark.hpp"
+
+namespace {
+
+// fixed seed so that every run goes through the same states
+std::mt19937 randomEngine( 1 );
+
+float random(const float min, const float max)
+{
+    return std::uniform_real_distribution<float>( min, max )( randomEngine );
+}
+
+void randomize(qfi::AdiState* state)
+{
+    state->roll  = random( -180.0f, 180.0f );
+    state->pitch = random(  -90.0f,  90.0f );
+}
+
+void randomize(qfi::AltState* state)
+{
+    state->altitude = random(  0.0f, 18000.0f );
+    state->pressure = random( 28.0f,    31.0f );
+}
+
+void randomize(qfi::AsiState* state)
+{
+    state->airspeed = random( 0.0f, 250.0f );
+}
+
+void randomize(qfi::HsiState* state)
+{
+    state->heading = random( 0.0f, 360.0f );
+}
+
+void randomize(qfi::NavState* state)
+{
+    state->heading    = random(  0.0f, 360.0f );
+    state->headingBug = random(  0.0f, 360.0f );
+    state->course     = random(  0.0f, 360.0f );
+    state->bearing    = random(  0.0f, 360.0f );
+    state->deviation  = random( -1.0f,   1.0f );
+    state->distance   = random(  0.0f,  99.0f );
+}
+
+void randomize(qfi::PfdState* state)
+{
+    state->roll          = random( -180.0f,   180.0f );
+    state->pitch         = random(  -90.0f,    90.0f );
+    state->angleOfAttack = random(  -20.0f,    20.0f );
+    state->sideslipAngle = random(  -15.0f,    15.0f );
+    state->slipSkid      = random(   -1.0f,     1.0f );
+    state->turnRate      = random(   -1.0f,     1.0f );
+    state->barH          = random(   -1.0f,     1.0f );
+    state->barV          = random(   -1.0f,     1.0f );
+    state->dotH          = random(   -1.0f,     1.0f );
+    state->dotV          = random(   -1.0f,     1.0f );
+    state->altitude      = random(    0.0f, 18000.0f );
+    state->pressure      = random(   28.0f,    31.0f );
+    state->airspeed      = random(    0.0f,   250.0f );
+    state->machNo        = random(    0.0f,     0.4f );
+    state->heading       = random(    0.0f,   360.0f );
+    state->climbRate     = random(   -6.5f,     6.5f );
+}
+
+void randomize(qfi::TcState* state)
+{
+    state->turnRate = random(  -7.0f,  7.0f );
+    state->slipSkid = random( -15.0f, 15.0f );
+}
+
+void randomize(qfi::VsiState* state)
+{
+    state->climbRate = random( -650.0f, 650.0f );
+}
+
+//
+// runs construction, reinit() at each of the given sizes, update() with
+// randomized state and paint cases of the given instrument renderer
+//
+template <class TRenderer, class TState>
+void benchmark(Benchmark* bench, const QString& name,
+               const std::vector<int>& sizes, const int paintSize,
+               const qfi::Profile::Type profile)
+{
+    bench->run( name + "/construct", []()
+    {
+        QElapsedTimer timer;
+        timer.start();
+        TRenderer* renderer = new TRenderer();
+        const qint64 duration = timer.nsecsElapsed();
+        delete renderer;
+        return duration;
+    } );
+
+    TRenderer renderer;
+    renderer.setProfile( profile );
+
+    for ( const int size : sizes ) {
+        renderer.resize( size, size );
+
+        bench->run( QString( "%1/reinit/%2" ).arg( name ).arg( size ), [ &renderer ]()
+        {
+            QElapsedTimer timer;
+            timer.start();
+            renderer.reinit();
+            return timer.nsecsElapsed();
+        } );
+    }
+
+    renderer.resize( paintSize, paintSize );
+
+    bench->run( name + "/update", [ &renderer ]()
+    {
+        TState state;
+        randomize( &state );
+
+        QElapsedTimer timer;
+        timer.start();
+        renderer.setState( state );
+        renderer.update();
+        return timer.nsecsElapsed();
+    } );
+
+    QImage image( paintSize, paintSize, QImage::Format_ARGB32_Premultiplied );
+
+    bench->run( QString( "%1/paint/%2" ).arg( name ).arg( paintSize ), [ &renderer, &image ]()
+    {
+        TState state;
+        randomize( &state );
+
+        renderer.setState( state );
+        renderer.update();
+
+        QElapsedTimer timer;
+        timer.start();
+        renderer.render( &image );
+        return timer.nsecsElapsed();
+    } );
+}
+
+//
+// runs replay of a recording feeding the PFD renderer at 60 frames
+// per second and random seeks, the recording is sampled at 100 Hz
+//
+void benchmarkReplay(Benchmark* bench, const qfi::Profile::Type profile)
+{
+    QTemporaryFile file;
+
+    if ( !file.open() ) return;
+
+    qfi::TelemetryRecorder recorder;
+
+    if ( !recorder.open( file.fileName() ) ) return;
+
+    qfi::TelemetrySample sample;
+
+    for ( int i = 0; i < 100000; ++i ) {
+        sample.time      = i * Q_INT64_C(10000000);
+        sample.roll      = random( -180.0f,   180.0f );
+        sample.pitch     = random(  -90.0f,    90.0f );
+        sample.heading   = random(    0.0f,   360.0f );
+        sample.airspeed  = random(    0.0f,   250.0f );
+        sample.altitude  = random(    0.0f, 18000.0f );
+        sample.climbRate = random( -650.0f,   650.0f );
+
+        recorder.write( sample );
+    }
+
+    recorder.close();
+
+    qfi::TelemetryReplay replay;
+
+    if ( !replay.open( file.fileName() ) ) return;
+
+    qfi::Pfd::Renderer renderer;
+    renderer.setProfile( profile );
+    renderer.resize( 480, 480 );
+
+    bench->run( "replay/advance", [ &replay ]()
+    {
+        if ( replay.atEnd() ) replay.rewind();
+
+        QElapsedTimer timer;
+        timer.start();
+        replay.advance( 1.0 / 60.0 );
+        return timer.nsecsElapsed();
+    } );
+
+    const qint64 duration = replay.duration();
+
+    bench->run( "replay/seek", [ &replay, duration ]()
+    {
+        const qint64 time = static_cast<qint64>( random( 0.0f, 1.0f ) * duration );
+
+        QElapsedTimer timer;
+        timer.start();
+        replay.seek( time );
+        return timer.nsecsElapsed();
+    } );
+
+    replay.rewind();
+
+    bench->run( "replay/pfd/update", [ &replay, &renderer ]()
+    {
+        if ( replay.atEnd() ) replay.rewind();
+
+        QElapsedTimer timer;
+        timer.start();
+        renderer.setState( replay.advance( 1.0 / 60.0 ).pfd() );
+        renderer.update();
+        return timer.nsecsElapsed();
+    } );
+}
+
+//
+// runs decoding and replay of a compressed recording of a smooth flight
+// sampled at 100 Hz, the compressed recording keeps roughly the same
+// replay and seek costs as the plain one
+//
+void benchmarkArchive(Benchmark* bench)
+{
+    QTemporaryFile file;
+
+    if ( !file.open() ) return;
+
+    qfi::TelemetryRecorder recorder;
+    recorder.setCompressed( true );
+
+    if ( !recorder.open( file.fileName() ) ) return;
+
+    qfi::TelemetrySample sample;
+
+    for ( int i = 0; i < 100000; ++i ) {
+        const float t = 0.01f * i;
+
+        // states of a real flight change slowly between the samples
+        sample.time      = i * Q_INT64_C(10000000);
+        sample.roll      = std::round( 300.0f * std::sin( 0.1f * t ) ) / 10.0f;
+        sample.pitch     = std::round( 100.0f * std::sin( 0.3f * t ) ) / 10.0f;
+        sample.heading   = std::round( std::fmod( 10.0f * t, 360.0f ) );
+        sample.airspeed  = std::round( 1200.0f + 200.0f * std::sin( 0.05f * t ) ) / 10.0f;
+        sample.altitude  = std::round( 5000.0f + 1000.0f * std::sin( 0.02f * t ) );
+        sample.climbRate = std::round( 20.0f * std::cos( 0.02f * t ) ) * 10.0f;
+
+        recorder.write( sample );
+    }
+
+    recorder.close();
+
+    qfi::TelemetryReplay replay;
+
+    if ( !replay.open( file.fileName() ) ) return;
+
+    qfi::TelemetryArchive::Reader reader = replay.archive();
+
+    QVector<qfi::TelemetrySample> samples( 1000 );
+
+    bench->run( "archive/decode/1000", [ &reader, &samples ]()
+    {
+        if ( reader.position() + samples.size() > reader.count() ) reader.seek( 0 );
+
+        QElapsedTimer timer;
+        timer.start();
+        reader.read( samples.data(), samples.size() );
+        return timer.nsecsElapsed();
+    } );
+
+    bench->run( "archive/replay/advance", [ &replay ]()
+    {
+        if ( replay.atEnd() ) replay.rewind();
+
+        QElapsedTimer timer;
+        timer.start();
+        replay.advance( 1.0 / 60.0 );
+        return timer.nsecsElapsed();
+    } );
+
+    const qint64 duration = replay.duration();
+
+    bench->run( "archive/replay/seek", [ &replay, duration ]()
+    {
+        const qint64 time = static_cast<qint64>( random( 0.0f, 1.0f ) * duration );
+
+        QElapsedTimer timer;
+        timer.start();
+        replay.seek( time );
+        return timer.nsecsElapsed();
+    } );
+}
+
+//
+// parses comma separated log of a flight sampled at 100 Hz, every
+// iteration parses 1000 lines (about 50 kB)
+//
+void benchmarkCsv(Benchmark* bench)
+{
+    QTemporaryFile file;
+
+    if ( !file.open() ) return;
+
+    file.write( "time,roll,pitch,heading,airspeed,altitude,climb_rate,turn_rate\n" );
+
+    char line[ 256 ];
+
+    for ( int i = 0; i < 100000; ++i ) {
+        const int size = std::snprintf( line, sizeof(line), "%.2f,%.2f,%.2f,%.1f,%.1f,%.0f,%.0f,%.3f\n",
+                                        0.01 * i,
+                                        random( -180.0f,   180.0f ),
+                                        random(  -90.0f,    90.0f ),
+                                        random(    0.0f,   360.0f ),
+                                        random(    0.0f,   250.0f ),
+                                        random(    0.0f, 18000.0f ),
+                                        random( -650.0f,   650.0f ),
+                                        random(   -6.0f,     6.0f ) );
+
+        file.write( line, size );
+    }
+
+    file.flush();
+
+    qfi::TelemetryCsvReader reader;
+
+    if ( !reader.open( file.fileName() ) ) return;
+
+    QVector<qfi::TelemetrySample> samples( 1000 );
+
+    bench->run( "csv/parse/1000", [ &reader, &samples, &file ]()
+    {
+        if ( reader.lines() > 99000 ) reader.open( file.fileName() );
+
+        QElapsedTimer timer;
+        timer.start();
+        reader.read( samples.data(), samples.size() );
+        return timer.nsecsElapsed();
+    } );
+}
+
+// appends MAVLink 2 frame of the given message
+void appendFrame(QByteArray* stream, const quint32 message, const QByteArray& payload, const int sequence)
+{
+    QByteArray frame;
+    frame.append( static_cast<char>( 0xFD ) );
+    frame.append( static_cast<char>( payload.size() ) );
+    frame.append( '\0' );
+    frame.append( '\0' );
+    frame.append( static_cast<char>( sequence ) );
+    frame.append( '\1' );
+    frame.append( '\1' );
+    frame.append( static_cast<char>( message ) );
+    frame.append( '\0' );
+    frame.append( '\0' );
+    frame.append( payload );
+
+    const uchar seed = static_cast<uchar>( qfi::Mavlink::crcExtra( message ) );
+    const uchar* data = reinterpret_cast<const uchar*>( frame.constData() );
+    const quint16 crc = qfi::Mavlink::crc( &seed, 1, qfi::Mavlink::crc( data + 1, frame.size() - 1 ) );
+
+    frame.append( static_cast<char>( crc & 0xFF ) );
+    frame.append( static_cast<char>( crc >> 8 ) );
+
+    stream->append( frame );
+}
+
+//
+// parses MAVLink stream of ATTITUDE, VFR_HUD and GLOBAL_POSITION_INT
+// messages, every iteration parses 1000 frames
+//
+void benchmarkMavlink(Benchmark* bench)
+{
+    QByteArray stream;
+
+    for ( int i = 0; i < 1000; ++i ) {
+        QByteArray payload( 28, '\0' );
+
+        const float values[] = { random( -3.0f, 3.0f ), random( -1.5f, 1.5f ), random( -3.0f, 3.0f ) };
+        std::memcpy( payload.data() + 4, values, sizeof(values) );
+
+        switch ( i % 3 )
+        {
+        case 0: appendFrame( &stream, qfi::Mavlink::Attitude, payload, i ); break;
+        case 1: appendFrame( &stream, qfi::Mavlink::VfrHud, payload.left( 20 ), i ); break;
+        case 2: appendFrame( &stream, qfi::Mavlink::GlobalPositionInt, payload, i ); break;
+        }
+    }
+
+    qfi::Mavlink::Parser parser;
+    qfi::TelemetrySample sample;
+
+    bench->run( "mavlink/parse/1000", [ &parser, &sample, &stream ]()
+    {
+        QElapsedTimer timer;
+        timer.start();
+        parser.parse( reinterpret_cast<const uchar*>( stream.constData() ), stream.size(),
+                      [ &sample ]( const qfi::Mavlink::Frame& frame ) { qfi::Mavlink::apply( frame, &sample ); } );
+        return timer.nsecsElapsed();
+    } );
+}
+
+//
+// hands samples over through the shared memory ring within the process,
+// every iteration writes and reads 1000 samples
+//
+void benchmarkRing(Benchmark* bench)
+{
+    const QString name = QString( "/qfi-bench-%1" ).arg( QCoreApplication::applicationPid() );
+
+    qfi::TelemetryRing::Writer writer;
+    qfi::TelemetryRing::Reader reader;
+
+    if ( !writer.open( name ) || !reader.open( name ) ) {
+        std::fprintf( stderr, "Cannot open telemetry ring: %s\n", qPrintable( writer.errorString() ) );
+        qfi::TelemetryRing::Writer::unlink( name );
+        return;
+    }
+
+    qfi::TelemetrySample sample;
+    qfi::TelemetrySample copy;
+
+    bench->run( "ring/handoff/1000", [ &writer, &reader, &sample, &copy ]()
+    {
+        QElapsedTimer timer;
+        timer.start();
+
+        for ( int i = 0; i < 1000; ++i ) {
+            sample.time = i;
+            writer.write( sample );
+            reader.next( &copy );
+        }
+
+        return timer.nsecsElapsed();
+    } );
+
+    qfi::TelemetryRing::Writer::unlink( name );
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    // benchmarks run without any display
+    if ( qEnvironmentVariableIsEmpty( "QT_QPA_PLATFORM" ) ) {
+        qputenv( "QT_QPA_PLATFORM", "offscreen" );
+    }
+
+    QApplication app(argc, argv);
+    QApplication::setApplicationName( "qfi-bench" );
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription( "Benchmarks instruments construction, reinit, update and paint." );
+    parser.addHelpOption();
+
+    const QCommandLineOption outputOption( QStringList() << "o" << "output",
+                                           "Writes results to the JSON file.", "file" );
+    const QCommandLineOption baselineOption( QStringList() << "b" << "baseline",
+                                             "Compares results with the baseline JSON file.", "file" );
+    const QCommandLineOption toleranceOption( QStringList() << "t" << "tolerance",
+                                              "Allowed slowdown against the baseline [%].", "percent", "10" );
+    const QCommandLineOption timeOption( QStringList() << "m" << "min-time",
+                                         "Minimum time spent on each case [ms].", "ms", "200" );
+    const QCommandLineOption filterOption( QStringList() << "f" << "filter",
+                                           "Runs only cases which names contain the text.", "text" );
+    const QCommandLineOption sizeOption( QStringList() << "s" << "size",
+                                         "Paint and update size [px].", "px", "480" );
+    const QCommandLineOption profileOption( QStringList() << "p" << "profile",
+                                            "Performance profile: quality, throughput or low-power.",
+                                            "name", "quality" );
+
+    parser.addOption( outputOption );
+    parser.addOption( baselineOption );
+    parser.addOption( toleranceOption );
+    parser.addOption( timeOption );
+    parser.addOption( filterOption );
+    parser.addOption( sizeOption );
+    parser.addOption( profileOption );
+
+    parser.process( app );
+
+    const int minTime = parser.value( timeOption ).toInt();
+    const int size    = parser.value( sizeOption ).toInt();
+
+    bool profileOk = false;
+    const qfi::Profile::Type profile = qfi::Profile::fromName( parser.value( profileOption ), &profileOk );
+
+    if ( minTime <= 0 || size <= 0 || !profileOk ) parser.showHelp( 1 );
+
+    QJsonDocument baseline;
+
+    if ( parser.isSet( baselineOption ) ) {
+        QFile file( parser.value( baselineOption ) );
+
+        if ( !file.open( QFile::ReadOnly ) ) {
+            std::fprintf( stderr, "Cannot open baseline file %s\n", qPrintable( file.fileName() ) );
+            return 1;
+        }
+
+        baseline = QJsonDocument::fromJson( file.readAll() );
+    }
+
+    const std::vector<int> sizes { 120, 240, 480, 960 };
+
+    Benchmark bench( minTime, parser.value( filterOption ) );
+
+    std::printf( "%-32s %8s %12s %12s %12s\n", "case", "iters", "min [us]", "median [us]", "p99 [us]" );
+
+    benchmark< qfi::Adi::Renderer, qfi::AdiState >( &bench, "adi", sizes, size, profile );
+    benchmark< qfi::Alt::Renderer, qfi::AltState >( &bench, "alt", sizes, size, profile );
+    benchmark< qfi::Asi::Renderer, qfi::AsiState >( &bench, "asi", sizes, size, profile );
+    benchmark< qfi::Hsi::Renderer, qfi::HsiState >( &bench, "hsi", sizes, size, profile );
+    benchmark< qfi::Nav::Renderer, qfi::NavState >( &bench, "nav", sizes, size, profile );
+    benchmark< qfi::Pfd::Renderer, qfi::PfdState >( &bench, "pfd", sizes, size, profile );
+    benchmark< qfi::Tc::Renderer,  qfi::TcState  >( &bench, "tc" , sizes, size, profile );
+    benchmark< qfi::Vsi::Renderer, qfi::VsiState >( &bench, "vsi", sizes, size, profile );
+
+    benchmarkReplay( &bench, profile );
+    benchmarkArchive( &bench );
+    benchmarkCsv( &bench );
+    benchmarkMavlink( &bench );
+    benchmarkRing( &bench );
+
+    qfi::SvgRegistry::purge();
+
+    if ( parser.isSet( outputOption ) ) {
+        QFile file( parser.value( outputOption ) );
+
+        if ( !file.open( QFile::WriteOnly | QFile::Truncate ) ) {
+            std::fprintf( stderr, "Cannot write results file %s\n", qPrintable( file.fileName() ) );
+            return 1;
+        }
+
+        file.write( bench.toJson().toJson() );
+    }
+
+    if ( parser.isSet( baselineOption ) ) {
+        const int regressions = bench.compare( baseline, parser.value( toleranceOption ).toDouble() );
+
+        if ( regressions > 0 ) {
+            std::fprintf( stderr, "%d cases slower than the baseline\n", regressions );
+            return 1;
+        }
+    }
+
+    return 0;
+}
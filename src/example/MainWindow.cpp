@@ -49,137 +49,254 @@
 #include <iostream>
 #include <cmath>
 
+#include <QDoubleSpinBox>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QShortcut>
+
 #include "MainWindow.hpp"
 #include "ui_MainWindow.h"
 
 MainWindow::MainWindow(QWidget* parent) : QMainWindow(parent), m_ui(new Ui::MainWindow)
 {
     m_ui->setupUi(this);
-    m_timerId = startTimer(0);
-    m_time.start();
+
+    m_scheduler = new qfi::RenderScheduler( this );
+
+    m_scheduler->add( m_ui->widgetPFD->renderer() );
+    m_scheduler->add( m_ui->widgetNAV->renderer() );
+    m_ui->widgetSix->addTo( m_scheduler );
+
+    connect( m_scheduler, &qfi::RenderScheduler::frame, this, &MainWindow::step );
+
+    // manual changes wake the scheduler, it idles while nothing changes
+    for ( QDoubleSpinBox* spinBox : findChildren<QDoubleSpinBox*>() ) {
+        connect( spinBox, static_cast<void(QDoubleSpinBox::*)(double)>(&QDoubleSpinBox::valueChanged),
+                 m_scheduler, &qfi::RenderScheduler::requestUpdate );
+    }
+
+    connect( m_ui->pushButtonAuto, &QPushButton::toggled,
+             m_scheduler, &qfi::RenderScheduler::requestUpdate );
+
+    // replay control: pause/resume, previous and next sample
+    connect( new QShortcut( QKeySequence( Qt::CTRL + Qt::Key_Space ), this ), &QShortcut::activated,
+             this, &MainWindow::pauseReplay );
+    connect( new QShortcut( QKeySequence( Qt::CTRL + Qt::Key_Left ), this ), &QShortcut::activated,
+             this, [ this ]() { stepReplay( -1 ); } );
+    connect( new QShortcut( QKeySequence( Qt::CTRL + Qt::Key_Right ), this ), &QShortcut::activated,
+             this, [ this ]() { stepReplay( 1 ); } );
+
+    // every received message wakes the scheduler
+    connect( &m_mavlink, &qfi::MavlinkInput::received, m_scheduler, &qfi::RenderScheduler::requestUpdate );
+    connect( &m_mavlink, &qfi::MavlinkInput::staleChanged, this, &MainWindow::linkChanged );
 }
 
 MainWindow::~MainWindow()
 {
     std::cout << "Average time step: " << static_cast<double>(m_realTime / m_steps) << " s" << std::endl;
+    std::cout << "Frame rate: " << m_scheduler->frameRate() << " Hz" << std::endl;
+    std::cout << "Frames: " << m_scheduler->frames() << std::endl;
+    std::cout << "Missed deadlines: " << m_scheduler->missed() << std::endl;
+
+    QJsonObject timings;
+
+    timings.insert( "pfd", m_ui->widgetPFD->renderer()->timings().toJson() );
+    timings.insert( "nav", m_ui->widgetNAV->renderer()->timings().toJson() );
+
+    std::cout << "Timings [ns]: " << QJsonDocument( timings ).toJson().constData() << std::endl;
+
+    if ( m_recorder.isOpen() ) {
+        m_recorder.close();
+
+        std::cout << "Recorded samples: " << m_recorder.samples() << std::endl;
+
+        if ( m_recorder.isCompressed() ) {
+            std::cout << "Compression ratio: " << m_recorder.archive().compressionRatio() << std::endl;
+        }
+    }
 
-    if ( m_timerId ) killTimer( m_timerId );
+    if ( m_mavlink.parser().frames() > 0 ) {
+        std::cout << "MAVLink frames: " << m_mavlink.parser().frames()
+                  << " (errors: " << m_mavlink.parser().errors()
+                  << ", lost: " << m_mavlink.parser().lost() << ")" << std::endl;
+    }
+
+    if ( m_replay.isCompressed() ) {
+        std::cout << "Replay decoding [samples/s]: " << m_replay.archive().throughput() << std::endl;
+    }
 
     if ( m_ui ) { delete m_ui; m_ui = nullptr; }
 }
 
-void MainWindow::timerEvent(QTimerEvent* event)
+bool MainWindow::record(const QString& fileName, const bool compressed)
+{
+    m_recorder.setCompressed( compressed );
+
+    if ( !m_recorder.open( fileName ) ) {
+        std::cerr << "Cannot record " << fileName.toStdString() << ": "
+                  << m_recorder.errorString().toStdString() << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+bool MainWindow::replay(const QString& fileName, const double speed, const double start)
+{
+    if ( !m_replay.open( fileName ) ) {
+        std::cerr << "Cannot replay " << fileName.toStdString() << ": "
+                  << m_replay.errorString().toStdString() << std::endl;
+        return false;
+    }
+
+    m_replay.setSpeed( speed );
+    m_replay.seek( m_replay.startTime() + static_cast<qint64>( 1.0e9 * start ) );
+    m_scheduler->requestUpdate();
+
+    return true;
+}
+
+bool MainWindow::mavlink(const QString& source)
+{
+    if ( !m_mavlink.open( source ) ) {
+        std::cerr << "Cannot open MAVLink source " << source.toStdString() << ": "
+                  << m_mavlink.errorString().toStdString() << std::endl;
+        return false;
+    }
+
+    linkChanged( m_mavlink.isStale() );
+
+    return true;
+}
+
+bool MainWindow::ring(const QString& name)
+{
+    if ( !m_ring.open( name ) ) {
+        std::cerr << "Cannot open telemetry ring " << name.toStdString() << ": "
+                  << m_ring.errorString().toStdString() << std::endl;
+        return false;
+    }
+
+    m_scheduler->requestUpdate();
+
+    return true;
+}
+
+void MainWindow::step(double timeStep)
 {
-    QMainWindow::timerEvent( event );
-
-    const float timeStep{static_cast<float>(m_time.restart())};
-
-    m_realTime = m_realTime + timeStep / 1000.0f;
-
-    float alpha{};
-    float beta{};
-    float roll{};
-    float pitch{};
-    float heading{};
-    float slipSkid{};
-    float turnRate{};
-    float devH{};
-    float devV{};
-    float airspeed{};
-    float altitude{};
-    float pressure{28.0f};
-    float climbRate{};
-    float machNo{};
-    float adf{};
-    float dme{};
-
-    if ( m_ui->pushButtonAuto->isChecked() ) {
-        alpha     =   20.0f * std::sin( m_realTime /  10.0f );
-        beta      =   15.0f * std::sin( m_realTime /  10.0f );
-        roll      =  180.0f * std::sin( m_realTime /  10.0f );
-        pitch     =   90.0f * std::sin( m_realTime /  20.0f );
-        heading   =  360.0f * std::sin( m_realTime /  40.0f );
-        slipSkid  =    1.0f * std::sin( m_realTime /  10.0f );
-        turnRate  =    7.0f * std::sin( m_realTime /  10.0f );
-        devH      =    1.0f * std::sin( m_realTime /  20.0f );
-        devV      =    1.0f * std::sin( m_realTime /  20.0f );
-        airspeed  =  125.0f * std::sin( m_realTime /  40.0f ) +  125.0f;
-        altitude  = 9000.0f * std::sin( m_realTime /  40.0f ) + 9000.0f;
-        pressure  =    2.0f * std::sin( m_realTime /  20.0f ) +   30.0f;
-        climbRate =  650.0f * std::sin( m_realTime /  20.0f );
-        machNo    = airspeed / 650.0f;
-        adf       = -360.0f * std::sin( m_realTime /  50.0f );
-        dme       =   99.0f * std::sin( m_realTime / 100.0f );
-
-        m_ui->spinBoxAlpha->setValue(alpha);
-        m_ui->spinBoxBeta->setValue(beta);
-        m_ui->spinBoxRoll->setValue(roll);
-        m_ui->spinBoxPitch->setValue(pitch);
-        m_ui->spinBoxSlip->setValue(slipSkid);
-        m_ui->spinBoxTurn->setValue(turnRate);
-        m_ui->spinBoxDevH->setValue(devH);
-        m_ui->spinBoxDevV->setValue(devV);
-        m_ui->spinBoxHead->setValue(heading);
-        m_ui->spinBoxSpeed->setValue(airspeed);
-        m_ui->spinBoxMach->setValue(machNo);
-        m_ui->spinBoxAlt->setValue(altitude);
-        m_ui->spinBoxPress->setValue(pressure);
-        m_ui->spinBoxClimb->setValue(climbRate);
-        m_ui->spinBoxADF->setValue(adf);
-        m_ui->spinBoxDME->setValue(dme);
+    m_realTime = m_realTime + static_cast<float>(timeStep);
+
+    qfi::TelemetrySample sample;
+
+    if ( m_ring.isOpen() ) {
+        // polled at frame time, the producer runs at its own rate
+        m_ring.read( &m_ringSample );
+        sample = m_ringSample;
+        setSpinBoxes( sample );
+
+        m_scheduler->requestUpdate();
+    } else if ( m_mavlink.isOpen() ) {
+        sample = m_mavlink.sample();
+        setSpinBoxes( sample );
+    } else if ( m_replay.isOpen() ) {
+        sample = m_replay.advance( timeStep );
+        setSpinBoxes( sample );
+
+        // scheduler idles while nothing changes, running replay keeps it ticking
+        if ( !m_replay.isPaused() && !m_replay.atEnd() ) m_scheduler->requestUpdate();
+    } else if ( m_ui->pushButtonAuto->isChecked() ) {
+        sample.alpha      =   20.0f * std::sin( m_realTime /  10.0f );
+        sample.beta       =   15.0f * std::sin( m_realTime /  10.0f );
+        sample.roll       =  180.0f * std::sin( m_realTime /  10.0f );
+        sample.pitch      =   90.0f * std::sin( m_realTime /  20.0f );
+        sample.heading    =  360.0f * std::sin( m_realTime /  40.0f );
+        sample.slipSkid   =    1.0f * std::sin( m_realTime /  10.0f );
+        sample.turnRate   =    7.0f * std::sin( m_realTime /  10.0f );
+        sample.devH       =    1.0f * std::sin( m_realTime /  20.0f );
+        sample.devV       =    1.0f * std::sin( m_realTime /  20.0f );
+        sample.airspeed   =  125.0f * std::sin( m_realTime /  40.0f ) +  125.0f;
+        sample.altitude   = 9000.0f * std::sin( m_realTime /  40.0f ) + 9000.0f;
+        sample.pressure   =    2.0f * std::sin( m_realTime /  20.0f ) +   30.0f;
+        sample.climbRate  =  650.0f * std::sin( m_realTime /  20.0f );
+        sample.mach       = sample.airspeed / 650.0f;
+        sample.bearing    = -360.0f * std::sin( m_realTime /  50.0f );
+        sample.distance   =   99.0f * std::sin( m_realTime / 100.0f );
+
+        setSpinBoxes( sample );
     } else {
-        alpha     = static_cast<float>(m_ui->spinBoxAlpha->value());
-        beta      = static_cast<float>(m_ui->spinBoxBeta->value());
-        roll      = static_cast<float>(m_ui->spinBoxRoll->value());
-        pitch     = static_cast<float>(m_ui->spinBoxPitch->value());
-        heading   = static_cast<float>(m_ui->spinBoxHead->value());
-        slipSkid  = static_cast<float>(m_ui->spinBoxSlip->value());
-        turnRate  = static_cast<float>(m_ui->spinBoxTurn->value());
-        devH      = static_cast<float>(m_ui->spinBoxDevH->value());
-        devV      = static_cast<float>(m_ui->spinBoxDevV->value());
-        airspeed  = static_cast<float>(m_ui->spinBoxSpeed->value());
-        pressure  = static_cast<float>(m_ui->spinBoxPress->value());
-        altitude  = static_cast<float>(m_ui->spinBoxAlt->value());
-        climbRate = static_cast<float>(m_ui->spinBoxClimb->value());
-        machNo    = static_cast<float>(m_ui->spinBoxMach->value());
-        adf       = static_cast<float>(m_ui->spinBoxADF->value());
-        dme       = static_cast<float>(m_ui->spinBoxDME->value());
+        sample.alpha      = static_cast<float>(m_ui->spinBoxAlpha->value());
+        sample.beta       = static_cast<float>(m_ui->spinBoxBeta->value());
+        sample.roll       = static_cast<float>(m_ui->spinBoxRoll->value());
+        sample.pitch      = static_cast<float>(m_ui->spinBoxPitch->value());
+        sample.heading    = static_cast<float>(m_ui->spinBoxHead->value());
+        sample.slipSkid   = static_cast<float>(m_ui->spinBoxSlip->value());
+        sample.turnRate   = static_cast<float>(m_ui->spinBoxTurn->value());
+        sample.devH       = static_cast<float>(m_ui->spinBoxDevH->value());
+        sample.devV       = static_cast<float>(m_ui->spinBoxDevV->value());
+        sample.airspeed   = static_cast<float>(m_ui->spinBoxSpeed->value());
+        sample.pressure   = static_cast<float>(m_ui->spinBoxPress->value());
+        sample.altitude   = static_cast<float>(m_ui->spinBoxAlt->value());
+        sample.climbRate  = static_cast<float>(m_ui->spinBoxClimb->value());
+        sample.mach       = static_cast<float>(m_ui->spinBoxMach->value());
+        sample.bearing    = static_cast<float>(m_ui->spinBoxADF->value());
+        sample.distance   = static_cast<float>(m_ui->spinBoxDME->value());
     }
 
-    m_ui->widgetPFD->setFlightPathMarker(alpha, beta);
-    m_ui->widgetPFD->setRoll(roll);
-    m_ui->widgetPFD->setPitch(pitch);
-    m_ui->widgetPFD->setSlipSkid(slipSkid);
-    m_ui->widgetPFD->setTurnRate(turnRate / 6.0f);
-    m_ui->widgetPFD->setDevH(devH);
-    m_ui->widgetPFD->setDevV(devV);
-    m_ui->widgetPFD->setHeading(heading);
-    m_ui->widgetPFD->setAirspeed(airspeed);
-    m_ui->widgetPFD->setMachNo(machNo);
-    m_ui->widgetPFD->setAltitude(altitude);
-    m_ui->widgetPFD->setPressure(pressure);
-    m_ui->widgetPFD->setClimbRate(climbRate / 100.0f);
-
-    m_ui->widgetNAV->setHeading(heading);
-    m_ui->widgetNAV->setHeadingBug(0.0f);
-    m_ui->widgetNAV->setCourse(0.0f);
-    m_ui->widgetNAV->setBearing(adf, true);
-    m_ui->widgetNAV->setDeviation(devH, true);
-    m_ui->widgetNAV->setDistance(dme, true);
-
-    m_ui->widgetSix->setRoll(roll);
-    m_ui->widgetSix->setPitch(pitch);
-    m_ui->widgetSix->setAltitude(altitude);
-    m_ui->widgetSix->setPressure(pressure);
-    m_ui->widgetSix->setAirspeed(airspeed);
-    m_ui->widgetSix->setHeading(heading);
-    m_ui->widgetSix->setSlipSkid(slipSkid * 15.0f);
-    m_ui->widgetSix->setTurnRate(turnRate);
-    m_ui->widgetSix->setClimbRate(climbRate);
-
-    m_ui->widgetPFD->update();
-    m_ui->widgetNAV->update();
-    m_ui->widgetSix->update();
+    if ( m_recorder.isOpen() ) m_recorder.record( sample );
+
+    m_ui->widgetPFD->setState( sample.pfd() );
+    m_ui->widgetNAV->setState( sample.nav() );
+
+    m_ui->widgetSix->setRoll(sample.roll);
+    m_ui->widgetSix->setPitch(sample.pitch);
+    m_ui->widgetSix->setAltitude(sample.altitude);
+    m_ui->widgetSix->setPressure(sample.pressure);
+    m_ui->widgetSix->setAirspeed(sample.airspeed);
+    m_ui->widgetSix->setHeading(sample.heading);
+    m_ui->widgetSix->setSlipSkid(sample.slipSkid * 15.0f);
+    m_ui->widgetSix->setTurnRate(sample.turnRate);
+    m_ui->widgetSix->setClimbRate(sample.climbRate);
+
+    // instruments are refreshed by the scheduler right after this call
 
     m_steps++;
 }
+
+void MainWindow::pauseReplay()
+{
+    m_replay.setPaused( !m_replay.isPaused() );
+    m_scheduler->requestUpdate();
+}
+
+void MainWindow::stepReplay(const int samples)
+{
+    if ( m_replay.isOpen() ) {
+        m_replay.step( samples );
+        m_scheduler->requestUpdate();
+    }
+}
+
+void MainWindow::linkChanged(bool stale)
+{
+    setWindowTitle( stale ? "QFlightInstruments Example (MAVLink link lost)" : "QFlightInstruments Example" );
+}
+
+void MainWindow::setSpinBoxes(const qfi::TelemetrySample& sample)
+{
+    m_ui->spinBoxAlpha->setValue(sample.alpha);
+    m_ui->spinBoxBeta->setValue(sample.beta);
+    m_ui->spinBoxRoll->setValue(sample.roll);
+    m_ui->spinBoxPitch->setValue(sample.pitch);
+    m_ui->spinBoxSlip->setValue(sample.slipSkid);
+    m_ui->spinBoxTurn->setValue(sample.turnRate);
+    m_ui->spinBoxDevH->setValue(sample.devH);
+    m_ui->spinBoxDevV->setValue(sample.devV);
+    m_ui->spinBoxHead->setValue(sample.heading);
+    m_ui->spinBoxSpeed->setValue(sample.airspeed);
+    m_ui->spinBoxMach->setValue(sample.mach);
+    m_ui->spinBoxAlt->setValue(sample.altitude);
+    m_ui->spinBoxPress->setValue(sample.pressure);
+    m_ui->spinBoxClimb->setValue(sample.climbRate);
+    m_ui->spinBoxADF->setValue(sample.bearing);
+    m_ui->spinBoxDME->setValue(sample.distance);
+}
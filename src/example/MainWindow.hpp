@@ -49,7 +49,12 @@
 #define __MAINWINDOW_H__
 
 #include <QMainWindow>
-#include <QTime>
+
+#include <MavlinkInput.hpp>
+#include <RenderScheduler.hpp>
+#include <TelemetryRecorder.hpp>
+#include <TelemetryReplay.hpp>
+#include <TelemetryRing.hpp>
 
 namespace Ui { class MainWindow; }
 
@@ -61,18 +66,57 @@ public:
     explicit MainWindow(QWidget* parent = nullptr);
     ~MainWindow();
 
-protected:
-    void timerEvent( QTimerEvent *event );
-    
+    //
+    // records instruments states into the telemetry file, optionally
+    // compressed, returns false on error
+    //
+    bool record(const QString& fileName, const bool compressed = false);
+
+    //
+    // replays telemetry file at the given speed from the given time [s]
+    // instead of the generated or manually set states, returns false on error
+    //
+    bool replay(const QString& fileName, const double speed = 1.0, const double start = 0.0);
+
+    //
+    // shows states received from MAVLink source (see qfi::MavlinkInput::open())
+    // instead of the generated or manually set states, returns false on error
+    //
+    bool mavlink(const QString& source);
+
+    //
+    // shows states published into the shared memory ring of the given name
+    // (see qfi::TelemetryRing) instead of the generated or manually set
+    // states, returns false on error
+    //
+    bool ring(const QString& name);
+
+private slots:
+    void step(double timeStep);
+
+    void pauseReplay();
+    void stepReplay(const int samples);
+
+    void linkChanged(bool stale);
+
 private:
+    void setSpinBoxes(const qfi::TelemetrySample& sample);
+
     Ui::MainWindow *m_ui{};
 
-    int m_timerId{};
+    qfi::RenderScheduler* m_scheduler{};
+
+    qfi::TelemetryRecorder m_recorder;
+    qfi::TelemetryReplay m_replay;
+
+    qfi::MavlinkInput m_mavlink;
+
+    qfi::TelemetryRing::Reader m_ring;
+    qfi::TelemetrySample m_ringSample;      ///< latest sample read from the ring
+
     int m_steps{};
 
     float m_realTime{};
-
-    QTime m_time;
 };
 
 #endif
@@ -68,6 +68,10 @@ public:
         m_adi->update();
     }
 
+    inline qfi::Adi::Renderer* renderer() const {
+        return m_adi->renderer();
+    }
+
     inline void setRoll(const float roll) {
         m_adi->setRoll( roll );
     }
@@ -68,6 +68,10 @@ public:
         m_alt->update();
     }
 
+    inline qfi::Alt::Renderer* renderer() const {
+        return m_alt->renderer();
+    }
+
     inline void setAltitude(const float altitude) {
         m_alt->setAltitude(altitude);
     }
@@ -68,6 +68,10 @@ public:
         m_asi->update();
     }
 
+    inline qfi::Asi::Renderer* renderer() const {
+        return m_asi->renderer();
+    }
+
     inline void setAirspeed(const float airspeed) {
         m_asi->setAirspeed( airspeed );
     }
@@ -68,6 +68,10 @@ public:
         m_hsi->update();
     }
 
+    inline qfi::Hsi::Renderer* renderer() const {
+        return m_hsi->renderer();
+    }
+
     inline void setHeading(const float heading) {
         m_hsi->setHeading( heading );
     }
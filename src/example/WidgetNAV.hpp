@@ -68,6 +68,14 @@ public:
         m_nav->update();
     }
 
+    inline qfi::Nav::Renderer* renderer() const {
+        return m_nav->renderer();
+    }
+
+    inline void setState(const qfi::NavState& state) {
+        m_nav->setState( state );
+    }
+
     inline void setHeading(const float heading) {
         m_nav->setHeading( heading );
     }
@@ -68,6 +68,14 @@ public:
         m_pfd->update();
     }
 
+    inline qfi::Pfd::Renderer* renderer() const {
+        return m_pfd->renderer();
+    }
+
+    inline void setState(const qfi::PfdState& state) {
+        m_pfd->setState( state );
+    }
+
     inline void setRoll(const float roll) {
         m_pfd->setRoll( roll );
     }
@@ -53,25 +53,47 @@ WidgetSix::WidgetSix(QWidget* parent) : QWidget(parent), m_ui(new Ui::WidgetSix)
 {
     m_ui->setupUi(this);
 
-    m_widgetADI = m_ui->widgetADI;
-    m_widgetALT = m_ui->widgetALT;
-    m_widgetASI = m_ui->widgetASI;
-    m_widgetHSI = m_ui->widgetHSI;
-    m_widgetTC  = m_ui->widgetTC;
-    m_widgetVSI = m_ui->widgetVSI;
+    m_panel = m_ui->panel;
+
+    m_adi = new qfi::Adi::Renderer();
+    m_alt = new qfi::Alt::Renderer();
+    m_asi = new qfi::Asi::Renderer();
+    m_hsi = new qfi::Hsi::Renderer();
+    m_tc  = new qfi::Tc::Renderer();
+    m_vsi = new qfi::Vsi::Renderer();
+
+    m_panel->setColumns( 3 );
+
+    m_panel->add( m_asi );
+    m_panel->add( m_adi );
+    m_panel->add( m_alt );
+    m_panel->add( m_tc  );
+    m_panel->add( m_hsi );
+    m_panel->add( m_vsi );
 }
 
 WidgetSix::~WidgetSix()
 {
+    // instruments are removed from the panel before they are deleted
+    for ( qfi::Instrument* instrument : instruments() ) {
+        m_panel->remove( instrument );
+        delete instrument;
+    }
+
     if ( m_ui ) { delete m_ui; m_ui = nullptr; }
 }
 
 void WidgetSix::update()
 {
-    m_ui->widgetADI->update();
-    m_ui->widgetALT->update();
-    m_ui->widgetASI->update();
-    m_ui->widgetHSI->update();
-    m_ui->widgetTC->update();
-    m_ui->widgetVSI->update();
+    m_panel->update();
+}
+
+void WidgetSix::addTo(qfi::RenderScheduler* scheduler)
+{
+    for ( qfi::Instrument* instrument : instruments() ) scheduler->add( instrument );
+}
+
+QVector<qfi::Instrument*> WidgetSix::instruments() const
+{
+    return { m_asi, m_adi, m_alt, m_tc, m_hsi, m_vsi };
 }
@@ -50,12 +50,14 @@
 
 #include <QWidget>
 
-#include "WidgetADI.hpp"
-#include "WidgetALT.hpp"
-#include "WidgetASI.hpp"
-#include "WidgetHSI.hpp"
-#include "WidgetTC.hpp"
-#include "WidgetVSI.hpp"
+#include <Adi.hpp>
+#include <Alt.hpp>
+#include <Asi.hpp>
+#include <Hsi.hpp>
+#include <Panel.hpp>
+#include <RenderScheduler.hpp>
+#include <Tc.hpp>
+#include <Vsi.hpp>
 
 namespace Ui { class WidgetSix; }
 
@@ -69,51 +71,60 @@ public:
 
     void update();
 
+    // registers all the instruments in the scheduler
+    void addTo(qfi::RenderScheduler* scheduler);
+
     inline void setRoll(const float roll) {
-        m_widgetADI->setRoll( roll );
+        m_adi->setRoll( roll );
     }
 
     inline void setPitch(const float pitch) {
-        m_widgetADI->setPitch( pitch );
+        m_adi->setPitch( pitch );
     }
 
     inline void setAltitude(const float altitude) {
-        m_widgetALT->setAltitude( altitude );
+        m_alt->setAltitude( altitude );
     }
 
     inline void setPressure(const float pressure) {
-        m_widgetALT->setPressure( pressure );
+        m_alt->setPressure( pressure );
     }
 
     inline void setAirspeed(const float airspeed) {
-        m_widgetASI->setAirspeed( airspeed );
+        m_asi->setAirspeed( airspeed );
     }
 
     inline void setHeading(const float heading) {
-        m_widgetHSI->setHeading( heading );
+        m_hsi->setHeading( heading );
     }
 
     inline void setTurnRate(const float turnRate) {
-        m_widgetTC->setTurnRate( turnRate );
+        m_tc->setTurnRate( turnRate );
     }
 
     inline void setSlipSkid(const float slipSkid) {
-        m_widgetTC->setSlipSkid( slipSkid );
+        m_tc->setSlipSkid( slipSkid );
     }
 
     inline void setClimbRate(const float climbRate) {
-        m_widgetVSI->setClimbRate( climbRate );
+        m_vsi->setClimbRate( climbRate );
     }
 
 private:
+    // instruments in the panel order
+    QVector<qfi::Instrument*> instruments() const;
+
     Ui::WidgetSix* m_ui{};
 
-    WidgetADI* m_widgetADI{};
-    WidgetALT* m_widgetALT{};
-    WidgetASI* m_widgetASI{};
-    WidgetHSI* m_widgetHSI{};
-    WidgetTC * m_widgetTC{};
-    WidgetVSI* m_widgetVSI{};
+    // all the instruments are painted by a single panel view
+    qfi::Panel* m_panel{};
+
+    qfi::Adi::Renderer* m_adi{};
+    qfi::Alt::Renderer* m_alt{};
+    qfi::Asi::Renderer* m_asi{};
+    qfi::Hsi::Renderer* m_hsi{};
+    qfi::Tc::Renderer*  m_tc{};
+    qfi::Vsi::Renderer* m_vsi{};
 };
 
 #endif
@@ -68,6 +68,10 @@ public:
         m_tc->update();
     }
 
+    inline qfi::Tc::Renderer* renderer() const {
+        return m_tc->renderer();
+    }
+
     inline void setTurnRate(const float turnRate) {
         m_tc->setTurnRate(turnRate);
     }
@@ -71,6 +71,10 @@ public:
         m_vsi->update();
     }
 
+    inline qfi::Vsi::Renderer* renderer() const {
+        return m_vsi->renderer();
+    }
+
     inline void setClimbRate(const float climbRate) {
         m_vsi->setClimbRate(climbRate);
     }
@@ -48,12 +48,56 @@
 
 #include "MainWindow.hpp"
 #include <QApplication>
+#include <QCommandLineParser>
 
 int main(int argc, char *argv[])
 {
     QApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription( "QFlightInstruments example." );
+    parser.addHelpOption();
+
+    const QCommandLineOption recordOption( QStringList() << "r" << "record",
+                                           "Records instruments states into the telemetry file.", "file" );
+    const QCommandLineOption compressOption( QStringList() << "c" << "compress",
+                                             "Compresses the recorded telemetry file." );
+    const QCommandLineOption replayOption( QStringList() << "p" << "replay",
+                                           "Replays the telemetry file (Ctrl+Space pauses, Ctrl+Left/Right step).", "file" );
+    const QCommandLineOption mavlinkOption( QStringList() << "m" << "mavlink",
+                                            "Shows states received over MAVLink: udp:<port>, serial:<device>[:<baud>] or a tlog file.",
+                                            "source" );
+    const QCommandLineOption ringOption( QStringList() << "g" << "ring",
+                                         "Shows states published into the shared memory ring, e.g. /qfi.", "name" );
+    const QCommandLineOption speedOption( QStringList() << "s" << "speed",
+                                          "Replay speed, 1 is real time.", "factor", "1" );
+    const QCommandLineOption startOption( QStringList() << "t" << "start",
+                                          "Replay start time [s].", "time", "0" );
+
+    parser.addOption( recordOption );
+    parser.addOption( compressOption );
+    parser.addOption( replayOption );
+    parser.addOption( mavlinkOption );
+    parser.addOption( ringOption );
+    parser.addOption( speedOption );
+    parser.addOption( startOption );
+
+    parser.process( app );
+
     MainWindow win;
 
+    if ( parser.isSet( recordOption ) && !win.record( parser.value( recordOption ),
+                                                          parser.isSet( compressOption ) ) ) return 1;
+
+    if ( parser.isSet( replayOption )
+         && !win.replay( parser.value( replayOption ),
+                         parser.value( speedOption ).toDouble(),
+                         parser.value( startOption ).toDouble() ) ) return 1;
+
+    if ( parser.isSet( mavlinkOption ) && !win.mavlink( parser.value( mavlinkOption ) ) ) return 1;
+
+    if ( parser.isSet( ringOption ) && !win.ring( parser.value( ringOption ) ) ) return 1;
+
     win.show();
     
     return app.exec();
@@ -0,0 +1,35 @@
+#-------------------------------------------------
+#
+# Producer library of the shared memory telemetry
+# ring, linked by simulators feeding the instruments
+#
+#-------------------------------------------------
+
+QT = core
+
+TARGET = qfi-ring
+TEMPLATE = lib
+CONFIG += c++11 staticlib
+
+#-------------------------------------------------
+
+win32: DEFINES += WIN32 _WINDOWS _USE_MATH_DEFINES
+
+win32:CONFIG(release, debug|release):    DEFINES += NDEBUG
+else:win32:CONFIG(debug, debug|release): DEFINES += _DEBUG
+
+# shm_open() is in librt on older glibc
+linux: LIBS += -lrt
+
+#-------------------------------------------------
+
+INCLUDEPATH += ./
+
+#-------------------------------------------------
+
+HEADERS += \
+    Telemetry.hpp \
+    TelemetryRing.hpp
+
+SOURCES += \
+    TelemetryRing.cpp
@@ -0,0 +1,39 @@
+#-------------------------------------------------
+#
+# Test program publishing generated flight into
+# the shared memory telemetry ring at 1 kHz
+#
+#-------------------------------------------------
+
+QT = core
+
+TARGET = qfi-sim
+TEMPLATE = app
+CONFIG += c++11 console
+CONFIG -= app_bundle
+
+#-------------------------------------------------
+
+win32: DEFINES += WIN32 _WINDOWS _USE_MATH_DEFINES
+
+win32:CONFIG(release, debug|release):    DEFINES += NDEBUG
+else:win32:CONFIG(debug, debug|release): DEFINES += _DEBUG
+
+unix: LIBS += -lpthread
+
+# shm_open() is in librt on older glibc
+linux: LIBS += -lrt
+
+#-------------------------------------------------
+
+INCLUDEPATH += ./
+
+#-------------------------------------------------
+
+HEADERS += \
+    Telemetry.hpp \
+    TelemetryRing.hpp
+
+SOURCES += \
+    sim/main.cpp \
+    TelemetryRing.cpp
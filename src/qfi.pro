@@ -4,7 +4,7 @@
 #
 #-------------------------------------------------
 
-QT += svg
+QT += network svg
 
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
@@ -21,6 +21,9 @@ win32: DEFINES += WIN32 _WINDOWS _USE_MATH_DEFINES
 win32:CONFIG(release, debug|release):    DEFINES += NDEBUG
 else:win32:CONFIG(debug, debug|release): DEFINES += _DEBUG
 
+# shm_open() is in librt on older glibc
+linux: LIBS += -lrt
+
 #-------------------------------------------------
 
 INCLUDEPATH += ./
@@ -31,20 +34,65 @@ HEADERS += \
     Adi.hpp \
     Alt.hpp \
     Asi.hpp \
+    Compositor.hpp \
+    GlyphAtlas.hpp \
+    Gorilla.hpp \
     Hsi.hpp \
+    Instrument.hpp \
+    Ladder.hpp \
+    Mavlink.hpp \
+    MavlinkInput.hpp \
     Nav.hpp \
+    Panel.hpp \
     Pfd.hpp \
+    Profile.hpp \
+    Readout.hpp \
+    RenderScheduler.hpp \
+    SpriteCache.hpp \
+    SvgItem.hpp \
+    SvgRegistry.hpp \
+    Tape.hpp \
     Tc.hpp \
+    Telemetry.hpp \
+    TelemetryArchive.hpp \
+    TelemetryCsvReader.hpp \
+    TelemetryRecorder.hpp \
+    TelemetryReplay.hpp \
+    TelemetryRing.hpp \
+    Timings.hpp \
+    TripleBuffer.hpp \
     Vsi.hpp
 
 SOURCES += \
     Adi.cpp \
     Alt.cpp \
     Asi.cpp \
+    Compositor.cpp \
+    GlyphAtlas.cpp \
+    Gorilla.cpp \
     Hsi.cpp \
+    Instrument.cpp \
+    Ladder.cpp \
+    Mavlink.cpp \
+    MavlinkInput.cpp \
     Nav.cpp \
+    Panel.cpp \
     Pfd.cpp \
+    Profile.cpp \
+    Readout.cpp \
+    RenderScheduler.cpp \
+    SpriteCache.cpp \
+    SvgItem.cpp \
+    SvgRegistry.cpp \
+    Tape.cpp \
     Tc.cpp \
+    Telemetry.cpp \
+    TelemetryArchive.cpp \
+    TelemetryCsvReader.cpp \
+    TelemetryRecorder.cpp \
+    TelemetryReplay.cpp \
+    TelemetryRing.cpp \
+    Timings.cpp \
     Vsi.cpp
 
 RESOURCES += \
@@ -0,0 +1,217 @@
+/***************************************************************************//**
+ * @file render/FrameExporter.cpp
+ * @author  Marek M. Cel <marekcel@marekcel.pl>
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * This file is part of QFlightInstruments. You can redistribute and modify it
+ * under the terms of GNU General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.
+ * 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ *
+ * Further information about the GNU General Public License can also be found
+ * on the world wide web at http://www.gnu.org.
+ *
+ * ---
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include "FrameExporter.hpp"
+
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+
+FrameExporter::FrameExporter(const TelemetryFile* telemetry, const Layout layout,
+                             const Format format, const int size, const QString& outputDir) :
+    m_telemetry(telemetry),
+    m_outputDir(outputDir),
+    m_layout(layout),
+    m_format(format),
+    m_size(size)
+{}
+
+FrameExporter::~FrameExporter()
+{
+    release();
+}
+
+void FrameExporter::exportFrame(const int frame)
+{
+    // renderers are created lazily so that they belong to the worker thread
+    if ( m_image.isNull() ) init();
+
+    QElapsedTimer timer;
+    timer.start();
+
+    TelemetryFile::Sample sample;
+    m_telemetry->decode( frame, &sample );
+    setState( sample );
+
+    m_timing.decode += timer.nsecsElapsed();
+    timer.restart();
+
+    render();
+
+    m_timing.render += timer.nsecsElapsed();
+    timer.restart();
+
+    if ( !encode( frame ) ) m_timing.failures++;
+
+    m_timing.encode += timer.nsecsElapsed();
+    m_timing.frames++;
+}
+
+void FrameExporter::release()
+{
+    if ( m_pfd ) { delete m_pfd; m_pfd = nullptr; }
+    if ( m_nav ) { delete m_nav; m_nav = nullptr; }
+    if ( m_asi ) { delete m_asi; m_asi = nullptr; }
+    if ( m_adi ) { delete m_adi; m_adi = nullptr; }
+    if ( m_alt ) { delete m_alt; m_alt = nullptr; }
+    if ( m_tc  ) { delete m_tc;  m_tc  = nullptr; }
+    if ( m_hsi ) { delete m_hsi; m_hsi = nullptr; }
+    if ( m_vsi ) { delete m_vsi; m_vsi = nullptr; }
+
+    m_image = QImage();
+}
+
+void FrameExporter::init()
+{
+    switch ( m_layout )
+    {
+    case PFD:
+        m_pfd = new qfi::Pfd::Renderer();
+        m_pfd->resize( m_size, m_size );
+        m_image = QImage( m_size, m_size, QImage::Format_ARGB32_Premultiplied );
+        break;
+
+    case NAV:
+        m_nav = new qfi::Nav::Renderer();
+        m_nav->resize( m_size, m_size );
+        m_image = QImage( m_size, m_size, QImage::Format_ARGB32_Premultiplied );
+        break;
+
+    case SIX:
+        m_asi = new qfi::Asi::Renderer();
+        m_adi = new qfi::Adi::Renderer();
+        m_alt = new qfi::Alt::Renderer();
+        m_tc  = new qfi::Tc::Renderer();
+        m_hsi = new qfi::Hsi::Renderer();
+        m_vsi = new qfi::Vsi::Renderer();
+        m_image = QImage( 3 * m_size, 2 * m_size, QImage::Format_ARGB32_Premultiplied );
+        break;
+    }
+}
+
+void FrameExporter::setState(const TelemetryFile::Sample& sample)
+{
+    // scaling of the values follows the example application
+    switch ( m_layout )
+    {
+    case PFD:
+        m_pfd->setState( sample.pfd() );
+        break;
+
+    case NAV:
+        m_nav->setState( sample.nav() );
+        break;
+
+    case SIX:
+        m_asi->setState( sample.asi() );
+        m_adi->setState( sample.adi() );
+        m_alt->setState( sample.alt() );
+        m_tc->setState( sample.tc() );
+        m_hsi->setState( sample.hsi() );
+        m_vsi->setState( sample.vsi() );
+        break;
+    }
+}
+
+void FrameExporter::render()
+{
+    switch ( m_layout )
+    {
+    case PFD:
+        m_pfd->render( &m_image );
+        break;
+
+    case NAV:
+        m_nav->render( &m_image );
+        break;
+
+    case SIX:
+        {
+            qfi::Instrument* tiles[] = { m_asi, m_adi, m_alt, m_tc, m_hsi, m_vsi };
+
+            const int bytesPerLine = m_image.bytesPerLine();
+
+            // instruments are rendered straight into their tiles of the frame
+            for ( int i = 0; i < 6; ++i ) {
+                uchar* data = m_image.bits()
+                            + ( i / 3 ) * m_size * bytesPerLine
+                            + ( i % 3 ) * m_size * 4;
+
+                tiles[ i ]->render( data, m_size, m_size, bytesPerLine, true );
+            }
+        }
+        break;
+    }
+}
+
+bool FrameExporter::encode(const int frame)
+{
+    const QString fileName = QDir( m_outputDir ).filePath(
+                QString( "frame_%1.%2" ).arg( frame, 6, 10, QChar('0') )
+                                        .arg( m_format == PNG ? "png" : "rgba" ) );
+
+    // frames are painted premultiplied, which is the fastest for the raster
+    // engine, PNG writer and the conversion below take the alpha out
+    if ( m_format == PNG ) return m_image.save( fileName, "PNG" );
+
+    const QImage image = m_image.convertToFormat( QImage::Format_RGBA8888 );
+
+    QFile file( fileName );
+
+    if ( !file.open( QFile::WriteOnly | QFile::Truncate ) ) return false;
+
+    for ( int y = 0; y < image.height(); ++y ) {
+        const qint64 size = 4 * image.width();
+
+        if ( file.write( reinterpret_cast<const char*>( image.constScanLine( y ) ), size ) != size ) {
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,145 @@
+/***************************************************************************//**
+ * @file render/FrameExporter.h
+ * @author  Marek M. Cel <marekcel@marekcel.pl>
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * This file is part of QFlightInstruments. You can redistribute and modify it
+ * under the terms of GNU General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.
+ * 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ *
+ * Further information about the GNU General Public License can also be found
+ * on the world wide web at http://www.gnu.org.
+ *
+ * ---
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef __FRAMEEXPORTER_H__
+#define __FRAMEEXPORTER_H__
+
+#include <QImage>
+#include <QString>
+
+#include <Adi.hpp>
+#include <Alt.hpp>
+#include <Asi.hpp>
+#include <Hsi.hpp>
+#include <Nav.hpp>
+#include <Pfd.hpp>
+#include <Tc.hpp>
+#include <Vsi.hpp>
+
+#include "TelemetryFile.hpp"
+
+//---------------------------------------------------
+// Class: FrameExporter
+// Description: Renders telemetry frames into numbered image files,
+// every worker thread uses its own exporter since the instruments
+// renderers are not thread-safe
+//---------------------------------------------------
+class FrameExporter
+{
+public:
+
+    enum Layout
+    {
+        PFD = 0,    ///< primary flight display
+        NAV,        ///< navigation display
+        SIX         ///< six-pack (ASI, ADI, ALT, TC, HSI, VSI)
+    };
+
+    enum Format
+    {
+        PNG = 0,    ///< PNG images
+        RGBA        ///< raw 8-bit RGBA pixels
+    };
+
+    // accumulated stages timing [ns]
+    struct Timing
+    {
+        qint64 decode{};
+        qint64 render{};
+        qint64 encode{};
+
+        int frames{};
+        int failures{};
+    };
+
+    FrameExporter(const TelemetryFile* telemetry, const Layout layout,
+                  const Format format, const int size, const QString& outputDir);
+
+    ~FrameExporter();
+
+    // decodes, renders and writes the given frame
+    void exportFrame(const int frame);
+
+    //
+    // releases instruments renderers, has to be called from the thread
+    // which exported frames
+    //
+    void release();
+
+    inline const Timing& timing() const { return m_timing; }
+
+private:
+
+    void init();
+    void setState(const TelemetryFile::Sample& sample);
+    void render();
+    bool encode(const int frame);
+
+    const TelemetryFile* m_telemetry{};
+
+    qfi::Pfd::Renderer* m_pfd{};
+    qfi::Nav::Renderer* m_nav{};
+    qfi::Asi::Renderer* m_asi{};
+    qfi::Adi::Renderer* m_adi{};
+    qfi::Alt::Renderer* m_alt{};
+    qfi::Tc::Renderer*  m_tc{};
+    qfi::Hsi::Renderer* m_hsi{};
+    qfi::Vsi::Renderer* m_vsi{};
+
+    QImage m_image;
+
+    QString m_outputDir;
+
+    Timing m_timing;
+
+    Layout m_layout{};
+    Format m_format{};
+
+    int m_size{};                       ///< [px] instrument size
+};
+
+#endif
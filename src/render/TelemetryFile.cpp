@@ -0,0 +1,131 @@
+/***************************************************************************//**
+ * @file render/TelemetryFile.cpp
+ * @author  Marek M. Cel <marekcel@marekcel.pl>
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * This file is part of QFlightInstruments. You can redistribute and modify it
+ * under the terms of GNU General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.
+ * 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ *
+ * Further information about the GNU General Public License can also be found
+ * on the world wide web at http://www.gnu.org.
+ *
+ * ---
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include "TelemetryFile.hpp"
+
+#include <QFile>
+
+#include <cstring>
+
+#include <TelemetryCsvReader.hpp>
+
+bool TelemetryFile::load(const QString& fileName)
+{
+    m_replay.close();
+    m_samples.clear();
+
+    if ( isRecording( fileName ) ) {
+        if ( !m_replay.open( fileName ) ) {
+            m_errorString = m_replay.errorString();
+            return false;
+        }
+
+        // frames are exported in any order, compressed samples are decoded once
+        if ( m_replay.isCompressed() ) {
+            m_samples.resize( static_cast<int>( m_replay.count() ) );
+
+            qfi::TelemetryArchive::Reader reader = m_replay.archive();
+            reader.seek( 0 );
+            reader.read( m_samples.data(), m_samples.size() );
+
+            m_replay.close();
+        }
+
+        return true;
+    }
+
+    qfi::TelemetryCsvReader reader;
+
+    if ( !reader.open( fileName ) ) {
+        m_errorString = reader.errorString();
+        return false;
+    }
+
+    // log is parsed in chunks of samples straight into the frames
+    const int chunk = 4096;
+
+    int size = 0;
+
+    do {
+        m_samples.resize( size + chunk );
+        size += reader.read( m_samples.data() + size, chunk );
+    }
+    while ( size == m_samples.size() );
+
+    m_samples.resize( size );
+
+    if ( m_samples.isEmpty() ) {
+        m_errorString = "no frames";
+        return false;
+    }
+
+    return true;
+}
+
+void TelemetryFile::decode(const int frame, Sample* sample) const
+{
+    if ( m_replay.isOpen() ) {
+        *sample = m_replay.sample( frame );
+        return;
+    }
+
+    *sample = m_samples[ frame ];
+}
+
+bool TelemetryFile::isRecording(const QString& fileName)
+{
+    QFile file( fileName );
+
+    // pipes are not read here, their data would be lost
+    if ( !file.open( QFile::ReadOnly ) || file.isSequential() ) return false;
+
+    char magic[ 4 ] = {};
+
+    return file.read( magic, sizeof(magic) ) == sizeof(magic)
+        && std::memcmp( magic, qfi::TelemetryHeader::Magic, sizeof(magic) ) == 0;
+}
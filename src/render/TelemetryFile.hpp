@@ -0,0 +1,96 @@
+/***************************************************************************//**
+ * @file render/TelemetryFile.h
+ * @author  Marek M. Cel <marekcel@marekcel.pl>
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * This file is part of QFlightInstruments. You can redistribute and modify it
+ * under the terms of GNU General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.
+ * 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ *
+ * Further information about the GNU General Public License can also be found
+ * on the world wide web at http://www.gnu.org.
+ *
+ * ---
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef __TELEMETRYFILE_H__
+#define __TELEMETRYFILE_H__
+
+#include <QString>
+#include <QVector>
+
+#include <TelemetryReplay.hpp>
+
+//---------------------------------------------------
+// Class: TelemetryFile
+// Description: Telemetry file to be rendered frame by frame, either
+// a comma separated log (see qfi::TelemetryCsvReader), which is parsed
+// as a whole when loaded, or a telemetry recording (see
+// qfi::TelemetryRecorder), which is replayed from the memory mapped file
+// sample by sample instead, compressed ones are decoded when loaded.
+//---------------------------------------------------
+class TelemetryFile
+{
+public:
+
+    typedef qfi::TelemetrySample Sample;
+
+    // loads file, "-" reads comma separated log of the standard input, returns false on error
+    bool load(const QString& fileName);
+
+    // number of frames
+    inline int frames() const
+    {
+        return m_replay.isOpen() ? static_cast<int>( m_replay.count() ) : m_samples.size();
+    }
+
+    // decodes the given frame
+    void decode(const int frame, Sample* sample) const;
+
+    inline QString errorString() const { return m_errorString; }
+
+private:
+
+    // returns true if the file is a telemetry recording
+    static bool isRecording(const QString& fileName);
+
+    qfi::TelemetryReplay m_replay;          ///< recording
+
+    QVector<Sample> m_samples;              ///< parsed log or decoded compressed recording
+
+    QString m_errorString;
+};
+
+#endif
@@ -0,0 +1,126 @@
+/***************************************************************************//**
+ * @file render/ThreadPool.cpp
+ * @author  Marek M. Cel <marekcel@marekcel.pl>
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * This file is part of QFlightInstruments. You can redistribute and modify it
+ * under the terms of GNU General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.
+ * 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ *
+ * Further information about the GNU General Public License can also be found
+ * on the world wide web at http://www.gnu.org.
+ *
+ * ---
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include "ThreadPool.hpp"
+
+#include <thread>
+
+ThreadPool::ThreadPool(const int threads) :
+    m_threads(threads > 0 ? threads : 1)
+{
+    for ( int i = 0; i < m_threads; ++i ) {
+        m_queues.push_back( std::unique_ptr<Queue>( new Queue() ) );
+    }
+}
+
+void ThreadPool::run(const int count, const Task& task, const Done& done)
+{
+    m_steals = 0;
+
+    // consecutive tasks are dealt in contiguous blocks, stealing balances
+    // the load when blocks take different time
+    for ( int i = 0; i < m_threads; ++i ) {
+        const int first = static_cast<int>( static_cast<long long>(count) *  i      / m_threads );
+        const int last  = static_cast<int>( static_cast<long long>(count) * (i + 1) / m_threads );
+
+        std::lock_guard<std::mutex> lock( m_queues[ i ]->mutex );
+
+        for ( int j = first; j < last; ++j ) m_queues[ i ]->tasks.push_back( j );
+    }
+
+    std::vector<std::thread> workers;
+
+    for ( int i = 0; i < m_threads; ++i ) {
+        workers.push_back( std::thread( &ThreadPool::work, this, i, std::cref( task ), std::cref( done ) ) );
+    }
+
+    for ( std::thread& worker : workers ) worker.join();
+}
+
+bool ThreadPool::pop(const int worker, int* task)
+{
+    Queue* queue = m_queues[ worker ].get();
+    std::lock_guard<std::mutex> lock( queue->mutex );
+
+    if ( queue->tasks.empty() ) return false;
+
+    *task = queue->tasks.front();
+    queue->tasks.pop_front();
+
+    return true;
+}
+
+bool ThreadPool::steal(const int worker, int* task)
+{
+    for ( int i = 1; i < m_threads; ++i ) {
+        Queue* victim = m_queues[ ( worker + i ) % m_threads ].get();
+        std::lock_guard<std::mutex> lock( victim->mutex );
+
+        if ( !victim->tasks.empty() ) {
+            *task = victim->tasks.back();
+            victim->tasks.pop_back();
+            m_steals++;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ThreadPool::work(const int worker, const Task& task, const Done& done)
+{
+    int index = 0;
+
+    // no tasks are added while running, so once every queue is empty
+    // the worker is done
+    while ( pop( worker, &index ) || steal( worker, &index ) ) {
+        task( worker, index );
+    }
+
+    if ( done ) done( worker );
+}
@@ -0,0 +1,212 @@
+/***************************************************************************//**
+ * @file render/main.cpp
+ * @author  Marek M. Cel <marekcel@marekcel.pl>
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * This file is part of QFlightInstruments. You can redistribute and modify it
+ * under the terms of GNU General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.
+ * 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ *
+ * Further information about the GNU General Public License can also be found
+ * on the world wide web at http://www.gnu.org.
+ *
+ * ---
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QThread>
+
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include <SvgRegistry.hpp>
+#include <TelemetryRecorder.hpp>
+
+#include "FrameExporter.hpp"
+#include "TelemetryFile.hpp"
+#include "ThreadPool.hpp"
+
+int main(int argc, char *argv[])
+{
+    // no display is needed to render frames
+    if ( qEnvironmentVariableIsEmpty( "QT_QPA_PLATFORM" ) ) {
+        qputenv( "QT_QPA_PLATFORM", "offscreen" );
+    }
+
+    QApplication app(argc, argv);
+    QApplication::setApplicationName( "qfi-render" );
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription( "Renders telemetry file into a sequence of instrument frames." );
+    parser.addHelpOption();
+    parser.addPositionalArgument( "telemetry", "Telemetry file (comma separated values or recording), - reads standard input." );
+
+    const QCommandLineOption outputOption( QStringList() << "o" << "output",
+                                           "Output directory.", "dir", "." );
+    const QCommandLineOption layoutOption( QStringList() << "l" << "layout",
+                                           "Instruments layout: pfd, nav or six.", "layout", "pfd" );
+    const QCommandLineOption formatOption( QStringList() << "f" << "format",
+                                           "Output format: png or rgba.", "format", "png" );
+    const QCommandLineOption sizeOption( QStringList() << "s" << "size",
+                                         "Instrument size [px].", "px", "480" );
+    const QCommandLineOption convertOption( QStringList() << "c" << "convert",
+                                            "Converts the telemetry file into the compressed recording instead of rendering.",
+                                            "file" );
+    const QCommandLineOption threadsOption( QStringList() << "j" << "threads",
+                                            "Number of worker threads.", "n",
+                                            QString::number( QThread::idealThreadCount() ) );
+
+    parser.addOption( outputOption );
+    parser.addOption( layoutOption );
+    parser.addOption( formatOption );
+    parser.addOption( sizeOption );
+    parser.addOption( threadsOption );
+    parser.addOption( convertOption );
+
+    parser.process( app );
+
+    if ( parser.positionalArguments().size() != 1 ) parser.showHelp( 1 );
+
+    const QString layoutName = parser.value( layoutOption );
+    const QString formatName = parser.value( formatOption );
+
+    FrameExporter::Layout layout = FrameExporter::PFD;
+    FrameExporter::Format format = FrameExporter::PNG;
+
+    if      ( layoutName == "pfd" ) layout = FrameExporter::PFD;
+    else if ( layoutName == "nav" ) layout = FrameExporter::NAV;
+    else if ( layoutName == "six" ) layout = FrameExporter::SIX;
+    else parser.showHelp( 1 );
+
+    if      ( formatName == "png"  ) format = FrameExporter::PNG;
+    else if ( formatName == "rgba" ) format = FrameExporter::RGBA;
+    else parser.showHelp( 1 );
+
+    const int size    = parser.value( sizeOption    ).toInt();
+    const int threads = parser.value( threadsOption ).toInt();
+
+    if ( size <= 0 || threads <= 0 ) parser.showHelp( 1 );
+
+    TelemetryFile telemetry;
+
+    QElapsedTimer loadTimer;
+    loadTimer.start();
+
+    if ( !telemetry.load( parser.positionalArguments().first() ) ) {
+        std::fprintf( stderr, "Cannot load telemetry file: %s\n", qPrintable( telemetry.errorString() ) );
+        return 1;
+    }
+
+    if ( parser.isSet( convertOption ) ) {
+        qfi::TelemetryRecorder recorder;
+        recorder.setCompressed( true );
+
+        if ( !recorder.open( parser.value( convertOption ) ) ) {
+            std::fprintf( stderr, "Cannot write recording: %s\n", qPrintable( recorder.errorString() ) );
+            return 1;
+        }
+
+        TelemetryFile::Sample sample;
+
+        for ( int i = 0; i < telemetry.frames(); ++i ) {
+            telemetry.decode( i, &sample );
+            recorder.write( sample );
+        }
+
+        recorder.close();
+
+        std::printf( "samples:   %lld\n", recorder.samples() );
+        std::printf( "ratio:     %.1f\n", recorder.archive().compressionRatio() );
+        std::printf( "wall time: %.1f ms\n", loadTimer.nsecsElapsed() / 1.0e6 );
+
+        return 0;
+    }
+
+    const QString outputDir = parser.value( outputOption );
+
+    if ( !QDir().mkpath( outputDir ) ) {
+        std::fprintf( stderr, "Cannot create output directory %s\n", qPrintable( outputDir ) );
+        return 1;
+    }
+
+    ThreadPool pool( threads );
+
+    std::vector< std::unique_ptr<FrameExporter> > exporters;
+
+    for ( int i = 0; i < pool.threads(); ++i ) {
+        exporters.push_back( std::unique_ptr<FrameExporter>(
+                    new FrameExporter( &telemetry, layout, format, size, outputDir ) ) );
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    pool.run( telemetry.frames(),
+              [ &exporters ]( int worker, int frame ) { exporters[ worker ]->exportFrame( frame ); },
+              [ &exporters ]( int worker ) { exporters[ worker ]->release(); } );
+
+    const qint64 wallTime = timer.nsecsElapsed();
+
+    FrameExporter::Timing total;
+
+    for ( const std::unique_ptr<FrameExporter>& exporter : exporters ) {
+        total.decode   += exporter->timing().decode;
+        total.render   += exporter->timing().render;
+        total.encode   += exporter->timing().encode;
+        total.frames   += exporter->timing().frames;
+        total.failures += exporter->timing().failures;
+    }
+
+    qfi::SvgRegistry::purge();
+
+    const double frames  = total.frames > 0 ? total.frames : 1;
+    const double busy    = qMax( total.decode + total.render + total.encode, Q_INT64_C(1) );
+
+    std::printf( "frames:    %d (%d failed)\n", total.frames, total.failures );
+    std::printf( "threads:   %d (%d frames stolen)\n", pool.threads(), pool.steals() );
+    std::printf( "wall time: %.1f ms (%.1f frames/s)\n", wallTime / 1.0e6, total.frames / ( wallTime / 1.0e9 ) );
+    std::printf( "\n" );
+    std::printf( "stage     total [ms]   per frame [us]   share\n" );
+    std::printf( "decode  %12.1f %16.1f %6.1f%%\n", total.decode / 1.0e6, total.decode / frames / 1.0e3, 100.0 * total.decode / busy );
+    std::printf( "render  %12.1f %16.1f %6.1f%%\n", total.render / 1.0e6, total.render / frames / 1.0e3, 100.0 * total.render / busy );
+    std::printf( "encode  %12.1f %16.1f %6.1f%%\n", total.encode / 1.0e6, total.encode / frames / 1.0e3, 100.0 * total.encode / busy );
+
+    return total.failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,239 @@
+/***************************************************************************//**
+ * @file sim/main.cpp
+ * @author  Marek M. Cel <marekcel@marekcel.pl>
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * This file is part of QFlightInstruments. You can redistribute and modify it
+ * under the terms of GNU General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.
+ * 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ *
+ * Further information about the GNU General Public License can also be found
+ * on the world wide web at http://www.gnu.org.
+ *
+ * ---
+ *
+ * Copyright (C) 2015 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include <TelemetryRing.hpp>
+
+namespace {
+
+std::atomic<bool> running{true};
+
+void stop(int)
+{
+    running = false;
+}
+
+// [ns] monotonic clock shared by the producer and the latency reader
+qint64 now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+// the same flight as the one of the example application
+void generate(qfi::TelemetrySample* sample, const float t)
+{
+    sample->alpha      =   20.0f * std::sin( t /  10.0f );
+    sample->beta       =   15.0f * std::sin( t /  10.0f );
+    sample->roll       =  180.0f * std::sin( t /  10.0f );
+    sample->pitch      =   90.0f * std::sin( t /  20.0f );
+    sample->heading    =  360.0f * std::sin( t /  40.0f );
+    sample->slipSkid   =    1.0f * std::sin( t /  10.0f );
+    sample->turnRate   =    7.0f * std::sin( t /  10.0f );
+    sample->devH       =    1.0f * std::sin( t /  20.0f );
+    sample->devV       =    1.0f * std::sin( t /  20.0f );
+    sample->airspeed   =  125.0f * std::sin( t /  40.0f ) +  125.0f;
+    sample->altitude   = 9000.0f * std::sin( t /  40.0f ) + 9000.0f;
+    sample->pressure   =    2.0f * std::sin( t /  20.0f ) +   30.0f;
+    sample->climbRate  =  650.0f * std::sin( t /  20.0f );
+    sample->mach       = sample->airspeed / 650.0f;
+    sample->bearing    = -360.0f * std::sin( t /  50.0f );
+    sample->distance   =   99.0f * std::sin( t / 100.0f );
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName( "qfi-sim" );
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription( "Publishes generated flight into the shared memory telemetry ring." );
+    parser.addHelpOption();
+
+    const QCommandLineOption nameOption( QStringList() << "n" << "name",
+                                         "Shared memory object name.", "name", "/qfi" );
+    const QCommandLineOption rateOption( QStringList() << "r" << "rate",
+                                         "Samples per second.", "Hz", "1000" );
+    const QCommandLineOption durationOption( QStringList() << "d" << "duration",
+                                             "Run time [s], 0 runs until interrupted.", "s", "0" );
+    const QCommandLineOption capacityOption( QStringList() << "c" << "capacity",
+                                             "Number of ring slots.", "n",
+                                             QString::number( qfi::TelemetryRing::DefaultCapacity ) );
+    const QCommandLineOption latencyOption( QStringList() << "l" << "latency",
+                                            "Measures handoff latency with a reader thread of this process." );
+    const QCommandLineOption unlinkOption( QStringList() << "u" << "unlink",
+                                           "Removes the shared memory object on exit." );
+
+    parser.addOption( nameOption );
+    parser.addOption( rateOption );
+    parser.addOption( durationOption );
+    parser.addOption( capacityOption );
+    parser.addOption( latencyOption );
+    parser.addOption( unlinkOption );
+
+    parser.process( app );
+
+    const QString name     = parser.value( nameOption );
+    const double rate      = parser.value( rateOption ).toDouble();
+    const double duration  = parser.value( durationOption ).toDouble();
+    const int capacity     = parser.value( capacityOption ).toInt();
+
+    if ( rate <= 0.0 || duration < 0.0 || capacity <= 0 ) parser.showHelp( 1 );
+
+    qfi::TelemetryRing::Writer writer;
+
+    if ( !writer.open( name, capacity ) ) {
+        std::fprintf( stderr, "Cannot open %s: %s\n", qPrintable( name ), qPrintable( writer.errorString() ) );
+        return 1;
+    }
+
+    std::signal( SIGINT  , stop );
+    std::signal( SIGTERM , stop );
+
+    // reader thread spins on the ring as a polling consumer would, without any system calls
+    qfi::TelemetryRing::Reader reader;
+    std::vector<qint64> latencies;
+    std::thread latencyThread;
+
+    if ( parser.isSet( latencyOption ) ) {
+        if ( !reader.open( name ) ) {
+            std::fprintf( stderr, "Cannot open %s: %s\n", qPrintable( name ), qPrintable( reader.errorString() ) );
+            return 1;
+        }
+
+        latencies.reserve( static_cast<std::size_t>( rate * ( duration > 0.0 ? duration : 60.0 ) ) + 1 );
+
+        // latest sample written before the reader opened the ring is skipped
+        qfi::TelemetrySample sample;
+        reader.read( &sample );
+
+        latencyThread = std::thread( [ &reader, &latencies ]()
+        {
+            qfi::TelemetrySample sample;
+
+            while ( running ) {
+                if ( reader.next( &sample ) ) latencies.push_back( now() - sample.time );
+            }
+        } );
+    }
+
+    std::printf( "Publishing %s at %g Hz, %d slots\n", qPrintable( name ), rate, writer.capacity() );
+
+    const std::chrono::nanoseconds period( static_cast<qint64>( 1.0e9 / rate ) );
+    const qint64 start = now();
+
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now();
+
+    qint64 samples = 0;
+    qint64 overruns = 0;
+
+    qfi::TelemetrySample sample;
+
+    while ( running ) {
+        const float t = static_cast<float>( samples / rate );
+
+        if ( duration > 0.0 && t >= duration ) break;
+
+        generate( &sample, t );
+        sample.time = now();
+
+        writer.write( sample );
+        samples++;
+
+        deadline += period;
+
+        // late producer keeps its rate instead of publishing bursts to catch up
+        if ( std::chrono::steady_clock::now() > deadline ) {
+            deadline = std::chrono::steady_clock::now();
+            overruns++;
+        } else {
+            std::this_thread::sleep_until( deadline );
+        }
+    }
+
+    running = false;
+
+    if ( latencyThread.joinable() ) latencyThread.join();
+
+    const double elapsed = 1.0e-9 * static_cast<double>( now() - start );
+
+    std::printf( "Samples: %lld (%.1f Hz, overruns: %lld)\n",
+                 static_cast<long long>( samples ), samples / elapsed, static_cast<long long>( overruns ) );
+
+    if ( !latencies.empty() ) {
+        std::sort( latencies.begin(), latencies.end() );
+
+        const std::size_t count = latencies.size();
+
+        std::printf( "Handoff latency [ns]: min %lld, median %lld, p99 %lld (samples: %llu, lost: %llu)\n",
+                     static_cast<long long>( latencies.front() ),
+                     static_cast<long long>( latencies[ count / 2 ] ),
+                     static_cast<long long>( latencies[ count * 99 / 100 ] ),
+                     static_cast<unsigned long long>( count ),
+                     static_cast<unsigned long long>( reader.lost() ) );
+    }
+
+    writer.close();
+
+    if ( parser.isSet( unlinkOption ) ) qfi::TelemetryRing::Writer::unlink( name );
+
+    return 0;
+}